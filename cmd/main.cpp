@@ -14,33 +14,355 @@
 #include <string.h>
 #include <iostream>
 
+#include "registry.h"
 #include "writer.h"
 
 #include <ai.h>
 #include <pxr/base/plug/plugin.h>
 #include <pxr/base/plug/registry.h>
 #include <pxr/pxr.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <fstream>
 #include <string>
+#include <thread>
 #include <vector>
 #include "pxr/usd/sdf/layer.h"
 #include "pxr/usd/sdf/path.h"
 #include "pxr/usd/usd/stage.h"
 #include "pxr/usd/usdGeom/xform.h"
 
+namespace {
+
+struct BatchInput {
+    std::string filename;
+    float frame;
+};
+
+struct BatchOptions {
+    std::string output;            // time-sampled output file, or empty to write one file per input
+    std::string extension = "usd"; // extension of the files written per input
+    unsigned int jobs = 0;         // amount of files processed concurrently, 0 meaning all the available cores
+    unsigned int threads = 1;      // amount of threads used to write each file, 0 meaning all the available cores
+    bool hasFrames = false;
+    bool compact = false;          // use the compact encoding profile of the writer
+    int startFrame = 1;
+    int endFrame = 1;
+};
+
+// A single input being converted in a separate Arnold universe
+struct BatchJob {
+    const BatchInput *input = nullptr;
+    bool compact = false;
+    unsigned int threads = 1;
+    AtUniverse *universe = nullptr;
+    std::string output;
+    bool success = false;
+    double loadTime = 0.0;
+    double writeTime = 0.0;
+};
+
+struct BatchThreadData {
+    std::vector<BatchJob> *jobs;
+    std::atomic<size_t> *nextJob;
+    bool write; // write each input to its own file, or only load it
+};
+
+double _GetSeconds(const std::chrono::steady_clock::time_point &start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void _PrintUsage()
+{
+    std::cerr << "Usage: arnold_to_usd <input.ass> <output.usd> [--compact] [--threads <count>]\n"
+              << "       arnold_to_usd --batch [options] <inputs>...\n\n"
+              << "Options:\n"
+              << "  --compact                Write single precision transforms when they match the matrices\n"
+              << "                           within a relative tolerance of 1e-5.\n"
+              << "  --threads <count>        Amount of threads used to write the output (default 0, all the cores).\n"
+              << "                           The output is the same for any amount of threads.\n\n"
+              << "Batch options:\n"
+              << "  --output <file>          Write all the inputs as frames of a single time-sampled file,\n"
+              << "                           instead of one file per input.\n"
+              << "  --frames <start> <end>   Expand '#' characters in the inputs to the padded frame numbers.\n"
+              << "                           Inputs without '#' are numbered from the start frame (default 1).\n"
+              << "  --jobs <count>           Amount of inputs processed concurrently (default 0, all the cores).\n"
+              << "  --extension <ext>        Extension of the files written per input (default usd).\n"
+              << "  --threads <count>        Amount of threads used to write each file written per input (default 1,\n"
+              << "                           0 for all the cores).\n"
+              << "  --compact                Write single precision transforms when they match the matrices\n"
+              << "                           within a relative tolerance of 1e-5.\n\n"
+              << "An input starting with '@' is a text file listing one input per line." << std::endl;
+}
+
+// Replaces the sequence of '#' characters in a filename with the zero-padded frame number
+std::string _ExpandFramePattern(const std::string &pattern, int frame)
+{
+    const auto first = pattern.find('#');
+    if (first == std::string::npos)
+        return pattern;
+    const auto last = pattern.find_first_not_of('#', first);
+    const auto padding = (last == std::string::npos ? pattern.length() : last) - first;
+    std::string frameStr = std::to_string(std::abs(frame));
+    if (frameStr.length() < padding)
+        frameStr.insert(0, padding - frameStr.length(), '0');
+    if (frame < 0)
+        frameStr.insert(0, 1, '-');
+    return pattern.substr(0, first) + frameStr + (last == std::string::npos ? "" : pattern.substr(last));
+}
+
+void _AddInput(const std::string &input, const BatchOptions &options, std::vector<BatchInput> &inputs)
+{
+    if (options.hasFrames && input.find('#') != std::string::npos) {
+        for (int frame = options.startFrame; frame <= options.endFrame; ++frame) {
+            inputs.push_back({_ExpandFramePattern(input, frame), static_cast<float>(frame)});
+        }
+    } else {
+        inputs.push_back({input, static_cast<float>(options.startFrame + static_cast<int>(inputs.size()))});
+    }
+}
+
+std::string _GetOutputFilename(const std::string &input, const std::string &extension)
+{
+    std::string output = input;
+    // Compressed ass files have a double extension
+    static const std::string gzExtension(".gz");
+    if (output.length() > gzExtension.length() &&
+        output.compare(output.length() - gzExtension.length(), gzExtension.length(), gzExtension) == 0)
+        output.resize(output.length() - gzExtension.length());
+    const auto dot = output.find_last_of('.');
+    const auto separator = output.find_last_of("/\\");
+    if (dot != std::string::npos && (separator == std::string::npos || dot > separator))
+        output.resize(dot);
+    return output + "." + extension;
+}
+
+void _LoadJob(BatchJob &job)
+{
+    const auto start = std::chrono::steady_clock::now();
+    job.universe = AiUniverse();
+    job.success = AiASSLoad(job.universe, job.input->filename.c_str()) == AI_SUCCESS;
+    job.loadTime = _GetSeconds(start);
+}
+
+void _WriteJob(BatchJob &job)
+{
+    const auto start = std::chrono::steady_clock::now();
+    UsdStageRefPtr stage = UsdStage::Open(SdfLayer::CreateNew(job.output));
+    if (!stage) {
+        job.success = false;
+        return;
+    }
+    // Prim writers keep the state of the node being written, so each concurrent
+    // writer needs its own registry instead of the global one
+    UsdArnoldWriterRegistry registry;
+    UsdArnoldWriter writer;
+    writer.SetRegistry(&registry);
+    writer.SetUsdStage(stage);
+    writer.SetCompactEncoding(job.compact);
+    writer.SetThreadCount(job.threads);
+    writer.Write(job.universe);
+    job.success = stage->GetRootLayer()->Save();
+    job.writeTime = _GetSeconds(start);
+}
+
+unsigned int _BatchThread(void *data)
+{
+    BatchThreadData *threadData = static_cast<BatchThreadData *>(data);
+    std::vector<BatchJob> &jobs = *threadData->jobs;
+    for (size_t i = threadData->nextJob->fetch_add(1); i < jobs.size(); i = threadData->nextJob->fetch_add(1)) {
+        BatchJob &job = jobs[i];
+        _LoadJob(job);
+        if (threadData->write) {
+            if (job.success)
+                _WriteJob(job);
+            AiUniverseDestroy(job.universe);
+            job.universe = nullptr;
+        }
+    }
+    return 0;
+}
+
+// Runs the jobs on the requested amount of threads, each job using its own universe
+void _RunJobs(std::vector<BatchJob> &jobs, unsigned int threadCount, bool write)
+{
+    std::atomic<size_t> nextJob(0);
+    BatchThreadData threadData{&jobs, &nextJob, write};
+    std::vector<void *> threads(std::min(static_cast<size_t>(threadCount), jobs.size()), nullptr);
+    for (auto &thread : threads)
+        thread = AiThreadCreate(_BatchThread, &threadData, AI_PRIORITY_NORMAL);
+    for (auto &thread : threads) {
+        AiThreadWait(thread);
+        AiThreadClose(thread);
+    }
+}
+
+void _PrintJob(const BatchJob &job)
+{
+    std::cout << job.input->filename << " -> " << job.output << (job.success ? "" : " FAILED")
+              << " (load " << job.loadTime << "s, write " << job.writeTime << "s)" << std::endl;
+}
+
+int _RunBatch(const std::vector<BatchInput> &inputs, const BatchOptions &options)
+{
+    unsigned int threadCount = options.jobs;
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    const auto start = std::chrono::steady_clock::now();
+    int failed = 0;
+    if (options.output.empty()) {
+        // One output file per input, each input is loaded and written independently
+        std::vector<BatchJob> jobs(inputs.size());
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            jobs[i].input = &inputs[i];
+            jobs[i].compact = options.compact;
+            jobs[i].threads = options.threads;
+            jobs[i].output = _GetOutputFilename(inputs[i].filename, options.extension);
+        }
+        _RunJobs(jobs, threadCount, true);
+        for (const auto &job : jobs) {
+            _PrintJob(job);
+            failed += job.success ? 0 : 1;
+        }
+    } else {
+        // All the inputs are written as frames of the same stage. Frames have to be written in order,
+        // so the inputs are loaded concurrently in batches of threadCount universes, then written one by one
+        UsdStageRefPtr stage = UsdStage::Open(SdfLayer::CreateNew(options.output));
+        if (!stage) {
+            std::cerr << "Cannot create " << options.output << std::endl;
+            return -1;
+        }
+        UsdArnoldWriter writer;
+        writer.SetUsdStage(stage);
+        writer.SetStreaming(true);
+        writer.SetCompactEncoding(options.compact);
+        for (size_t batchStart = 0; batchStart < inputs.size(); batchStart += threadCount) {
+            const size_t batchEnd = std::min(inputs.size(), batchStart + threadCount);
+            std::vector<BatchJob> jobs(batchEnd - batchStart);
+            for (size_t i = 0; i < jobs.size(); ++i) {
+                jobs[i].input = &inputs[batchStart + i];
+                jobs[i].output = options.output;
+            }
+            _RunJobs(jobs, threadCount, false);
+            for (auto &job : jobs) {
+                if (job.success) {
+                    const auto writeStart = std::chrono::steady_clock::now();
+                    writer.SetFrame(job.input->frame);
+                    writer.Write(job.universe);
+                    job.writeTime = _GetSeconds(writeStart);
+                }
+                AiUniverseDestroy(job.universe);
+                job.universe = nullptr;
+                _PrintJob(job);
+                failed += job.success ? 0 : 1;
+            }
+        }
+        if (!stage->GetRootLayer()->Save()) {
+            std::cerr << "Cannot save " << options.output << std::endl;
+            return -1;
+        }
+    }
+    std::cout << inputs.size() - failed << " of " << inputs.size() << " inputs converted in " << _GetSeconds(start)
+              << "s" << std::endl;
+    return failed == 0 ? 0 : -1;
+}
+
+int _Batch(int argc, char **argv)
+{
+    BatchOptions options;
+    std::vector<std::string> inputArgs;
+    for (int i = 2; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--output" && i + 1 < argc) {
+            options.output = argv[++i];
+        } else if (arg == "--frames" && i + 2 < argc) {
+            options.hasFrames = true;
+            options.startFrame = std::atoi(argv[++i]);
+            options.endFrame = std::atoi(argv[++i]);
+        } else if (arg == "--jobs" && i + 1 < argc) {
+            options.jobs = static_cast<unsigned int>(std::max(0, std::atoi(argv[++i])));
+        } else if (arg == "--threads" && i + 1 < argc) {
+            options.threads = static_cast<unsigned int>(std::max(0, std::atoi(argv[++i])));
+        } else if (arg == "--extension" && i + 1 < argc) {
+            options.extension = argv[++i];
+        } else if (arg == "--compact") {
+            options.compact = true;
+        } else if (arg.compare(0, 2, "--") == 0) {
+            _PrintUsage();
+            return -1;
+        } else {
+            inputArgs.push_back(arg);
+        }
+    }
+
+    std::vector<BatchInput> inputs;
+    for (const auto &inputArg : inputArgs) {
+        if (inputArg[0] != '@') {
+            _AddInput(inputArg, options, inputs);
+            continue;
+        }
+        std::ifstream listFile(inputArg.substr(1));
+        if (!listFile) {
+            std::cerr << "Cannot read the input list " << inputArg.substr(1) << std::endl;
+            return -1;
+        }
+        std::string line;
+        while (std::getline(listFile, line)) {
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+            if (!line.empty())
+                _AddInput(line, options, inputs);
+        }
+    }
+    if (inputs.empty()) {
+        _PrintUsage();
+        return -1;
+    }
+
+    AiBegin(AI_SESSION_INTERACTIVE);
+    const int result = _RunBatch(inputs, options);
+    AiEnd();
+    return result;
+}
+
+} // namespace
+
 /**
  *  Small utility command that converts an Arnold input .ass file into a .usd
  *file. It uses the "writer" translator to do it.
+ *  In batch mode, it converts a list of .ass files in a single process, either to
+ *one .usd file per input, or to a single time-sampled .usd file.
  **/
 int main(int argc, char** argv)
 {
-    if (argc < 3)
+    if (argc > 1 && strcmp(argv[1], "--batch") == 0)
+        return _Batch(argc, argv);
+
+    if (argc < 3) {
+        _PrintUsage();
         return -1;
+    }
 
     std::string assname = argv[1]; // 1st command-line argument is the input .ass file
     std::string usdname = argv[2]; // 2nd command-line argument is the output .usd file
+    bool compact = false;
+    unsigned int threadCount = 0;  // use all the available cores by default
+    for (int i = 3; i < argc; ++i) {
+        if (strcmp(argv[i], "--compact") == 0) {
+            compact = true;
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threadCount = static_cast<unsigned int>(std::max(0, std::atoi(argv[++i])));
+        } else {
+            _PrintUsage();
+            return -1;
+        }
+    }
 
     // Start the Arnold session, and load the input .ass file
     AiBegin(AI_SESSION_INTERACTIVE);
@@ -52,6 +374,8 @@ int main(int argc, char** argv)
     // Create a "writer" Translator that will handle the conversion
     UsdArnoldWriter* writer = new UsdArnoldWriter();
     writer->SetUsdStage(stage);    // give it the output stage
+    writer->SetThreadCount(threadCount);
+    writer->SetCompactEncoding(compact);
     writer->Write(nullptr);        // do the conversion (nullptr being the default universe)
     stage->GetRootLayer()->Save(); // Ask USD to save out the file
     AiEnd();
@@ -158,6 +158,7 @@ ASTR(color);
 ASTR(color_mode);
 ASTR(color_pointer);
 ASTR(color_to_signed);
+ASTR(compact_encoding);
 ASTR(cone_angle);
 ASTR(cosine_power);
 ASTR(crease_idxs);
@@ -176,6 +177,7 @@ ASTR(driver_deepexr);
 ASTR(emission);
 ASTR(emission_color);
 ASTR(emissiveColor);
+ASTR(enable_adaptive_frame_rate);
 ASTR(enable_adaptive_sampling);
 ASTR(enable_dependency_graph);
 ASTR(enable_dithered_sampling);
@@ -185,6 +187,7 @@ ASTR(enable_new_quad_light_sampler);
 ASTR(enable_procedural_cache);
 ASTR(enable_progressive_pattern);
 ASTR(enable_progressive_render);
+ASTR(end_session);
 ASTR(exposure);
 ASTR(fallback);
 ASTR(far_clip);
@@ -221,6 +224,7 @@ ASTR(ignore_subdivision);
 ASTR(ignore_textures);
 ASTR(image);
 ASTR(in);
+ASTR(incremental);
 ASTR(indirect_sample_clamp);
 ASTR(inherit_xform);
 ASTR(input);
@@ -231,6 +235,7 @@ ASTR(instance_motion_start);
 ASTR(instance_shader);
 ASTR(instance_visibility);
 ASTR(instancer);
+ASTR(instancing);
 ASTR(intensity);
 ASTR(interactive);
 ASTR(interactive_fps_min);
@@ -257,6 +262,7 @@ ASTR(mirror);
 ASTR(mirrored_ball);
 ASTR(missing);
 ASTR(missing_texture_color);
+ASTR(mode);
 ASTR(motion_end);
 ASTR(motion_start);
 ASTR(multiply);
@@ -280,6 +286,7 @@ ASTR(opacity);
 ASTR(opaque);
 ASTR(options);
 ASTR(orientations);
+ASTR(oriented);
 ASTR(ortho_camera);
 ASTR(osl);
 ASTR(osl_includepath);
@@ -317,6 +324,7 @@ ASTR(scale);
 ASTR(scope);
 ASTR(shade_mode);
 ASTR(shader);
+ASTR(shader_deduplication);
 ASTR(shadow_group);
 ASTR(shidxs);
 ASTR(shutter_end);
@@ -81,7 +81,7 @@ void ArnoldUsdReadCreases(
 }
 
 ArnoldUsdCurvesData::ArnoldUsdCurvesData(int vmin, int vstep, const VtIntArray& vertexCounts)
-    : _vertexCounts(vertexCounts), _vmin(vmin), _vstep(vstep), _numPerVertex(0)
+    : _vertexCounts(vertexCounts), _vmin(vmin), _vstep(vstep), _numPerVertex(0), _numOriginalPerVertex(0)
 {
 }
 
@@ -99,10 +99,15 @@ void ArnoldUsdCurvesData::InitVertexCounts()
 
     const auto numVertexCounts = _vertexCounts.size();
     _arnoldVertexCounts.resize(numVertexCounts);
+    _arnoldVertexOffsets.resize(numVertexCounts);
+    _vertexOffsets.resize(numVertexCounts);
     for (auto i = decltype(numVertexCounts){0}; i < numVertexCounts; i += 1) {
         const auto numSegments = (_vertexCounts[i] - _vmin) / _vstep + 1;
         _arnoldVertexCounts[i] = numSegments + 1;
+        _arnoldVertexOffsets[i] = _numPerVertex;
+        _vertexOffsets[i] = _numOriginalPerVertex;
         _numPerVertex += numSegments + 1;
+        _numOriginalPerVertex += _vertexCounts[i];
     }
 }
 
@@ -21,7 +21,11 @@
 
 #include <pxr/base/arch/export.h>
 
+#include <pxr/base/work/loops.h>
+
 #include <ai.h>
+
+#include <vector>
 PXR_NAMESPACE_OPEN_SCOPE
 
 /// Read subdivision creases from a Usd or a Hydra mesh.
@@ -54,6 +58,9 @@ public:
     ~ArnoldUsdCurvesData() = default;
 
     /// Initialize Arnold Vertex Counts using vmin/vstep and the USD vertex counts.
+    ///
+    /// The offsets of each curve are also calculated, so curves can be remapped independently, and all of these are
+    /// reused for every primvar remapped.
     void InitVertexCounts();
     /// Set the Arnold curves radius from a VtValue.
     ///
@@ -80,22 +87,29 @@ public:
             // need to do any remapping
             return true;
         }
+        // Not enough values to remap, reading them would go out of bounds.
+        if (Ai_unlikely(_numOriginalPerVertex > static_cast<int>(original.size()))) {
+            return true;
+        }
         VtArray<T> remapped(_numPerVertex);
-        const auto* originalP = original.data();
-        auto* remappedP = remapped.data();
+        const auto* originalData = original.cdata();
+        auto* remappedData = remapped.data();
         // We use the first and the last item for each curve and using the CanInterpolate type.
         // - Interpolate values if we can interpolate the type.
         // - Look for the closest one if we can't interpolate the type.
-        for (auto curve = decltype(numVertexCounts){0}; curve < numVertexCounts; curve += 1) {
-            const auto originalVertexCount = _vertexCounts[curve];
-            const auto arnoldVertexCount = _arnoldVertexCounts[curve];
-            const auto arnoldVertexCountMinusOne = arnoldVertexCount - 1;
-            const auto originalVertexCountMinusOne = originalVertexCount - 1;
-            *remappedP = *originalP;
-            remappedP[arnoldVertexCountMinusOne] = originalP[originalVertexCountMinusOne];
-
-            // The original vertex count should always be more than the
-            if (arnoldVertexCount > 2) {
+        // Each curve is independent thanks to the precalculated offsets, so ranges of curves can be remapped in
+        // parallel, and the inner loop has no dependencies between the iterations, so it can be vectorized.
+        // Using a const reference, the non-const accessors of VtArray are not safe to call from multiple threads.
+        const auto& arnoldVertexCounts = _arnoldVertexCounts;
+        auto remapCurves = [&](size_t begin, size_t end) {
+            for (auto curve = begin; curve < end; curve += 1) {
+                const auto* originalP = originalData + _vertexOffsets[curve];
+                auto* remappedP = remappedData + _arnoldVertexOffsets[curve];
+                const auto arnoldVertexCountMinusOne = arnoldVertexCounts[curve] - 1;
+                const auto originalVertexCountMinusOne = _vertexCounts[curve] - 1;
+                *remappedP = *originalP;
+                remappedP[arnoldVertexCountMinusOne] = originalP[originalVertexCountMinusOne];
+
                 for (auto i = 1; i < arnoldVertexCountMinusOne; i += 1) {
                     // Convert i to a range of 0..1.
                     const auto arnoldVertex = static_cast<float>(i) / static_cast<float>(arnoldVertexCountMinusOne);
@@ -105,8 +119,12 @@ public:
                     RemapVertexPrimvar<T>::fn(remappedP[i], originalP, originalVertex);
                 }
             }
-            originalP += originalVertexCount;
-            remappedP += arnoldVertexCount;
+        };
+        // Small curve sets are not worth the overhead of scheduling tasks.
+        if (_numPerVertex < ParallelRemapThreshold) {
+            remapCurves(0, numVertexCounts);
+        } else {
+            WorkParallelForN(numVertexCounts, remapCurves);
         }
 
         // This is the one we are supposed to use when it's expensive to copy objects to VtValue and we don't care
@@ -127,11 +145,17 @@ public:
     }
 
 private:
-    VtIntArray _arnoldVertexCounts;  ///< Arnold vertex counts.
-    const VtIntArray& _vertexCounts; ///< USD vertex counts.
-    int _vmin;                       ///< Minimum vertex count per segment.
-    int _vstep;                      ///< Number of vertices needed to increase segment count by one.
-    int _numPerVertex;               ///< Number of per vertex values.
+    /// Number of remapped values above which curves are remapped in parallel.
+    static constexpr int ParallelRemapThreshold = 16384;
+
+    VtIntArray _arnoldVertexCounts;        ///< Arnold vertex counts.
+    std::vector<int> _arnoldVertexOffsets; ///< Offset of the first Arnold vertex of each curve.
+    std::vector<int> _vertexOffsets;       ///< Offset of the first USD vertex of each curve.
+    const VtIntArray& _vertexCounts;       ///< USD vertex counts.
+    int _vmin;                             ///< Minimum vertex count per segment.
+    int _vstep;                            ///< Number of vertices needed to increase segment count by one.
+    int _numPerVertex;                     ///< Number of per vertex values.
+    int _numOriginalPerVertex;             ///< Number of USD per vertex values.
 
     template <typename T0, typename... T>
     struct IsAny : std::false_type {
@@ -153,11 +177,12 @@ private:
         static inline void fn(T&, const T*, float) {}
     };
 
+    // originalVertex is never negative, so truncating is the same as flooring, but it's cheaper and vectorizes.
     template <typename T>
     struct RemapVertexPrimvar<T, false> {
         static inline void fn(T& remapped, const T* original, float originalVertex)
         {
-            remapped = original[static_cast<int>(floorf(originalVertex))];
+            remapped = original[static_cast<int>(originalVertex)];
         }
     };
 
@@ -165,9 +190,8 @@ private:
     struct RemapVertexPrimvar<T, true> {
         static inline void fn(T& remapped, const T* original, float originalVertex)
         {
-            float originalVertexFloor = 0;
-            const auto originalVertexFrac = modff(originalVertex, &originalVertexFloor);
-            const auto originalVertexFloorInt = static_cast<int>(originalVertexFloor);
+            const auto originalVertexFloorInt = static_cast<int>(originalVertex);
+            const auto originalVertexFrac = originalVertex - static_cast<float>(originalVertexFloorInt);
             remapped =
                 AiLerp(originalVertexFrac, original[originalVertexFloorInt], original[originalVertexFloorInt + 1]);
         }
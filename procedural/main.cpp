@@ -268,6 +268,49 @@ node_loader
 AI_SCENE_FORMAT_EXPORT_METHODS(UsdSceneFormatMtd);
 #include "writer.h"
 
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+
+// Stage and writer kept alive between calls to scene_write with the "incremental" option,
+// so that each call only writes the nodes that changed since the previous one. The session
+// of a file ends when it's written without the "incremental" option, or with the
+// "end_session" option
+struct UsdArnoldWriteSession {
+    std::mutex mutex;
+    UsdStageRefPtr stage;
+    UsdArnoldWriter writer;
+};
+
+std::mutex s_writeSessionsMutex;
+std::unordered_map<std::string, std::shared_ptr<UsdArnoldWriteSession> > s_writeSessions;
+
+// Returns the session writing a given file, creating it if needed. Writing the file
+// without the "incremental" option ends its session
+std::shared_ptr<UsdArnoldWriteSession> _GetWriteSession(const std::string &filename, bool incremental)
+{
+    std::lock_guard<std::mutex> lock(s_writeSessionsMutex);
+    if (!incremental) {
+        s_writeSessions.erase(filename);
+        return nullptr;
+    }
+    std::shared_ptr<UsdArnoldWriteSession> &session = s_writeSessions[filename];
+    if (!session)
+        session = std::make_shared<UsdArnoldWriteSession>();
+    return session;
+}
+
+// Releases the stage and the writer of a file, once the current write is done with them
+void _EndWriteSession(const std::string &filename)
+{
+    std::lock_guard<std::mutex> lock(s_writeSessionsMutex);
+    s_writeSessions.erase(filename);
+}
+
+} // namespace
+
 // SceneLoad(AtUniverse* universe, const char* filename, const AtParamValueMap* params)
 scene_load
 {
@@ -325,21 +368,42 @@ scene_write
     }
 
     bool appendFile = false;
-    if (params)
+    bool incremental = false;
+    // The "end_session" option releases the incremental session of the file after this write
+    bool endSession = false;
+    if (params) {
         AiParamValueMapGetBool(params, str::append, &appendFile);
+        AiParamValueMapGetBool(params, str::incremental, &incremental);
+        AiParamValueMapGetBool(params, str::end_session, &endSession);
+    }
 
-    SdfLayerRefPtr rootLayer = (appendFile) ? SdfLayer::FindOrOpen(filenameStr) :
-                                        SdfLayer::CreateNew(filenameStr.c_str());
-    UsdStageRefPtr stage = UsdStage::Open(rootLayer, UsdStage::LoadAll);
+    // In incremental mode, the stage and the writer of the previous call are reused, and
+    // only the nodes that changed since then are written again to the existing layer
+    std::shared_ptr<UsdArnoldWriteSession> session = _GetWriteSession(filenameStr, incremental);
+    std::unique_lock<std::mutex> sessionLock;
+    if (session)
+        sessionLock = std::unique_lock<std::mutex>(session->mutex);
 
+    UsdStageRefPtr stage = (session) ? session->stage : UsdStageRefPtr();
+    UsdArnoldWriter *writer = (session) ? &session->writer : nullptr;
     if (stage == nullptr) {
-        AiMsgError("[usd] Unable to create USD stage from %s", filenameStr.c_str());
-        return false;
-    }
+        SdfLayerRefPtr rootLayer = (appendFile) ? SdfLayer::FindOrOpen(filenameStr) :
+                                            SdfLayer::CreateNew(filenameStr.c_str());
+        stage = UsdStage::Open(rootLayer, UsdStage::LoadAll);
 
-    // Create a "writer" Translator that will handle the conversion
-    UsdArnoldWriter *writer = new UsdArnoldWriter();
-    writer->SetUsdStage(stage); // give it the output stage
+        if (stage == nullptr) {
+            AiMsgError("[usd] Unable to create USD stage from %s", filenameStr.c_str());
+            return false;
+        }
+        // Create a "writer" Translator that will handle the conversion
+        if (writer == nullptr)
+            writer = new UsdArnoldWriter();
+        writer->SetUsdStage(stage); // give it the output stage
+        if (session) {
+            session->stage = stage;
+            writer->SetIncremental(true);
+        }
+    }
 
     // Check if a mask has been set through the params map
     if (params) {
@@ -358,15 +422,45 @@ scene_write
         bool allAttributes;
         if (AiParamValueMapGetBool(params, str::all_attributes, &allAttributes))
             writer->SetWriteAllAttributes(allAttributes);
+
+        bool instancing;
+        if (AiParamValueMapGetBool(params, str::instancing, &instancing))
+            writer->SetInstancing(instancing);
+
+        bool shaderDeduplication;
+        if (AiParamValueMapGetBool(params, str::shader_deduplication, &shaderDeduplication))
+            writer->SetShaderDeduplication(shaderDeduplication);
+
+        bool compactEncoding;
+        if (AiParamValueMapGetBool(params, str::compact_encoding, &compactEncoding))
+            writer->SetCompactEncoding(compactEncoding);
+
+        // eventually get an amount of threads to write the usd file
+        int threadCount = 1;
+        if (AiParamValueMapGetInt(params, str::threads, &threadCount))
+            writer->SetThreadCount(std::max(threadCount, 0));
     }
     writer->Write(universe);       // convert this universe please
     stage->GetRootLayer()->Save(); // Ask USD to save out the file
 
     AiMsgInfo("[usd] Saved scene as %s", filenameStr.c_str());
-    delete writer;
+    if (session == nullptr)
+        delete writer;
+    else if (endSession)
+        _EndWriteSession(filenameStr);
     return true;
 }
 
+// The sessions that weren't explicitly ended are released when Arnold unloads the plugin,
+// so that their stages aren't destroyed after USD during the static destruction
+#ifdef node_plugin_cleanup
+node_plugin_cleanup
+{
+    std::lock_guard<std::mutex> lock(s_writeSessionsMutex);
+    s_writeSessions.clear();
+}
+#endif
+
 scene_format_loader
 {
     static const char *extensions[] = {".usd", ".usda", ".usdc", NULL};
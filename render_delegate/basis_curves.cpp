@@ -22,14 +22,12 @@
 #include <pxr/base/gf/vec2f.h>
 #include <pxr/base/gf/vec3f.h>
 #include <pxr/base/gf/vec4f.h>
+#include <pxr/base/trace/trace.h>
 
 #include <pxr/usd/sdf/assetPath.h>
 
 /*
  * TODO:
- *  - Add support for per instance variables.
- *  - Investigate periodic and pinned curves.
- *  - Convert normals to orientations.
  *  - Allow overriding basis via a primvar and remap all the parameters.
  *  - Correctly handle degenerate curves using KtoA as an example.
  */
@@ -41,11 +39,284 @@ TF_DEFINE_PRIVATE_TOKENS(
     _tokens,
     (pscale)
     ((basis, "arnold:basis"))
+    ((mode, "arnold:mode"))
+    (periodic)
+    (pinned)
 );
 // clang-format on
 
 namespace {
 
+using CurveWrap = HdArnoldBasisCurves::CurveWrap;
+
+/// Returns the vertices to add to each curve to emulate the wrap mode of the curves.
+///
+/// Arnold does not support periodic or pinned curves, so periodic curves are closed by repeating the vertices from the
+/// other end of the curve, and pinned curves are extended with phantom points, so they reach their end points.
+///
+/// @param curveType Type of the curves.
+/// @param curveBasis Basis of the curves.
+/// @param curveWrap Wrap mode of the curves.
+/// @return Description of the vertices added to each curve.
+CurveWrap _GetCurveWrap(const TfToken& curveType, const TfToken& curveBasis, const TfToken& curveWrap)
+{
+    CurveWrap wrap;
+    const auto isCubicSpline =
+        curveType != HdTokens->linear && (curveBasis == HdTokens->bSpline || curveBasis == HdTokens->catmullRom);
+    if (curveWrap == _tokens->periodic) {
+        wrap.periodic = true;
+        if (isCubicSpline) {
+            wrap.prepend = 1;
+            wrap.append = 2;
+        } else {
+            // Linear and bezier curves only need to get back to the first vertex.
+            wrap.append = 1;
+        }
+    } else if (curveWrap == _tokens->pinned && isCubicSpline) {
+        wrap.prepend = 1;
+        wrap.append = 1;
+    }
+    return wrap;
+}
+
+template <typename T>
+struct CanExtrapolate : std::false_type {
+};
+
+template <>
+struct CanExtrapolate<float> : std::true_type {
+};
+
+template <>
+struct CanExtrapolate<double> : std::true_type {
+};
+
+template <>
+struct CanExtrapolate<GfVec2f> : std::true_type {
+};
+
+template <>
+struct CanExtrapolate<GfVec3f> : std::true_type {
+};
+
+template <>
+struct CanExtrapolate<GfVec4f> : std::true_type {
+};
+
+/// Phantom point making a pinned curve reach its end point, or the end point if it can't be extrapolated.
+template <typename T>
+inline T _GetPhantomValue(const T& end, const T&, bool, std::false_type)
+{
+    return end;
+}
+
+/// Only the points are extrapolated, other primvars would go out of their range, ie. tapered widths becoming negative
+/// or colors going below zero, so they are clamped to the end value.
+template <typename T>
+inline T _GetPhantomValue(const T& end, const T& next, bool extrapolate, std::true_type)
+{
+    return extrapolate ? end + (end - next) : end;
+}
+
+/// Adds the vertices to each curve described by @p wrap.
+///
+/// @param original Pointer to the values of the original curves.
+/// @param wrapped Pointer to the output values, storing the values for the wrapped vertex counts.
+/// @param wrappedVertexCounts Vertex counts of the wrapped curves.
+/// @param wrap Description of the vertices added to each curve.
+/// @param extrapolate If the phantom points of pinned curves are extrapolated, only used for the points.
+template <typename T>
+void _WrapCurveValues(
+    const T* original, T* wrapped, const VtIntArray& wrappedVertexCounts, const CurveWrap& wrap, bool extrapolate)
+{
+    const auto wrappedVertices = wrap.prepend + wrap.append;
+    for (const auto wrappedVertexCount : wrappedVertexCounts) {
+        if (wrappedVertexCount <= wrappedVertices) {
+            continue;
+        }
+        const auto vertexCount = wrappedVertexCount - wrappedVertices;
+        for (auto i = 0; i < wrap.prepend; i += 1) {
+            *wrapped++ = wrap.periodic ? original[(vertexCount - wrap.prepend + i) % vertexCount]
+                                       : _GetPhantomValue(
+                                             original[0], original[std::min(1, vertexCount - 1)], extrapolate,
+                                             CanExtrapolate<T>{});
+        }
+        wrapped = std::copy(original, original + vertexCount, wrapped);
+        for (auto i = 0; i < wrap.append; i += 1) {
+            *wrapped++ = wrap.periodic ? original[i % vertexCount]
+                                       : _GetPhantomValue(
+                                             original[vertexCount - 1], original[std::max(0, vertexCount - 2)],
+                                             extrapolate, CanExtrapolate<T>{});
+        }
+        original += vertexCount;
+    }
+}
+
+/// Returns the number of vertices of the original and the wrapped curves.
+///
+/// @param wrappedVertexCounts Vertex counts of the wrapped curves.
+/// @param wrap Description of the vertices added to each curve.
+/// @return Pair of the number of original and wrapped vertices.
+std::pair<size_t, size_t> _GetNumWrappedVertices(const VtIntArray& wrappedVertexCounts, const CurveWrap& wrap)
+{
+    const auto wrappedVertices = wrap.prepend + wrap.append;
+    size_t numOriginal = 0;
+    size_t numWrapped = 0;
+    for (const auto wrappedVertexCount : wrappedVertexCounts) {
+        if (wrappedVertexCount > wrappedVertices) {
+            numOriginal += wrappedVertexCount - wrappedVertices;
+            numWrapped += wrappedVertexCount;
+        }
+    }
+    return {numOriginal, numWrapped};
+}
+
+/// Wraps a vertex primvar of the curves.
+///
+/// @tparam T Type of the primvar.
+/// @param value Value holding the primvar, replaced by the wrapped values if wrapping is successful.
+/// @param wrappedVertexCounts Vertex counts of the wrapped curves.
+/// @param wrap Description of the vertices added to each curve.
+/// @param extrapolate If the phantom points of pinned curves are extrapolated, only used for the points.
+/// @return True if @p value holds the type @p T.
+template <typename T>
+inline bool _WrapCurvesVertexPrimvar(
+    VtValue& value, const VtIntArray& wrappedVertexCounts, const CurveWrap& wrap, bool extrapolate)
+{
+    if (!value.IsHolding<VtArray<T>>()) {
+        return false;
+    }
+    const auto& original = value.UncheckedGet<VtArray<T>>();
+    const auto numVertices = _GetNumWrappedVertices(wrappedVertexCounts, wrap);
+    if (original.size() != numVertices.first) {
+        return true;
+    }
+    VtArray<T> wrapped(numVertices.second);
+    _WrapCurveValues(original.cdata(), wrapped.data(), wrappedVertexCounts, wrap, extrapolate);
+    value = VtValue::Take(wrapped);
+    return true;
+}
+
+template <typename T0, typename T1, typename... T>
+inline bool _WrapCurvesVertexPrimvar(
+    VtValue& value, const VtIntArray& wrappedVertexCounts, const CurveWrap& wrap, bool extrapolate)
+{
+    return _WrapCurvesVertexPrimvar<T0>(value, wrappedVertexCounts, wrap, extrapolate) ||
+           _WrapCurvesVertexPrimvar<T1, T...>(value, wrappedVertexCounts, wrap, extrapolate);
+}
+
+/// Wraps all the vertex primvar types supported by the curves.
+inline void _WrapCurvesVertexPrimvar(
+    VtValue& value, const VtIntArray& wrappedVertexCounts, const CurveWrap& wrap, bool extrapolate)
+{
+    _WrapCurvesVertexPrimvar<
+        bool, VtUCharArray::value_type, unsigned int, int, float, double, GfHalf, GfVec2f, GfVec3f, GfVec4f,
+        std::string, TfToken, SdfAssetPath>(value, wrappedVertexCounts, wrap, extrapolate);
+}
+
+/// Returns the number of varying values of a wrapped curve, one per segment end.
+///
+/// @param wrappedVertexCount Vertex count of the wrapped curve.
+/// @param vmin Minimum number of vertices per segment.
+/// @param vstep Number of vertices needed to increase segment count by one.
+/// @return Number of varying values of the curve, zero if the curve has no segments.
+inline int _GetNumVaryingValues(int wrappedVertexCount, int vmin, int vstep)
+{
+    return wrappedVertexCount < vmin ? 0 : (wrappedVertexCount - vmin) / vstep + 2;
+}
+
+/// Wraps a varying primvar of the curves.
+///
+/// Varying primvars have one value per segment end. Closing a periodic curve adds a segment end at the start of the
+/// curve, which gets the value of the first segment. The phantom points of pinned curves only add segments so the
+/// curves reach their end points, which USD already accounts for, so their varying primvars are left unchanged.
+///
+/// @tparam T Type of the primvar.
+/// @param value Value holding the primvar, replaced by the wrapped values if wrapping is successful.
+/// @param wrappedVertexCounts Vertex counts of the wrapped curves.
+/// @param wrap Description of the vertices added to each curve.
+/// @param vmin Minimum number of vertices per segment.
+/// @param vstep Number of vertices needed to increase segment count by one.
+/// @return True if @p value holds the type @p T.
+template <typename T>
+inline bool _WrapCurvesVaryingPrimvar(
+    VtValue& value, const VtIntArray& wrappedVertexCounts, const CurveWrap& wrap, int vmin, int vstep)
+{
+    if (!value.IsHolding<VtArray<T>>()) {
+        return false;
+    }
+    if (!wrap.periodic) {
+        return true;
+    }
+    const auto& original = value.UncheckedGet<VtArray<T>>();
+    size_t numOriginal = 0;
+    size_t numWrapped = 0;
+    for (const auto wrappedVertexCount : wrappedVertexCounts) {
+        const auto numValues = _GetNumVaryingValues(wrappedVertexCount, vmin, vstep);
+        if (numValues > 0) {
+            numOriginal += numValues - 1;
+            numWrapped += numValues;
+        }
+    }
+    if (original.size() != numOriginal) {
+        return true;
+    }
+    VtArray<T> wrapped(numWrapped);
+    const auto* originalData = original.cdata();
+    auto* wrappedData = wrapped.data();
+    for (const auto wrappedVertexCount : wrappedVertexCounts) {
+        const auto numValues = _GetNumVaryingValues(wrappedVertexCount, vmin, vstep);
+        if (numValues > 0) {
+            wrappedData = std::copy(originalData, originalData + numValues - 1, wrappedData);
+            *wrappedData++ = originalData[0];
+            originalData += numValues - 1;
+        }
+    }
+    value = VtValue::Take(wrapped);
+    return true;
+}
+
+template <typename T0, typename T1, typename... T>
+inline bool _WrapCurvesVaryingPrimvar(
+    VtValue& value, const VtIntArray& wrappedVertexCounts, const CurveWrap& wrap, int vmin, int vstep)
+{
+    return _WrapCurvesVaryingPrimvar<T0>(value, wrappedVertexCounts, wrap, vmin, vstep) ||
+           _WrapCurvesVaryingPrimvar<T1, T...>(value, wrappedVertexCounts, wrap, vmin, vstep);
+}
+
+/// Wraps all the varying primvar types supported by the curves.
+inline void _WrapCurvesVaryingPrimvar(
+    VtValue& value, const VtIntArray& wrappedVertexCounts, const CurveWrap& wrap, int vmin, int vstep)
+{
+    _WrapCurvesVaryingPrimvar<
+        bool, VtUCharArray::value_type, unsigned int, int, float, double, GfHalf, GfVec2f, GfVec3f, GfVec4f,
+        std::string, TfToken, SdfAssetPath>(value, wrappedVertexCounts, wrap, vmin, vstep);
+}
+
+/// Wraps the points already set on the curves, including all the motion keys.
+///
+/// @param node Pointer to the Arnold Curves.
+/// @param wrappedVertexCounts Vertex counts of the wrapped curves.
+/// @param wrap Description of the vertices added to each curve.
+void _WrapCurvesPoints(AtNode* node, const VtIntArray& wrappedVertexCounts, const CurveWrap& wrap)
+{
+    auto* original = AiNodeGetArray(node, str::points);
+    const auto numVertices = _GetNumWrappedVertices(wrappedVertexCounts, wrap);
+    if (original == nullptr || AiArrayGetNumElements(original) != numVertices.first) {
+        return;
+    }
+    const auto numKeys = AiArrayGetNumKeys(original);
+    auto* wrapped = AiArrayAllocate(numVertices.second, numKeys, AI_TYPE_VECTOR);
+    for (auto key = decltype(numKeys){0}; key < numKeys; key += 1) {
+        _WrapCurveValues(
+            static_cast<const GfVec3f*>(AiArrayMapKey(original, key)),
+            static_cast<GfVec3f*>(AiArrayMapKey(wrapped, key)), wrappedVertexCounts, wrap, true);
+    }
+    AiArrayUnmap(original);
+    AiArrayUnmap(wrapped);
+    AiNodeSetArray(node, str::points, wrapped);
+}
+
 } // namespace
 
 #if PXR_VERSION >= 2102
@@ -64,19 +335,14 @@ HdArnoldBasisCurves::HdArnoldBasisCurves(
 void HdArnoldBasisCurves::Sync(
     HdSceneDelegate* sceneDelegate, HdRenderParam* renderParam, HdDirtyBits* dirtyBits, const TfToken& reprToken)
 {
+    TRACE_FUNCTION();
+    HdArnoldRenderStatsScope statsScope(renderParam, HdArnoldRenderStats::PrimType::BasisCurves);
     TF_UNUSED(reprToken);
     HdArnoldRenderParamInterrupt param(renderParam);
     const auto& id = GetId();
 
-    // Points can either come through accessing HdTokens->points, or driven by UsdSkel.
-    const auto dirtyPrimvars = HdArnoldGetComputedPrimvars(sceneDelegate, id, *dirtyBits, _primvars) ||
-                               (*dirtyBits & HdChangeTracker::DirtyPrimvar);
-    if (_primvars.count(HdTokens->points) == 0 && HdChangeTracker::IsPrimvarDirty(*dirtyBits, id, HdTokens->points)) {
-        param.Interrupt();
-        HdArnoldSetPositionFromPrimvar(GetArnoldNode(), id, sceneDelegate, str::points);
-    }
-
-    if (HdChangeTracker::IsTopologyDirty(*dirtyBits, id)) {
+    const auto topologyDirty = HdChangeTracker::IsTopologyDirty(*dirtyBits, id);
+    if (topologyDirty) {
         param.Interrupt();
         const auto topology = GetBasisCurvesTopology(sceneDelegate);
         const auto curveBasis = topology.GetCurveBasis();
@@ -99,10 +365,19 @@ void HdArnoldBasisCurves::Sync(
                 _interpolation = HdTokens->linear;
             }
         }
-        const auto& vertexCounts = topology.GetCurveVertexCounts();
-        // When interpolation is linear, we clear out stored vertex counts, because we don't need them anymore.
-        // Otherwise we need to store vertex counts for remapping primvars.
-        if (_interpolation == HdTokens->linear) {
+        _wrap = _GetCurveWrap(curveType, curveBasis, topology.GetCurveWrap());
+        auto vertexCounts = topology.GetCurveVertexCounts();
+        if (_wrap.IsWrapping()) {
+            const auto wrappedVertices = _wrap.prepend + _wrap.append;
+            for (auto& vertexCount : vertexCounts) {
+                if (vertexCount > 0) {
+                    vertexCount += wrappedVertices;
+                }
+            }
+        }
+        // When interpolation is linear and the curves are not wrapped, we clear out stored vertex counts, because we
+        // don't need them anymore. Otherwise we need to store vertex counts for remapping and wrapping primvars.
+        if (_interpolation == HdTokens->linear && !_wrap.IsWrapping()) {
             decltype(_vertexCounts){}.swap(_vertexCounts);
         } else {
             _vertexCounts = vertexCounts;
@@ -117,6 +392,19 @@ void HdArnoldBasisCurves::Sync(
         AiNodeSetArray(GetArnoldNode(), str::num_points, numPointsArray);
     }
 
+    // Points can either come through accessing HdTokens->points, or driven by UsdSkel.
+    const auto dirtyPrimvars = HdArnoldGetComputedPrimvars(sceneDelegate, id, *dirtyBits, _primvars) ||
+                               (*dirtyBits & HdChangeTracker::DirtyPrimvar);
+    // Changing the topology might change the vertices added by wrapping, so all the vertex primvars are updated.
+    if (_primvars.count(HdTokens->points) == 0 &&
+        (topologyDirty || HdChangeTracker::IsPrimvarDirty(*dirtyBits, id, HdTokens->points))) {
+        param.Interrupt();
+        HdArnoldSetPositionFromPrimvar(GetArnoldNode(), id, sceneDelegate, str::points);
+        if (_wrap.IsWrapping()) {
+            _WrapCurvesPoints(GetArnoldNode(), _vertexCounts, _wrap);
+        }
+    }
+
     if (HdChangeTracker::IsVisibilityDirty(*dirtyBits, id)) {
         param.Interrupt();
         _UpdateVisibility(sceneDelegate, dirtyBits);
@@ -143,30 +431,52 @@ void HdArnoldBasisCurves::Sync(
         }
     }
 
-    if (dirtyPrimvars) {
-        HdArnoldGetPrimvars(sceneDelegate, id, *dirtyBits, false, _primvars);
+    if (dirtyPrimvars || topologyDirty) {
+        if (dirtyPrimvars) {
+            HdArnoldGetPrimvars(sceneDelegate, id, *dirtyBits, false, _primvars);
+        }
         param.Interrupt();
         auto visibility = GetShapeVisibility();
         const auto vstep = _interpolation == HdTokens->bezier ? 3 : 1;
         const auto vmin = _interpolation == HdTokens->linear ? 2 : 4;
 
         ArnoldUsdCurvesData curvesData(vmin, vstep, _vertexCounts);
+        // Vertex and varying primvars are wrapped before remapping, since the remapping uses the wrapped vertex
+        // counts. Only the points are extrapolated for the phantom points of pinned curves.
+        auto getVertexValue = [&](const HdArnoldPrimvar& desc, bool extrapolate) -> VtValue {
+            auto value = desc.value;
+            if (_wrap.IsWrapping()) {
+                if (desc.interpolation == HdInterpolationVertex) {
+                    _WrapCurvesVertexPrimvar(value, _vertexCounts, _wrap, extrapolate);
+                } else if (desc.interpolation == HdInterpolationVarying) {
+                    _WrapCurvesVaryingPrimvar(value, _vertexCounts, _wrap, vmin, vstep);
+                }
+            }
+            return value;
+        };
+        auto hasOrientations = false;
+        auto hasMode = false;
 
         for (auto& primvar : _primvars) {
             auto& desc = primvar.second;
-            if (!desc.NeedsUpdate()) {
+            // Normals and the mode are needed to choose the mode of the curves.
+            if (primvar.first == HdTokens->normals) {
+                hasOrientations = desc.interpolation == HdInterpolationVertex;
+            } else if (primvar.first == _tokens->mode) {
+                hasMode = true;
+            }
+            if (!desc.NeedsUpdate() && !topologyDirty) {
                 continue;
             }
 
             if (primvar.first == HdTokens->widths) {
                 if ((desc.interpolation == HdInterpolationVertex || desc.interpolation == HdInterpolationVarying) &&
                     _interpolation != HdTokens->linear) {
-                    auto value = desc.value;
-
+                    auto value = getVertexValue(desc, false);
                     curvesData.RemapCurvesVertexPrimvar<float, double, GfHalf>(value);
                     ArnoldUsdCurvesData::SetRadiusFromValue(GetArnoldNode(), value);
                 } else {
-                    ArnoldUsdCurvesData::SetRadiusFromValue(GetArnoldNode(), desc.value);
+                    ArnoldUsdCurvesData::SetRadiusFromValue(GetArnoldNode(), getVertexValue(desc, false));
                 }
                 // For constant and
             } else if (desc.interpolation == HdInterpolationConstant) {
@@ -201,12 +511,15 @@ void HdArnoldBasisCurves::Sync(
                 }
             } else if (desc.interpolation == HdInterpolationVertex || desc.interpolation == HdInterpolationVarying) {
                 if (primvar.first == HdTokens->points) {
-                    HdArnoldSetPositionFromValue(GetArnoldNode(), str::curves, desc.value);
+                    HdArnoldSetPositionFromValue(GetArnoldNode(), str::points, getVertexValue(desc, true));
                 } else if (primvar.first == HdTokens->normals) {
-                    // This should be the same number as points.
-                    HdArnoldSetPositionFromValue(GetArnoldNode(), str::orientations, desc.value);
+                    // Orientations are per point, so only vertex normals can be used. Arnold uses the orientations to
+                    // point the front of the ribbons, the same way as normals of USD curves.
+                    if (desc.interpolation == HdInterpolationVertex) {
+                        HdArnoldSetPositionFromValue(GetArnoldNode(), str::orientations, getVertexValue(desc, false));
+                    }
                 } else {
-                    auto value = desc.value;
+                    auto value = getVertexValue(desc, false);
                     if (_interpolation != HdTokens->linear) {
                         curvesData.RemapCurvesVertexPrimvar<
                             bool, VtUCharArray::value_type, unsigned int, int, float, GfVec2f, GfVec3f, GfVec4f,
@@ -214,10 +527,18 @@ void HdArnoldBasisCurves::Sync(
                     }
                     HdArnoldSetVertexPrimvar(GetArnoldNode(), primvar.first, desc.role, value);
                 }
-            } else if (desc.interpolation == HdInterpolationVarying) {
-                HdArnoldSetVertexPrimvar(GetArnoldNode(), primvar.first, desc.role, desc.value);
             }
         }
+        // Oriented mode is required to use the orientations, unless the mode is explicitly set via a primvar.
+        if (hasOrientations && !hasMode) {
+            AiNodeSetStr(GetArnoldNode(), str::mode, str::oriented);
+        } else if (!hasOrientations && _hasOrientations) {
+            AiNodeResetParameter(GetArnoldNode(), str::orientations);
+            if (!hasMode) {
+                AiNodeResetParameter(GetArnoldNode(), str::mode);
+            }
+        }
+        _hasOrientations = hasOrientations;
         SetShapeVisibility(visibility);
     }
 
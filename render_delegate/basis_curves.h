@@ -68,10 +68,24 @@ public:
     /// @return Initial Dirty Bits.
     HdDirtyBits GetInitialDirtyBitsMask() const override;
 
+    /// Vertices added to each curve to emulate periodic and pinned curves, which are not supported by Arnold.
+    struct CurveWrap {
+        int prepend = 0;       ///< Number of vertices added before the first vertex of each curve.
+        int append = 0;        ///< Number of vertices added after the last vertex of each curve.
+        bool periodic = false; ///< Vertices are copied from the other end of the curve, or added at the ends if false.
+
+        /// Returns true if vertices are added to the curves.
+        ///
+        /// @return True if vertices are added to the curves.
+        bool IsWrapping() const { return prepend != 0 || append != 0; }
+    };
+
 protected:
-    HdArnoldPrimvarMap _primvars; ///< Precomputed list of primvars.
-    TfToken _interpolation;       ///< Interpolation of the curve.
-    VtIntArray _vertexCounts;     ///< Stored vertex counts for curves.
+    HdArnoldPrimvarMap _primvars;  ///< Precomputed list of primvars.
+    TfToken _interpolation;        ///< Interpolation of the curve.
+    VtIntArray _vertexCounts;      ///< Stored vertex counts for curves, including the vertices added by wrapping.
+    CurveWrap _wrap;               ///< Vertices added to each curve to emulate the wrap mode.
+    bool _hasOrientations = false; ///< If orientations were set from normals.
 };
 
 PXR_NAMESPACE_CLOSE_SCOPE
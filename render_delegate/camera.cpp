@@ -14,6 +14,7 @@
 #include "camera.h"
 
 #include <pxr/base/gf/range1f.h>
+#include <pxr/base/trace/trace.h>
 
 #include <constant_strings.h>
 #include "utils.h"
@@ -39,6 +40,8 @@ HdArnoldCamera::~HdArnoldCamera() { AiNodeDestroy(_camera); }
 
 void HdArnoldCamera::Sync(HdSceneDelegate* sceneDelegate, HdRenderParam* renderParam, HdDirtyBits* dirtyBits)
 {
+    TRACE_FUNCTION();
+    HdArnoldRenderStatsScope statsScope(renderParam, HdArnoldRenderStats::PrimType::Camera);
     auto* param = reinterpret_cast<HdArnoldRenderParam*>(renderParam);
     auto oldBits = *dirtyBits;
     HdCamera::Sync(sceneDelegate, renderParam, &oldBits);
@@ -90,8 +90,19 @@ TF_DEFINE_ENV_SETTING(
 
 TF_DEFINE_ENV_SETTING(HDARNOLD_interactive_fps_min, "5.0", "Minimum fps for progressive rendering.");
 
+TF_DEFINE_ENV_SETTING(
+    HDARNOLD_enable_adaptive_frame_rate, true,
+    "Adapt the first progressive pass and the bucket size to the target fps while interacting.");
+
+TF_DEFINE_ENV_SETTING(
+    HDARNOLD_prefetch_light_textures, true,
+    "Load dome and rect light textures in the background, so the first render is not blocked on disk access.");
+
 TF_DEFINE_ENV_SETTING(HDARNOLD_profile_file, "", "Output file for profiling information.")
 
+TF_DEFINE_ENV_SETTING(
+    HDARNOLD_trace_file, "", "Output file for Chrome tracing information of the Render Delegate's sync and render.");
+
 TF_DEFINE_ENV_SETTING(HDARNOLD_texture_searchpath, "", "Texture search path.");
 
 TF_DEFINE_ENV_SETTING(HDARNOLD_plugin_searchpath, "", "Plugin search path.");
@@ -129,7 +140,10 @@ HdArnoldConfig::HdArnoldConfig()
         std::max(1.0f, static_cast<float>(std::atof(TfGetEnvSetting(HDARNOLD_interactive_target_fps_min).c_str())));
     interactive_fps_min =
         std::max(1.0f, static_cast<float>(std::atof(TfGetEnvSetting(HDARNOLD_interactive_fps_min).c_str())));
+    enable_adaptive_frame_rate = TfGetEnvSetting(HDARNOLD_enable_adaptive_frame_rate);
+    prefetch_light_textures = TfGetEnvSetting(HDARNOLD_prefetch_light_textures);
     profile_file = TfGetEnvSetting(HDARNOLD_profile_file);
+    trace_file = TfGetEnvSetting(HDARNOLD_trace_file);
     texture_searchpath = TfGetEnvSetting(HDARNOLD_texture_searchpath);
     plugin_searchpath = TfGetEnvSetting(HDARNOLD_plugin_searchpath);
     procedural_searchpath = TfGetEnvSetting(HDARNOLD_procedural_searchpath);
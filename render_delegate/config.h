@@ -149,10 +149,22 @@ struct HdArnoldConfig {
     ///
     float interactive_fps_min; ///< Interactive FPS Minimum.
 
+    /// Use HDARNOLD_enable_adaptive_frame_rate to set value.
+    ///
+    bool enable_adaptive_frame_rate; ///< Enables adapting progressive rendering to the target FPS.
+
+    /// Use HDARNOLD_prefetch_light_textures to set value.
+    ///
+    bool prefetch_light_textures; ///< Loads dome and rect light textures in the background.
+
     /// Use HDARNOLD_profile_file to set the value.
     ///
     std::string profile_file; ///< Output file for profiling data.
 
+    /// Use HDARNOLD_trace_file to set the value.
+    ///
+    std::string trace_file; ///< Output file for Chrome tracing data of the Render Delegate.
+
     /// Use HDARNOLD_texture_searchpath to set the value.
     ///
     std::string texture_searchpath; ///< Texture search path.
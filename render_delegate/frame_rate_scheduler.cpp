@@ -0,0 +1,129 @@
+// Copyright 2021 Autodesk, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "frame_rate_scheduler.h"
+
+#include <algorithm>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+namespace {
+
+inline float _ToSeconds(HdArnoldFrameRateScheduler::Clock::duration duration)
+{
+    return std::chrono::duration_cast<std::chrono::duration<float>>(duration).count();
+}
+
+// AA samples of zero would not render anything, so progressive passes go from -1 to 1.
+inline int _SkipZeroAASamples(int aaSamples, int direction) { return aaSamples == 0 ? direction : aaSamples; }
+
+} // namespace
+
+HdArnoldFrameRateScheduler::HdArnoldFrameRateScheduler() : HdArnoldFrameRateScheduler(Settings{}) {}
+
+HdArnoldFrameRateScheduler::HdArnoldFrameRateScheduler(const Settings& settings)
+    : _settings(settings), _aaSamples(settings.progressiveMinAASamples), _bucketSize(settings.bucketSize)
+{
+    _ClampQuality();
+}
+
+void HdArnoldFrameRateScheduler::SetSettings(const Settings& settings)
+{
+    _settings = settings;
+    _ClampQuality();
+}
+
+void HdArnoldFrameRateScheduler::Restart(Clock::time_point now)
+{
+    if (!_settings.enabled) {
+        _interactive = false;
+        _waitingForUpdate = false;
+        return;
+    }
+    // Restarts coming in quick succession mean the user is interacting with the scene or the camera.
+    _interactive = _hasRestarted && _ToSeconds(now - _restartTime) < _settings.idleTime;
+    _hasRestarted = true;
+    // When restarts keep coming before the first pixels arrive, the viewport is not updating at all and there is
+    // nothing to measure, so the quality is lowered based on the time since the last update.
+    if (!_interactive || !_waitingForUpdate) {
+        _waitingSince = now;
+    } else if (_ToSeconds(now - _waitingSince) > _GetMaxLatency()) {
+        _LowerQuality();
+        _latency = 0.0f;
+        _waitingSince = now;
+    }
+    _waitingForUpdate = true;
+    _restartTime = now;
+}
+
+void HdArnoldFrameRateScheduler::Update(Clock::time_point now)
+{
+    if (!_waitingForUpdate) {
+        return;
+    }
+    _waitingForUpdate = false;
+    // Restarts using the idle settings tell us nothing about the interactive settings.
+    if (!_interactive) {
+        return;
+    }
+    const auto latency = _ToSeconds(now - _restartTime);
+    _latency = _latency > 0.0f ? (_latency + latency) * 0.5f : latency;
+    // Leaving a gap between the two thresholds, so the quality does not oscillate between two steps.
+    if (_latency > _GetMaxLatency()) {
+        _LowerQuality();
+        // Previous measurements were done with different settings.
+        _latency = 0.0f;
+    } else if (_latency < 0.5f / _settings.targetFps) {
+        _RaiseQuality();
+        _latency = 0.0f;
+    }
+}
+
+float HdArnoldFrameRateScheduler::_GetMaxLatency() const
+{
+    return std::max(1.0f / _settings.targetFpsMin, 1.0f / _settings.targetFps);
+}
+
+void HdArnoldFrameRateScheduler::_LowerQuality()
+{
+    // Lowering the resolution of the first pass has the biggest effect, smaller buckets only help keeping all the
+    // threads busy when the first pass has very few pixels.
+    if (_aaSamples > _settings.minAASamples) {
+        _aaSamples = _SkipZeroAASamples(_aaSamples - 1, -1);
+    } else if (_bucketSize > _settings.minBucketSize) {
+        _bucketSize = std::max(_settings.minBucketSize, _bucketSize / 2);
+    }
+}
+
+void HdArnoldFrameRateScheduler::_RaiseQuality()
+{
+    // Steps are taken in the reverse order of _LowerQuality.
+    if (_bucketSize < _settings.bucketSize) {
+        _bucketSize = std::min(_settings.bucketSize, _bucketSize * 2);
+    } else if (_aaSamples < _settings.maxAASamples) {
+        _aaSamples = _SkipZeroAASamples(_aaSamples + 1, 1);
+    }
+}
+
+void HdArnoldFrameRateScheduler::_ClampQuality()
+{
+    _settings.targetFps = std::max(1.0f, _settings.targetFps);
+    _settings.targetFpsMin = std::max(1.0f, _settings.targetFpsMin);
+    _settings.bucketSize = std::max(1, _settings.bucketSize);
+    _settings.minBucketSize = std::max(1, std::min(_settings.minBucketSize, _settings.bucketSize));
+    _settings.maxAASamples = std::max(_settings.minAASamples, _settings.maxAASamples);
+    _aaSamples = _SkipZeroAASamples(std::max(_settings.minAASamples, std::min(_settings.maxAASamples, _aaSamples)), -1);
+    _bucketSize = std::max(_settings.minBucketSize, std::min(_settings.bucketSize, _bucketSize));
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
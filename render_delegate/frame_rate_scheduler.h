@@ -0,0 +1,134 @@
+// Copyright 2021 Autodesk, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+/// @file frame_rate_scheduler.h
+///
+/// Utilities for adapting progressive rendering to a target frame rate.
+#pragma once
+
+#include "api.h"
+
+#include <pxr/pxr.h>
+
+#include <chrono>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/// Utility class adapting the progressive render settings to a target frame rate.
+///
+/// The scheduler measures the time between restarting the render and receiving the first pixels, and uses it to pick
+/// the AA samples of the first progressive pass and the bucket size for the following restarts. When restarts come
+/// in quickly, ie. while tumbling the camera, the quality is lowered until the target frame rate is met, and raised
+/// again when there is headroom. When there were no restarts for a while, the scheduler switches back to the idle
+/// settings, so a single change is rendered with the full quality requested by the user.
+///
+/// The class does not call any Arnold functions and takes the current time as a parameter, so it can be driven by a
+/// simulated clock. It is not thread safe, all the functions are expected to be called from the render thread.
+class HdArnoldFrameRateScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Settings for the scheduler.
+    struct Settings {
+        bool enabled = true;              ///< If the scheduler adapts the render settings.
+        float targetFps = 30.0f;          ///< Target frame rate while interacting.
+        float targetFpsMin = 20.0f;       ///< Quality is lowered when the frame rate goes below this.
+        int progressiveMinAASamples = -4; ///< AA samples of the first progressive pass when idle.
+        int bucketSize = 64;              ///< Bucket size when idle.
+        int minAASamples = -6;            ///< Lowest AA samples of the first progressive pass while interacting.
+        int maxAASamples = 1;             ///< Highest AA samples of the first progressive pass while interacting.
+        int minBucketSize = 8;            ///< Lowest bucket size while interacting.
+        float idleTime = 0.5f;            ///< Time in seconds without restarts before switching to the idle settings.
+    };
+
+    /// Constructor for HdArnoldFrameRateScheduler using the default settings.
+    HDARNOLD_API
+    HdArnoldFrameRateScheduler();
+
+    /// Constructor for HdArnoldFrameRateScheduler.
+    ///
+    /// @param settings Settings for the scheduler.
+    HDARNOLD_API
+    explicit HdArnoldFrameRateScheduler(const Settings& settings);
+
+    /// Returns the settings of the scheduler.
+    ///
+    /// @return Constant reference to the settings.
+    const Settings& GetSettings() const { return _settings; }
+
+    /// Sets new settings for the scheduler.
+    ///
+    /// @param settings New settings for the scheduler.
+    HDARNOLD_API
+    void SetSettings(const Settings& settings);
+
+    /// Notifies the scheduler that rendering is about to be started or restarted.
+    ///
+    /// Chooses the render settings for the restart, query them via GetAASamples and GetBucketSize.
+    ///
+    /// @param now Current time.
+    HDARNOLD_API
+    void Restart(Clock::time_point now);
+
+    /// Notifies the scheduler that new pixels were received from the renderer.
+    ///
+    /// Only the first update after a restart is measured.
+    ///
+    /// @param now Current time.
+    HDARNOLD_API
+    void Update(Clock::time_point now);
+
+    /// Returns true if the last restart happened while interacting.
+    ///
+    /// @return True if interacting, false if idle.
+    bool IsInteractive() const { return _interactive; }
+
+    /// Returns the AA samples of the first progressive pass for the last restart.
+    ///
+    /// @return AA samples of the first progressive pass.
+    int GetAASamples() const { return _interactive ? _aaSamples : _settings.progressiveMinAASamples; }
+
+    /// Returns the bucket size for the last restart.
+    ///
+    /// @return Bucket size.
+    int GetBucketSize() const { return _interactive ? _bucketSize : _settings.bucketSize; }
+
+    /// Returns the smoothed time to the first pixels while interacting.
+    ///
+    /// @return Time to the first pixels in seconds, zero if nothing was measured yet.
+    float GetLatency() const { return _latency; }
+
+private:
+    /// Returns the time to the first pixels above which the quality is lowered.
+    ///
+    /// @return Maximum time to the first pixels in seconds.
+    float _GetMaxLatency() const;
+    /// Lowers the interactive quality by a single step.
+    void _LowerQuality();
+    /// Raises the interactive quality by a single step.
+    void _RaiseQuality();
+    /// Clamps the interactive settings to the ranges in the settings.
+    void _ClampQuality();
+
+    Settings _settings;              ///< Settings of the scheduler.
+    Clock::time_point _restartTime;  ///< Time of the last restart.
+    Clock::time_point _waitingSince; ///< Time of the first restart without any updates since.
+    float _latency = 0.0f;           ///< Smoothed time to the first pixels in seconds.
+    int _aaSamples = 0;              ///< AA samples of the first progressive pass while interacting.
+    int _bucketSize = 0;             ///< Bucket size while interacting.
+    bool _hasRestarted = false;      ///< If there was any restart yet.
+    bool _waitingForUpdate = false;  ///< If the first update after the last restart was not received yet.
+    bool _interactive = false;       ///< If the last restart happened while interacting.
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
@@ -15,6 +15,7 @@
 
 #include <pxr/base/gf/quaternion.h>
 #include <pxr/base/gf/rotation.h>
+#include <pxr/base/trace/trace.h>
 #include <pxr/imaging/hd/sceneDelegate.h>
 
 PXR_NAMESPACE_OPEN_SCOPE
@@ -59,6 +60,8 @@ HdArnoldInstancer::HdArnoldInstancer(
 #if PXR_VERSION >= 2102
 void HdArnoldInstancer::Sync(HdSceneDelegate* sceneDelegate, HdRenderParam* renderParam, HdDirtyBits* dirtyBits)
 {
+    TRACE_FUNCTION();
+    HdArnoldRenderStatsScope statsScope(renderParam, HdArnoldRenderStats::PrimType::Instancer);
     _UpdateInstancer(sceneDelegate, dirtyBits);
 
     if (HdChangeTracker::IsAnyPrimvarDirty(*dirtyBits, GetId())) {
@@ -120,6 +123,7 @@ void HdArnoldInstancer::_SyncPrimvars(
 void HdArnoldInstancer::CalculateInstanceMatrices(
     const SdfPath& prototypeId, HdArnoldSampledMatrixArrayType& sampleArray)
 {
+    TRACE_FUNCTION();
 #if PXR_VERSION < 2102
     _SyncPrimvars();
 #endif
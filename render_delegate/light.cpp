@@ -27,10 +27,15 @@
 // limitations under the License.
 #include "light.h"
 
+#include <pxr/base/trace/trace.h>
+
 #include <pxr/usd/usdLux/tokens.h>
 
 #include <pxr/usd/sdf/assetPath.h>
 
+#include <algorithm>
+#include <initializer_list>
+#include <unordered_map>
 #include <vector>
 
 #include <constant_strings.h>
@@ -136,17 +141,127 @@ std::vector<ParamDesc> diskParams = {{"radius", HdLightTokens->radius}};
 std::vector<ParamDesc> cylinderParams = {{"radius", HdLightTokens->radius}};
 #endif
 
+/// Utility class caching the light parameters read from the Scene Delegate.
+///
+/// Values are compared to the ones from the previous sync, so only the changed parameters are set on the Arnold light
+/// and rendering is only interrupted when a parameter actually changed. This keeps editing a single parameter cheap
+/// in scenes with thousands of lights.
+class LightParamCache {
+public:
+    /// Starts a new sync, parameters are queried again from the Scene Delegate when first accessed.
+    ///
+    /// @param sceneDelegate Pointer to the Scene Delegate.
+    /// @param id Path to the Hydra Light.
+    /// @param param Pointer to the utility interrupting the render, called before the first changed value is returned.
+    void BeginSync(HdSceneDelegate* sceneDelegate, const SdfPath& id, HdArnoldRenderParamInterrupt* param)
+    {
+        _sceneDelegate = sceneDelegate;
+        _id = id;
+        _param = param;
+        _sync += 1;
+        _anyChanged = false;
+    }
+
+    /// Forgets all the cached values, so all the parameters are treated as changed.
+    void Clear() { _values.clear(); }
+
+    /// Returns the value of a light parameter.
+    ///
+    /// @param name Name of the light parameter.
+    /// @return Value of the light parameter.
+    const VtValue& Get(const TfToken& name) { return _Get(name, false).value; }
+
+    /// Returns the value of a primvar on the light.
+    ///
+    /// @param name Full name of the primvar, including the primvars: prefix if required by the USD version.
+    /// @return Value of the primvar.
+    const VtValue& GetPrimvar(const TfToken& name) { return _Get(name, true).value; }
+
+    /// Returns true if a light parameter changed since the last sync.
+    ///
+    /// @param name Name of the light parameter.
+    /// @return True if the parameter changed or it is queried for the first time.
+    bool HasChanged(const TfToken& name) { return _Get(name, false).changed; }
+
+    /// Returns true if any of the light parameters changed since the last sync.
+    ///
+    /// @param names Names of the light parameters.
+    /// @return True if any of the parameters changed or they are queried for the first time.
+    bool HasChanged(std::initializer_list<TfToken> names)
+    {
+        // All the parameters are queried, so their values are cached for the next sync.
+        auto changed = false;
+        for (const auto& name : names) {
+            changed |= HasChanged(name);
+        }
+        return changed;
+    }
+
+    /// Returns true if a primvar on the light changed since the last sync.
+    ///
+    /// @param name Full name of the primvar, including the primvars: prefix if required by the USD version.
+    /// @return True if the primvar changed or it is queried for the first time.
+    bool HasPrimvarChanged(const TfToken& name) { return _Get(name, true).changed; }
+
+    /// Returns true if any of the parameters queried during the current sync changed.
+    ///
+    /// @return True if any of the queried parameters changed.
+    bool HasAnyChanged() const { return _anyChanged; }
+
+private:
+    /// Cached value of a single parameter.
+    struct Value {
+        VtValue value;        ///< Value of the parameter.
+        uint32_t sync = 0;    ///< Sync when the parameter was last queried, zero if never.
+        bool changed = false; ///< If the parameter changed during the last query.
+    };
+
+    const Value& _Get(const TfToken& name, bool isPrimvar)
+    {
+        auto& value = _values[name];
+        if (value.sync == _sync) {
+            return value;
+        }
+        auto newValue = isPrimvar ? _sceneDelegate->Get(_id, name) : _sceneDelegate->GetLightParamValue(_id, name);
+        // Parameters queried for the first time are always treated as changed, so the defaults are set on the light.
+        value.changed = value.sync == 0 || newValue != value.value;
+        value.sync = _sync;
+        if (value.changed) {
+            value.value = std::move(newValue);
+            _anyChanged = true;
+            // Changed values are set on the light right after they are queried.
+            _param->Interrupt();
+        }
+        return value;
+    }
+
+    std::unordered_map<TfToken, Value, TfToken::HashFunctor> _values; ///< Cached values of the parameters.
+    HdSceneDelegate* _sceneDelegate = nullptr;                      ///< Scene Delegate of the current sync.
+    HdArnoldRenderParamInterrupt* _param = nullptr;                 ///< Interrupts the render for the current sync.
+    SdfPath _id;                                                    ///< Path to the Hydra Light.
+    uint32_t _sync = 0;                                             ///< Number of syncs.
+    bool _anyChanged = false;                                       ///< If any parameter changed in the current sync.
+};
+
 void iterateParams(
-    AtNode* light, const AtNodeEntry* nentry, const SdfPath& id, HdSceneDelegate* delegate,
-    const std::vector<ParamDesc>& params)
+    AtNode* light, const AtNodeEntry* nentry, LightParamCache& paramCache, const std::vector<ParamDesc>& params,
+    bool force = false)
 {
     for (const auto& param : params) {
         const auto* pentry = AiNodeEntryLookUpParameter(nentry, param.arnoldName);
         if (pentry == nullptr) {
             continue;
         }
-
-        HdArnoldSetParameter(light, pentry, delegate->GetLightParamValue(id, param.hdName));
+        if (!paramCache.HasChanged(param.hdName) && !force) {
+            continue;
+        }
+        const auto& value = paramCache.Get(param.hdName);
+        if (value.IsEmpty()) {
+            // The light is not reset between syncs, so removed values have to be reset one by one.
+            AiNodeResetParameter(light, param.arnoldName);
+        } else {
+            HdArnoldSetParameter(light, pentry, value);
+        }
     }
 }
 
@@ -205,29 +320,36 @@ AtString getLightType(HdSceneDelegate* delegate, const SdfPath& id)
     return hasIesFile() ? str::photometric_light : str::point_light;
 }
 
-auto spotLightSync = [](AtNode* light, AtNode** filter, const AtNodeEntry* nentry, const SdfPath& id,
-                        HdSceneDelegate* sceneDelegate, HdArnoldRenderDelegate* renderDelegate) {
-    iterateParams(light, nentry, id, sceneDelegate, spotParams);
+auto spotLightSync = [](AtNode* light, AtNode** filter, const AtNodeEntry* nentry, LightParamCache& paramCache,
+                        HdArnoldRenderDelegate* renderDelegate) {
+    iterateParams(light, nentry, paramCache, spotParams);
 #if PXR_VERSION >= 2105
-    const auto hdAngle =
-        sceneDelegate->GetLightParamValue(id, UsdLuxTokens->inputsShapingConeAngle).GetWithDefault(180.0f);
-    const auto softness =
-        sceneDelegate->GetLightParamValue(id, UsdLuxTokens->inputsShapingConeSoftness).GetWithDefault(0.0f);
+    const auto& coneAngleToken = UsdLuxTokens->inputsShapingConeAngle;
+    const auto& coneSoftnessToken = UsdLuxTokens->inputsShapingConeSoftness;
 #elif PXR_VERSION >= 2102
-    const auto hdAngle = sceneDelegate->GetLightParamValue(id, UsdLuxTokens->shapingConeAngle).GetWithDefault(180.0f);
-    const auto softness = sceneDelegate->GetLightParamValue(id, UsdLuxTokens->shapingConeSoftness).GetWithDefault(0.0f);
+    const auto& coneAngleToken = UsdLuxTokens->shapingConeAngle;
+    const auto& coneSoftnessToken = UsdLuxTokens->shapingConeSoftness;
 #else
-    const auto hdAngle = sceneDelegate->GetLightParamValue(id, _tokens->shapingConeAngle).GetWithDefault(180.0f);
-    const auto softness = sceneDelegate->GetLightParamValue(id, _tokens->shapingConeSoftness).GetWithDefault(0.0f);
+    const auto& coneAngleToken = _tokens->shapingConeAngle;
+    const auto& coneSoftnessToken = _tokens->shapingConeSoftness;
 #endif
-    const auto arnoldAngle = hdAngle * 2.0f;
-    const auto penumbra = arnoldAngle * softness;
-    AiNodeSetFlt(light, str::cone_angle, arnoldAngle);
-    AiNodeSetFlt(light, str::penumbra_angle, penumbra);
+    if (paramCache.HasChanged({coneAngleToken, coneSoftnessToken})) {
+        const auto hdAngle = paramCache.Get(coneAngleToken).GetWithDefault(180.0f);
+        const auto softness = paramCache.Get(coneSoftnessToken).GetWithDefault(0.0f);
+        const auto arnoldAngle = hdAngle * 2.0f;
+        const auto penumbra = arnoldAngle * softness;
+        AiNodeSetFlt(light, str::cone_angle, arnoldAngle);
+        AiNodeSetFlt(light, str::penumbra_angle, penumbra);
+    }
     // Barndoor parameters are only exposed in houdini for now.
+    if (!paramCache.HasChanged({_tokens->barndoorbottom, _tokens->barndoorbottomedge, _tokens->barndoorleft,
+                                _tokens->barndoorleftedge, _tokens->barndoorright, _tokens->barndoorrightedge,
+                                _tokens->barndoortop, _tokens->barndoortopedge})) {
+        return;
+    }
     auto hasBarndoor = false;
     auto getBarndoor = [&](const TfToken& name) -> float {
-        const auto barndoor = AiClamp(sceneDelegate->GetLightParamValue(id, name).GetWithDefault(0.0f), 0.0f, 1.0f);
+        const auto barndoor = AiClamp(paramCache.Get(name).GetWithDefault(0.0f), 0.0f, 1.0f);
         if (barndoor > AI_EPSILON) {
             hasBarndoor = true;
         }
@@ -241,90 +363,101 @@ auto spotLightSync = [](AtNode* light, AtNode** filter, const AtNodeEntry* nentr
     const auto barndoorrightedge = getBarndoor(_tokens->barndoorrightedge);
     const auto barndoortop = getBarndoor(_tokens->barndoortop);
     const auto barndoortopedge = getBarndoor(_tokens->barndoortopedge);
-    auto createBarndoor = [&]() { *filter = AiNode(renderDelegate->GetUniverse(), str::barndoor); };
+    auto& filterRegistry = renderDelegate->GetLightFilterRegistry();
+    // Lights with the same barndoor settings share the same filter. The new filter is acquired before releasing the
+    // old one, so the filter is not recreated if the settings are the same.
+    auto* oldFilter = *filter;
     if (hasBarndoor) {
-        // We check if the filter is non-zero and if it's a barndoor
-        if (*filter == nullptr) {
-            createBarndoor();
-        } else if (!AiNodeIs(*filter, str::barndoor)) {
-            AiNodeDestroy(*filter);
-            createBarndoor();
-        }
         // The edge parameters behave differently in Arnold vs Houdini.
         // For bottom left/right and right top/bottom we have to invert the Houdini value.
-        AiNodeSetFlt(*filter, str::barndoor_bottom_left, 1.0f - barndoorbottom);
-        AiNodeSetFlt(*filter, str::barndoor_bottom_right, 1.0f - barndoorbottom);
-        AiNodeSetFlt(*filter, str::barndoor_bottom_edge, barndoorbottomedge);
-        AiNodeSetFlt(*filter, str::barndoor_left_top, barndoorleft);
-        AiNodeSetFlt(*filter, str::barndoor_left_bottom, barndoorleft);
-        AiNodeSetFlt(*filter, str::barndoor_left_edge, barndoorleftedge);
-        AiNodeSetFlt(*filter, str::barndoor_right_top, 1.0f - barndoorright);
-        AiNodeSetFlt(*filter, str::barndoor_right_bottom, 1.0f - barndoorright);
-        AiNodeSetFlt(*filter, str::barndoor_right_edge, barndoorrightedge);
-        AiNodeSetFlt(*filter, str::barndoor_top_left, barndoortop);
-        AiNodeSetFlt(*filter, str::barndoor_top_right, barndoortop);
-        AiNodeSetFlt(*filter, str::barndoor_top_edge, barndoortopedge);
+        *filter = filterRegistry.Acquire(
+            renderDelegate->GetUniverse(), str::barndoor,
+            {{str::barndoor_bottom_left, 1.0f - barndoorbottom},
+             {str::barndoor_bottom_right, 1.0f - barndoorbottom},
+             {str::barndoor_bottom_edge, barndoorbottomedge},
+             {str::barndoor_left_top, barndoorleft},
+             {str::barndoor_left_bottom, barndoorleft},
+             {str::barndoor_left_edge, barndoorleftedge},
+             {str::barndoor_right_top, 1.0f - barndoorright},
+             {str::barndoor_right_bottom, 1.0f - barndoorright},
+             {str::barndoor_right_edge, barndoorrightedge},
+             {str::barndoor_top_left, barndoortop},
+             {str::barndoor_top_right, barndoortop},
+             {str::barndoor_top_edge, barndoortopedge}});
         AiNodeSetPtr(light, str::filters, *filter);
     } else {
+        *filter = nullptr;
         // We disconnect the filter.
         AiNodeSetArray(light, str::filters, AiArray(0, 1, AI_TYPE_NODE));
     }
+    filterRegistry.Release(oldFilter);
 };
 
-auto pointLightSync = [](AtNode* light, AtNode** filter, const AtNodeEntry* nentry, const SdfPath& id,
-                         HdSceneDelegate* sceneDelegate, HdArnoldRenderDelegate* renderDelegate) {
+auto pointLightSync = [](AtNode* light, AtNode** filter, const AtNodeEntry* nentry, LightParamCache& paramCache,
+                         HdArnoldRenderDelegate* renderDelegate) {
     TF_UNUSED(filter);
 #if PXR_VERSION >= 2102
-    const auto treatAsPointValue = sceneDelegate->GetLightParamValue(id, UsdLuxTokens->treatAsPoint);
+    const auto& treatAsPointToken = UsdLuxTokens->treatAsPoint;
 #else
-    const auto treatAsPointValue = sceneDelegate->GetLightParamValue(id, _tokens->treatAsPoint);
+    const auto& treatAsPointToken = _tokens->treatAsPoint;
 #endif
+    const auto treatAsPointChanged = paramCache.HasChanged(treatAsPointToken);
+    const auto& treatAsPointValue = paramCache.Get(treatAsPointToken);
     if (treatAsPointValue.IsHolding<bool>() && treatAsPointValue.UncheckedGet<bool>()) {
-        AiNodeSetFlt(light, str::radius, 0.0f);
-        AiNodeSetBool(light, str::normalize, true);
+        // Normalize is also a generic parameter, so this is set again when any of the parameters changed.
+        if (paramCache.HasAnyChanged()) {
+            AiNodeSetFlt(light, str::radius, 0.0f);
+            AiNodeSetBool(light, str::normalize, true);
+        }
     } else {
-        iterateParams(light, nentry, id, sceneDelegate, pointParams);
+        // Radius and normalize have to be restored when the light is no longer treated as a point.
+        iterateParams(light, nentry, paramCache, pointParams, treatAsPointChanged);
+        if (treatAsPointChanged) {
+            iterateParams(light, nentry, paramCache, genericParams, true);
+        }
     }
 };
 
-auto photometricLightSync = [](AtNode* light, AtNode** filter, const AtNodeEntry* nentry, const SdfPath& id,
-                               HdSceneDelegate* sceneDelegate, HdArnoldRenderDelegate* renderDelegate) {
+auto photometricLightSync = [](AtNode* light, AtNode** filter, const AtNodeEntry* nentry,
+                               LightParamCache& paramCache, HdArnoldRenderDelegate* renderDelegate) {
     TF_UNUSED(filter);
-    iterateParams(light, nentry, id, sceneDelegate, photometricParams);
+    iterateParams(light, nentry, paramCache, photometricParams);
 };
 
 // Spot lights are sphere lights with shaping parameters
 
-auto distantLightSync = [](AtNode* light, AtNode** filter, const AtNodeEntry* nentry, const SdfPath& id,
-                           HdSceneDelegate* sceneDelegate, HdArnoldRenderDelegate* renderDelegate) {
+auto distantLightSync = [](AtNode* light, AtNode** filter, const AtNodeEntry* nentry, LightParamCache& paramCache,
+                           HdArnoldRenderDelegate* renderDelegate) {
     TF_UNUSED(filter);
-    iterateParams(light, nentry, id, sceneDelegate, distantParams);
+    iterateParams(light, nentry, paramCache, distantParams);
 };
 
-auto diskLightSync = [](AtNode* light, AtNode** filter, const AtNodeEntry* nentry, const SdfPath& id,
-                        HdSceneDelegate* sceneDelegate, HdArnoldRenderDelegate* renderDelegate) {
+auto diskLightSync = [](AtNode* light, AtNode** filter, const AtNodeEntry* nentry, LightParamCache& paramCache,
+                        HdArnoldRenderDelegate* renderDelegate) {
     TF_UNUSED(filter);
-    iterateParams(light, nentry, id, sceneDelegate, diskParams);
+    iterateParams(light, nentry, paramCache, diskParams);
 };
 
-auto rectLightSync = [](AtNode* light, AtNode** filter, const AtNodeEntry* nentry, const SdfPath& id,
-                        HdSceneDelegate* sceneDelegate, HdArnoldRenderDelegate* renderDelegate) {
+auto rectLightSync = [](AtNode* light, AtNode** filter, const AtNodeEntry* nentry, LightParamCache& paramCache,
+                        HdArnoldRenderDelegate* renderDelegate) {
     TF_UNUSED(filter);
-    float width = 1.0f;
-    float height = 1.0f;
 #if PXR_VERSION >= 2102
-    const auto& widthValue = sceneDelegate->GetLightParamValue(id, UsdLuxTokens->inputsWidth);
+    const auto& widthToken = UsdLuxTokens->inputsWidth;
+    const auto& heightToken = UsdLuxTokens->inputsHeight;
 #else
-    const auto& widthValue = sceneDelegate->GetLightParamValue(id, HdLightTokens->width);
+    const auto& widthToken = HdLightTokens->width;
+    const auto& heightToken = HdLightTokens->height;
 #endif
+    if (!paramCache.HasChanged({widthToken, heightToken})) {
+        return;
+    }
+    float width = 1.0f;
+    float height = 1.0f;
+    const auto& widthValue = paramCache.Get(widthToken);
     if (widthValue.IsHolding<float>()) {
         width = widthValue.UncheckedGet<float>();
     }
-#if PXR_VERSION >= 2102
-    const auto& heightValue = sceneDelegate->GetLightParamValue(id, UsdLuxTokens->inputsHeight);
-#else
-    const auto& heightValue = sceneDelegate->GetLightParamValue(id, HdLightTokens->height);
-#endif
+    const auto& heightValue = paramCache.Get(heightToken);
     if (heightValue.IsHolding<float>()) {
         height = heightValue.UncheckedGet<float>();
     }
@@ -339,16 +472,20 @@ auto rectLightSync = [](AtNode* light, AtNode** filter, const AtNodeEntry* nentr
             AtVector(width, -height, 0.0f), AtVector(-width, -height, 0.0f)));
 };
 
-auto cylinderLightSync = [](AtNode* light, AtNode** filter, const AtNodeEntry* nentry, const SdfPath& id,
-                            HdSceneDelegate* sceneDelegate, HdArnoldRenderDelegate* renderDelegate) {
+auto cylinderLightSync = [](AtNode* light, AtNode** filter, const AtNodeEntry* nentry, LightParamCache& paramCache,
+                            HdArnoldRenderDelegate* renderDelegate) {
     TF_UNUSED(filter);
-    iterateParams(light, nentry, id, sceneDelegate, cylinderParams);
-    float length = 1.0f;
+    iterateParams(light, nentry, paramCache, cylinderParams);
 #if PXR_VERSION >= 2102
-    const auto& lengthValue = sceneDelegate->GetLightParamValue(id, UsdLuxTokens->inputsLength);
+    const auto& lengthToken = UsdLuxTokens->inputsLength;
 #else
-    const auto& lengthValue = sceneDelegate->GetLightParamValue(id, UsdLuxTokens->length);
+    const auto& lengthToken = UsdLuxTokens->length;
 #endif
+    if (!paramCache.HasChanged(lengthToken)) {
+        return;
+    }
+    float length = 1.0f;
+    const auto& lengthValue = paramCache.Get(lengthToken);
     if (lengthValue.IsHolding<float>()) {
         length = lengthValue.UncheckedGet<float>();
     }
@@ -357,14 +494,18 @@ auto cylinderLightSync = [](AtNode* light, AtNode** filter, const AtNodeEntry* n
     AiNodeSetVec(light, str::top, length, 0.0f, 0.0f);
 };
 
-auto domeLightSync = [](AtNode* light, AtNode** filter, const AtNodeEntry* nentry, const SdfPath& id,
-                        HdSceneDelegate* sceneDelegate, HdArnoldRenderDelegate* renderDelegate) {
+auto domeLightSync = [](AtNode* light, AtNode** filter, const AtNodeEntry* nentry, LightParamCache& paramCache,
+                        HdArnoldRenderDelegate* renderDelegate) {
     TF_UNUSED(filter);
 #if PXR_VERSION >= 2102
-    const auto& formatValue = sceneDelegate->GetLightParamValue(id, UsdLuxTokens->inputsTextureFormat);
+    const auto& formatToken = UsdLuxTokens->inputsTextureFormat;
 #else
-    const auto& formatValue = sceneDelegate->GetLightParamValue(id, UsdLuxTokens->textureFormat);
+    const auto& formatToken = UsdLuxTokens->textureFormat;
 #endif
+    if (!paramCache.HasChanged(formatToken)) {
+        return;
+    }
+    const auto& formatValue = paramCache.Get(formatToken);
     if (formatValue.IsHolding<TfToken>()) {
         const auto& textureFormat = formatValue.UncheckedGet<TfToken>();
         if (textureFormat == UsdLuxTokens->latlong) {
@@ -374,14 +515,16 @@ auto domeLightSync = [](AtNode* light, AtNode** filter, const AtNodeEntry* nentr
         } else {
             AiNodeSetStr(light, str::format, str::angular); // default value
         }
+    } else {
+        AiNodeResetParameter(light, str::format);
     }
 };
 
 /// Utility class to translate Hydra lights for th Render Delegate.
 class HdArnoldGenericLight : public HdLight {
 public:
-    using SyncParams = void (*)(
-        AtNode*, AtNode** filter, const AtNodeEntry*, const SdfPath&, HdSceneDelegate*, HdArnoldRenderDelegate*);
+    using SyncParams =
+        void (*)(AtNode*, AtNode** filter, const AtNodeEntry*, LightParamCache&, HdArnoldRenderDelegate*);
 
     /// Internal constructor for creating HdArnoldGenericLight.
     ///
@@ -423,14 +566,18 @@ public:
     AtNode* GetLightNode() const;
 
 private:
-    SyncParams _syncParams;            ///< Function object to sync light parameters.
-    HdArnoldRenderDelegate* _delegate; ///< Pointer to the Render Delegate.
-    AtNode* _light;                    ///< Pointer to the Arnold Light.
-    AtNode* _texture = nullptr;        ///< Pointer to the Arnold Texture Shader.
-    AtNode* _filter = nullptr;         ///< Pointer to the Arnold Light filter for barndoor effects.
-    TfToken _lightLink;                ///< Light Link collection the light belongs to.
-    TfToken _shadowLink;               ///< Shadow Link collection the light belongs to.
-    bool _supportsTexture = false;     ///< Value indicating texture support.
+    SyncParams _syncParams;             ///< Function object to sync light parameters.
+    HdArnoldRenderDelegate* _delegate;  ///< Pointer to the Render Delegate.
+    AtNode* _light;                     ///< Pointer to the Arnold Light.
+    AtNode* _texture = nullptr;         ///< Pointer to the Arnold Texture Shader.
+    AtNode* _filter = nullptr;          ///< Pointer to the Arnold Light filter for barndoor effects.
+    LightParamCache _paramCache;        ///< Light parameters from the previous sync.
+    std::vector<AtNode*> _lightFilters; ///< Light filters currently set on the light.
+    TfTokenVector _primvarNames;        ///< Names of the primvars set on the light.
+    TfToken _lightLink;                 ///< Light Link collection the light belongs to.
+    TfToken _shadowLink;                ///< Shadow Link collection the light belongs to.
+    bool _supportsTexture = false;      ///< Value indicating texture support.
+    bool _needsReset = true;            ///< If all the parameters of the light have to be set again.
 };
 
 HdArnoldGenericLight::HdArnoldGenericLight(
@@ -463,14 +610,14 @@ HdArnoldGenericLight::~HdArnoldGenericLight()
     if (_texture != nullptr) {
         AiNodeDestroy(_texture);
     }
-    if (_filter != nullptr) {
-        AiNodeDestroy(_filter);
-    }
+    _delegate->GetLightFilterRegistry().Release(_filter);
 }
 
 void HdArnoldGenericLight::Sync(HdSceneDelegate* sceneDelegate, HdRenderParam* renderParam, HdDirtyBits* dirtyBits)
 {
-    auto* param = reinterpret_cast<HdArnoldRenderParam*>(renderParam);
+    TRACE_FUNCTION();
+    HdArnoldRenderStatsScope statsScope(renderParam, HdArnoldRenderStats::PrimType::Light);
+    HdArnoldRenderParamInterrupt param(renderParam);
     TF_UNUSED(sceneDelegate);
     TF_UNUSED(dirtyBits);
     const auto& id = GetId();
@@ -479,12 +626,11 @@ void HdArnoldGenericLight::Sync(HdSceneDelegate* sceneDelegate, HdRenderParam* r
         // sphere light.
         const auto* nentry = AiNodeGetNodeEntry(_light);
         const auto lightType = AiNodeEntryGetNameAtString(nentry);
-        auto interrupted = false;
         if (lightType == str::spot_light || lightType == str::point_light || lightType == str::photometric_light) {
             const auto newLightType = getLightType(sceneDelegate, id);
             if (newLightType != lightType) {
-                param->Interrupt();
-                interrupted = true;
+                param.Interrupt();
+                _needsReset = true;
                 const AtString oldName{AiNodeGetName(_light)};
                 AiNodeDestroy(_light);
                 _light = AiNode(_delegate->GetUniverse(), newLightType);
@@ -497,8 +643,11 @@ void HdArnoldGenericLight::Sync(HdSceneDelegate* sceneDelegate, HdRenderParam* r
                 } else {
                     _syncParams = photometricLightSync;
                 }
+                // The barndoor filter is only used by spot lights.
+                _delegate->GetLightFilterRegistry().Release(_filter);
+                _filter = nullptr;
                 if (_lightLink != _tokens->emptyLink) {
-                    _delegate->DeregisterLightLinking(_shadowLink, this, false);
+                    _delegate->DeregisterLightLinking(_lightLink, this, false);
                     _lightLink = _tokens->emptyLink;
                 }
                 if (_shadowLink != _tokens->emptyLink) {
@@ -507,40 +656,71 @@ void HdArnoldGenericLight::Sync(HdSceneDelegate* sceneDelegate, HdRenderParam* r
                 }
             }
         }
-        // We need to force dirtying the transform, because AiNodeReset resets the transformation.
-        *dirtyBits |= HdLight::DirtyTransform;
-        if (!interrupted) {
-            param->Interrupt();
-        }
 
-        AiNodeReset(_light);
-        iterateParams(_light, nentry, id, sceneDelegate, genericParams);
-        _syncParams(_light, &_filter, nentry, id, sceneDelegate, _delegate);
-        if (_supportsTexture) {
-#if PXR_VERSION >= 2102
-            SetupTexture(sceneDelegate->GetLightParamValue(id, UsdLuxTokens->inputsTextureFile));
-#else
-            SetupTexture(sceneDelegate->GetLightParamValue(id, HdLightTokens->textureFile));
-#endif
-        }
+        _paramCache.BeginSync(sceneDelegate, id, &param);
         // Primvars are not officially supported on lights, but pre-20.11 the query functions checked for primvars
         // on all primitives uniformly. We have to pass the full name of the primvar post-20.11 to make this bit still
         // work.
-        for (const auto& primvar : sceneDelegate->GetPrimvarDescriptors(id, HdInterpolation::HdInterpolationConstant)) {
-            ConvertPrimvarToBuiltinParameter(
-                _light, primvar.name,
-                sceneDelegate->Get(
-                    id,
+        const auto primvars = sceneDelegate->GetPrimvarDescriptors(id, HdInterpolation::HdInterpolationConstant);
+        TfTokenVector primvarNames;
+        primvarNames.reserve(primvars.size());
+        for (const auto& primvar : primvars) {
 #if PXR_VERSION >= 2011
-                    TfToken { TfStringPrintf("primvars:%s", primvar.name.GetText()) }
+            primvarNames.emplace_back(TfStringPrintf("primvars:%s", primvar.name.GetText()));
+#else
+            primvarNames.push_back(primvar.name);
+#endif
+        }
+        // Removed primvars and light filters can't be reset one by one, so all the parameters are set again.
+        for (const auto& primvarName : _primvarNames) {
+            if (std::find(primvarNames.begin(), primvarNames.end(), primvarName) == primvarNames.end()) {
+                _needsReset = true;
+                break;
+            }
+        }
+        if (!_lightFilters.empty() && !_paramCache.Get(_tokens->filters).IsHolding<SdfPathVector>()) {
+            _needsReset = true;
+        }
+        if (_needsReset) {
+            param.Interrupt();
+            AiNodeReset(_light);
+            _paramCache.Clear();
+            _lightFilters.clear();
+            // We need to force dirtying the transform, because AiNodeReset resets the transformation.
+            *dirtyBits |= HdLight::DirtyTransform;
+            _needsReset = false;
+        }
+
+        // The light filters are queried before changing any parameters, so we can check if the filters were
+        // overwritten by the barndoor filter.
+        auto* filtersArray = AiNodeGetArray(_light, str::filters);
+        iterateParams(_light, nentry, _paramCache, genericParams);
+        _syncParams(_light, &_filter, nentry, _paramCache, _delegate);
+        if (_supportsTexture) {
+#if PXR_VERSION >= 2102
+            const auto& textureFileToken = UsdLuxTokens->inputsTextureFile;
 #else
-                    primvar.name
+            const auto& textureFileToken = HdLightTokens->textureFile;
 #endif
-                    ));
+            if (_paramCache.HasChanged(textureFileToken)) {
+                SetupTexture(_paramCache.Get(textureFileToken));
+            }
         }
-        const auto filtersValue = sceneDelegate->GetLightParamValue(id, _tokens->filters);
-        if (filtersValue.IsHolding<SdfPathVector>()) {
-            const auto& filterPaths = filtersValue.UncheckedGet<SdfPathVector>();
+        auto primvarsChanged = false;
+        for (const auto& primvarName : primvarNames) {
+            primvarsChanged |= _paramCache.HasPrimvarChanged(primvarName);
+        }
+        // Primvars override the light parameters, so all of them are set again when anything changed.
+        if (primvarsChanged || _paramCache.HasAnyChanged()) {
+            for (size_t i = 0; i < primvars.size(); i += 1) {
+                ConvertPrimvarToBuiltinParameter(_light, primvars[i].name, _paramCache.GetPrimvar(primvarNames[i]));
+            }
+        }
+        _primvarNames.swap(primvarNames);
+        // Filter materials can be recreated without changing the list of filters, so the filter nodes are looked up
+        // on every sync, but only set on the light when they changed.
+        if (_paramCache.Get(_tokens->filters).IsHolding<SdfPathVector>()) {
+            const auto& filterPaths = _paramCache.Get(_tokens->filters).UncheckedGet<SdfPathVector>();
             std::vector<AtNode*> filters;
             filters.reserve(filterPaths.size());
             for (const auto& filterPath : filterPaths) {
@@ -559,16 +739,21 @@ void HdArnoldGenericLight::Sync(HdSceneDelegate* sceneDelegate, HdRenderParam* r
                     filters.push_back(filter);
                 }
             }
-            if (filters.empty()) {
-                AiNodeSetArray(_light, str::filters, AiArray(0, 0, AI_TYPE_NODE));
-            } else {
-                AiNodeSetArray(_light, str::filters, AiArrayConvert(filters.size(), 1, AI_TYPE_NODE, filters.data()));
+            if (filters != _lightFilters || AiNodeGetArray(_light, str::filters) != filtersArray) {
+                param.Interrupt();
+                if (filters.empty()) {
+                    AiNodeSetArray(_light, str::filters, AiArray(0, 0, AI_TYPE_NODE));
+                } else {
+                    AiNodeSetArray(
+                        _light, str::filters, AiArrayConvert(filters.size(), 1, AI_TYPE_NODE, filters.data()));
+                }
+                _lightFilters.swap(filters);
             }
         }
     }
 
     if (*dirtyBits & HdLight::DirtyTransform) {
-        param->Interrupt();
+        param.Interrupt();
         HdArnoldSetTransform(_light, sceneDelegate, id);
     }
 
@@ -578,7 +763,7 @@ void HdArnoldGenericLight::Sync(HdSceneDelegate* sceneDelegate, HdRenderParam* r
         if (linkValue.IsHolding<TfToken>()) {
             const auto& link = linkValue.UncheckedGet<TfToken>();
             if (currentLink != link) {
-                param->Interrupt();
+                param.Interrupt();
                 // The empty link value only exists when creating the class, so link can never match emptyLink.
                 if (currentLink != _tokens->emptyLink) {
                     _delegate->DeregisterLightLinking(currentLink, this, isShadow);
@@ -626,6 +811,8 @@ void HdArnoldGenericLight::SetupTexture(const VtValue& value)
     }
     _texture = AiNode(_delegate->GetUniverse(), str::image);
     AiNodeSetStr(_texture, str::filename, AtString(path.c_str()));
+    // Environment maps are often large, so loading starts right away instead of when the first ray hits the light.
+    _delegate->GetTexturePrefetcher().Prefetch(path);
     if (hasShader) {
         AiNodeSetPtr(_light, str::shader, _texture);
     } else { // Connect to color if filename doesn't exists.
@@ -0,0 +1,92 @@
+// Copyright 2021 Autodesk, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "light_filter_registry.h"
+
+#include <pxr/base/tf/stringUtils.h>
+
+#include <constant_strings.h>
+
+#include <cstring>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+namespace {
+
+std::string _GetKey(const AtString& filterType, const HdArnoldLightFilterRegistry::FloatParams& params)
+{
+    // Values are stored with their exact bit patterns, so only identical filters are shared.
+    std::string key = filterType.c_str();
+    for (const auto& param : params) {
+        key += '\n';
+        key += param.first.c_str();
+        key += '=';
+        char value[sizeof(float)];
+        std::memcpy(value, &param.second, sizeof(float));
+        key.append(value, sizeof(float));
+    }
+    return key;
+}
+
+} // namespace
+
+AtNode* HdArnoldLightFilterRegistry::Acquire(
+    AtUniverse* universe, const AtString& filterType, const FloatParams& params)
+{
+    auto key = _GetKey(filterType, params);
+    std::lock_guard<std::mutex> guard(_mutex);
+    auto& entry = _filters[key];
+    if (entry.filter == nullptr) {
+        entry.filter = AiNode(universe, filterType);
+        AiNodeSetStr(
+            entry.filter, str::name,
+            AtString(TfStringPrintf("%s_shared_%p", filterType.c_str(), entry.filter).c_str()));
+        for (const auto& param : params) {
+            AiNodeSetFlt(entry.filter, param.first, param.second);
+        }
+        _keys.emplace(entry.filter, std::move(key));
+    }
+    entry.refCount += 1;
+    return entry.filter;
+}
+
+void HdArnoldLightFilterRegistry::Release(AtNode* filter)
+{
+    if (filter == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> guard(_mutex);
+    const auto keyIt = _keys.find(filter);
+    if (keyIt == _keys.end()) {
+        return;
+    }
+    const auto filterIt = _filters.find(keyIt->second);
+    if (filterIt == _filters.end()) {
+        _keys.erase(keyIt);
+        return;
+    }
+    filterIt->second.refCount -= 1;
+    if (filterIt->second.refCount == 0) {
+        AiNodeDestroy(filter);
+        _filters.erase(filterIt);
+        _keys.erase(keyIt);
+    }
+}
+
+size_t HdArnoldLightFilterRegistry::GetNumFilters() const
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    return _filters.size();
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
@@ -0,0 +1,88 @@
+// Copyright 2021 Autodesk, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+/// @file light_filter_registry.h
+///
+/// Registry for sharing Arnold light filters with identical parameters.
+#pragma once
+
+#include "api.h"
+
+#include <pxr/pxr.h>
+
+#include <ai.h>
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/// Utility class sharing Arnold light filters created by the Render Delegate between lights.
+///
+/// Lights using filters with the same type and parameter values, like the barndoor filters of spot lights, get the
+/// same filter node, so scenes with many lights only create a node for each unique filter. Filters are reference
+/// counted and destroyed when the last light using them releases them. The registry is thread safe, so it can be
+/// used from parallel syncs.
+class HdArnoldLightFilterRegistry {
+public:
+    /// Parameter values of a filter, stored as pairs of parameter names and values.
+    using FloatParams = std::vector<std::pair<AtString, float>>;
+
+    /// Constructor for HdArnoldLightFilterRegistry.
+    HdArnoldLightFilterRegistry() = default;
+
+    /// Destructor for HdArnoldLightFilterRegistry.
+    ///
+    /// Filters still in the registry are owned by the universe, so they are not destroyed here.
+    ~HdArnoldLightFilterRegistry() = default;
+
+    HdArnoldLightFilterRegistry(const HdArnoldLightFilterRegistry&) = delete;
+    HdArnoldLightFilterRegistry& operator=(const HdArnoldLightFilterRegistry&) = delete;
+
+    /// Returns a shared filter with the given parameters, and increments its reference count.
+    ///
+    /// @param universe Universe to create the filter in.
+    /// @param filterType Type of the Arnold light filter.
+    /// @param params Parameter values of the filter.
+    /// @return Pointer to the shared Arnold light filter.
+    HDARNOLD_API
+    AtNode* Acquire(AtUniverse* universe, const AtString& filterType, const FloatParams& params);
+
+    /// Decrements the reference count of a shared filter, and destroys it if it's not used anymore.
+    ///
+    /// @param filter Pointer to the shared Arnold light filter.
+    HDARNOLD_API
+    void Release(AtNode* filter);
+
+    /// Returns the number of shared filters.
+    ///
+    /// @return Number of shared filters.
+    HDARNOLD_API
+    size_t GetNumFilters() const;
+
+private:
+    /// A single shared filter.
+    struct Entry {
+        AtNode* filter = nullptr; ///< Pointer to the shared Arnold light filter.
+        size_t refCount = 0;      ///< Number of lights using the filter.
+    };
+
+    mutable std::mutex _mutex;                            ///< Mutex guarding the registry.
+    std::unordered_map<std::string, Entry> _filters;      ///< Shared filters by their key.
+    std::unordered_map<const AtNode*, std::string> _keys; ///< Keys of the shared filters.
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
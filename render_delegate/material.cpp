@@ -29,6 +29,7 @@
 
 #include <pxr/base/gf/rotation.h>
 #include <pxr/base/gf/vec2f.h>
+#include <pxr/base/trace/trace.h>
 #include <pxr/usdImaging/usdImaging/tokens.h>
 
 #include <constant_strings.h>
@@ -450,6 +451,8 @@ HdArnoldMaterial::~HdArnoldMaterial()
 
 void HdArnoldMaterial::Sync(HdSceneDelegate* sceneDelegate, HdRenderParam* renderParam, HdDirtyBits* dirtyBits)
 {
+    TRACE_FUNCTION();
+    HdArnoldRenderStatsScope statsScope(renderParam, HdArnoldRenderStats::PrimType::Material);
     const auto id = GetId();
     if ((*dirtyBits & HdMaterial::DirtyResource) && !id.IsEmpty()) {
         HdArnoldRenderParamInterrupt param(renderParam);
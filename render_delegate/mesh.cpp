@@ -28,6 +28,7 @@
 #include "mesh.h"
 
 #include <pxr/base/gf/vec2f.h>
+#include <pxr/base/trace/trace.h>
 #include <pxr/imaging/pxOsd/tokens.h>
 
 #include <mutex>
@@ -164,6 +165,8 @@ HdArnoldMesh::HdArnoldMesh(HdArnoldRenderDelegate* renderDelegate, const SdfPath
 void HdArnoldMesh::Sync(
     HdSceneDelegate* sceneDelegate, HdRenderParam* renderParam, HdDirtyBits* dirtyBits, const TfToken& reprToken)
 {
+    TRACE_FUNCTION();
+    HdArnoldRenderStatsScope statsScope(renderParam, HdArnoldRenderStats::PrimType::Mesh);
     TF_UNUSED(reprToken);
     HdArnoldRenderParamInterrupt param(renderParam);
     const auto& id = GetId();
@@ -13,6 +13,8 @@
 // limitations under the License.
 #include "native_rprim.h"
 
+#include <pxr/base/trace/trace.h>
+
 #include "material.h"
 
 #include <common_bits.h>
@@ -40,6 +42,8 @@ HdArnoldNativeRprim::HdArnoldNativeRprim(
 void HdArnoldNativeRprim::Sync(
     HdSceneDelegate* sceneDelegate, HdRenderParam* renderParam, HdDirtyBits* dirtyBits, const TfToken& reprToken)
 {
+    TRACE_FUNCTION();
+    HdArnoldRenderStatsScope statsScope(renderParam, HdArnoldRenderStats::PrimType::NativeRprim);
     TF_UNUSED(reprToken);
     HdArnoldRenderParamInterrupt param(renderParam);
     const auto& id = GetId();
@@ -27,11 +27,42 @@
 // limitations under the License.
 #include "openvdb_asset.h"
 
+#include <pxr/base/tf/staticTokens.h>
+#include <pxr/base/tf/stringUtils.h>
+#include <pxr/base/trace/trace.h>
+
 #include <pxr/imaging/hd/renderIndex.h>
 #include <pxr/imaging/hd/sceneDelegate.h>
 
+#include <pxr/usd/sdf/assetPath.h>
+
+#include "volume.h"
+
 PXR_NAMESPACE_OPEN_SCOPE
 
+// clang-format off
+TF_DEFINE_PRIVATE_TOKENS(_tokens,
+    (filePath)
+    (fieldName)
+);
+// clang-format on
+
+namespace {
+
+// Houdini in-memory volumes keep the same "op:" path when their grids are edited, and file paths
+// of other types can't be compared reliably, so volumes using them are updated on every change.
+bool _IsComparableFilePath(const VtValue& filePath)
+{
+    if (!filePath.IsHolding<SdfAssetPath>()) {
+        return false;
+    }
+    const auto& assetPath = filePath.UncheckedGet<SdfAssetPath>();
+    const auto& path = assetPath.GetResolvedPath().empty() ? assetPath.GetAssetPath() : assetPath.GetResolvedPath();
+    return !TfStringStartsWith(path, "op:");
+}
+
+} // namespace
+
 HdArnoldOpenvdbAsset::HdArnoldOpenvdbAsset(HdArnoldRenderDelegate* renderDelegate, const SdfPath& id) : HdField(id)
 {
     TF_UNUSED(renderDelegate);
@@ -39,13 +70,22 @@ HdArnoldOpenvdbAsset::HdArnoldOpenvdbAsset(HdArnoldRenderDelegate* renderDelegat
 
 void HdArnoldOpenvdbAsset::Sync(HdSceneDelegate* sceneDelegate, HdRenderParam* renderParam, HdDirtyBits* dirtyBits)
 {
-    TF_UNUSED(renderParam);
+    TRACE_FUNCTION();
+    HdArnoldRenderStatsScope statsScope(renderParam, HdArnoldRenderStats::PrimType::OpenvdbAsset);
     if (*dirtyBits & HdField::DirtyParams) {
-        auto& changeTracker = sceneDelegate->GetRenderIndex().GetChangeTracker();
-        // But accessing this list happens on a single thread,
-        // as bprims are synced before rprims.
-        for (const auto& volume : _volumeList) {
-            changeTracker.MarkRprimDirty(volume, HdChangeTracker::DirtyTopology);
+        // Only the file path and the grid name affect the volumes, other parameters are not used by Arnold.
+        const auto& id = GetId();
+        auto filePath = sceneDelegate->Get(id, _tokens->filePath);
+        auto fieldName = sceneDelegate->Get(id, _tokens->fieldName);
+        if (!_IsComparableFilePath(filePath) || filePath != _filePath || fieldName != _fieldName) {
+            _filePath = std::move(filePath);
+            _fieldName = std::move(fieldName);
+            auto& changeTracker = sceneDelegate->GetRenderIndex().GetChangeTracker();
+            // But accessing this list happens on a single thread,
+            // as bprims are synced before rprims.
+            for (const auto& volume : _volumeList) {
+                changeTracker.MarkRprimDirty(volume, HdArnoldVolume::DirtyFields);
+            }
         }
     }
     *dirtyBits = HdField::Clean;
@@ -36,6 +36,8 @@
 #include <pxr/pxr.h>
 #include "api.h"
 
+#include <pxr/base/vt/value.h>
+
 #include <pxr/imaging/hd/field.h>
 
 #include "render_delegate.h"
@@ -57,10 +59,13 @@ public:
 
     /// Syncing the Hydra Openvdb Asset to the Arnold Volume.
     ///
-    /// The functions main purpose is to dirty every Volume primitive's
-    /// topology, so the grid definitions on the volume can be rebuilt, since
+    /// The functions main purpose is to dirty the fields of every Volume
+    /// primitive, so the grid definitions on the volume can be updated, since
     /// changing the the grid name on the openvdb asset doesn't dirty the
-    /// volume primitive, which holds the arnold volume shape.
+    /// volume primitive, which holds the arnold volume shape. Volumes are
+    /// only dirtied if the file path or the grid name changed, or if the
+    /// file path is a Houdini in-memory volume, whose grids can change
+    /// without changing its path.
     ///
     /// @param sceneDelegate Pointer to the Hydra Scene Delegate.
     /// @param renderParam Pointer to a HdArnoldRenderParam instance.
@@ -85,6 +90,8 @@ public:
     void TrackVolumePrimitive(const SdfPath& id);
 
 private:
+    VtValue _filePath;           ///< File path of the asset at the last sync.
+    VtValue _fieldName;          ///< Grid name of the asset at the last sync.
     std::mutex _volumeListMutex; ///< Lock for the _volumeList.
     /// Storing all the Hydra Volumes using this asset.
     std::unordered_set<SdfPath, SdfPath::Hash> _volumeList;
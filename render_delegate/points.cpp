@@ -13,6 +13,8 @@
 // limitations under the License.
 #include "points.h"
 
+#include <pxr/base/trace/trace.h>
+
 #include <constant_strings.h>
 #include "material.h"
 #include "utils.h"
@@ -41,6 +43,8 @@ HdDirtyBits HdArnoldPoints::GetInitialDirtyBitsMask() const
 void HdArnoldPoints::Sync(
     HdSceneDelegate* sceneDelegate, HdRenderParam* renderParam, HdDirtyBits* dirtyBits, const TfToken& reprToken)
 {
+    TRACE_FUNCTION();
+    HdArnoldRenderStatsScope statsScope(renderParam, HdArnoldRenderStats::PrimType::Points);
     HdArnoldRenderParamInterrupt param(renderParam);
     const auto& id = GetId();
     if (HdChangeTracker::IsPrimvarDirty(*dirtyBits, id, HdTokens->points)) {
@@ -116,6 +116,8 @@ public:
         AtNode* filter = nullptr;               ///< Arnold filter.
         AtNode* writer = nullptr;               ///< Arnold AOV write node for primvar AOVs.
         AtNode* reader = nullptr;               ///< Arnold user data reader for primvar AOVs.
+        AtString output;                        ///< Output definition for the options node.
+        AtString lightPathExpression;           ///< Optional light path expression for LPE AOVs.
 
         /// Default constructor.
         BufferDefinition() = default;
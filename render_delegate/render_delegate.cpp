@@ -28,6 +28,8 @@
 #include "render_delegate.h"
 
 #include <pxr/base/tf/getenv.h>
+#include <pxr/base/trace/collector.h>
+#include <pxr/base/trace/reporter.h>
 
 #include <pxr/imaging/hd/bprim.h>
 #include <pxr/imaging/hd/camera.h>
@@ -56,6 +58,10 @@
 #include "render_pass.h"
 #include "volume.h"
 
+#include <algorithm>
+#include <fstream>
+#include <unordered_map>
+
 PXR_NAMESPACE_OPEN_SCOPE
 
 // clang-format off
@@ -64,6 +70,8 @@ TF_DEFINE_PRIVATE_TOKENS(_tokens,
     (openvdbAsset)
     ((arnoldGlobal, "arnold:global:"))
     (percentDone)
+    (texturePrefetchProgress)
+    (nodeCount)
     (delegateRenderProducts)
     (orderedVars)
     ((aovSettings, "aovDescriptor.aovSettings"))
@@ -202,6 +210,8 @@ const SupportedRenderSettings& _GetSupportedRenderSettings()
         {str::t_interactive_target_fps_min,
          {"Minimum Target FPS for Interactive Rendering", config.interactive_target_fps_min}},
         {str::t_interactive_fps_min, {"Minimum FPS for Interactive Rendering", config.interactive_fps_min}},
+        {str::t_enable_adaptive_frame_rate,
+         {"Enable Adaptive Frame Rate for Interactive Rendering", config.enable_adaptive_frame_rate}},
         // Threading settings
         {str::t_threads, {"Number of Threads", config.threads}},
         // Sampling settings
@@ -248,6 +258,17 @@ const SupportedRenderSettings& _GetSupportedRenderSettings()
     return data;
 }
 
+using FrameRateSettings = HdArnoldFrameRateScheduler::Settings;
+
+template <typename F>
+void _UpdateFrameRateSettings(HdArnoldRenderParam* renderParam, F&& f)
+{
+    auto& scheduler = renderParam->GetFrameRateScheduler();
+    auto settings = scheduler.GetSettings();
+    f(settings);
+    scheduler.SetSettings(settings);
+}
+
 int _GetLogFlagsFromVerbosity(int verbosity)
 {
     if (verbosity <= 0) {
@@ -388,9 +409,23 @@ HdArnoldRenderDelegate::HdArnoldRenderDelegate(HdArnoldRenderContext context) :
     }
     hdArnoldInstallNodes();
 
+    // Trace events are cheap to emit, but only collected when a trace file is requested.
+    if (!config.trace_file.empty()) {
+        TraceCollector::GetInstance().SetEnabled(true);
+    }
+
     _universe = nullptr;
 
     _options = AiUniverseGetOptions(_universe);
+    // The render param has to exist before applying the render settings, as some of them configure the frame rate
+    // scheduler.
+    _renderParam.reset(new HdArnoldRenderParam());
+    _UpdateFrameRateSettings(_renderParam.get(), [&](FrameRateSettings& settings) {
+        // The scheduler only runs for interactive rendering.
+        settings.enabled = _context != HdArnoldRenderContext::Husk;
+        settings.bucketSize = AiNodeGetInt(_options, str::bucket_size);
+    });
+    _texturePrefetcher.SetEnabled(config.prefetch_light_textures);
     for (const auto& o : _GetSupportedRenderSettings()) {
         _SetRenderSetting(o.first, o.second.defaultValue);
     }
@@ -411,8 +446,6 @@ HdArnoldRenderDelegate::HdArnoldRenderDelegate(HdArnoldRenderContext context) :
     AiNodeSetStr(
         _fallbackVolumeShader, str::name, AtString(TfStringPrintf("fallbackVolume_%p", _fallbackVolumeShader).c_str()));
 
-    _renderParam.reset(new HdArnoldRenderParam());
-
     // We need access to both beauty and P at the same time.
     if (_context == HdArnoldRenderContext::Husk) {
         AiRenderSetHintBool(str::progressive, false);
@@ -429,9 +462,21 @@ HdArnoldRenderDelegate::~HdArnoldRenderDelegate()
         _resourceRegistry.reset();
     }
     _renderParam->Interrupt();
+    // The prefetcher uses the texture system, so it has to stop before shutting down Arnold.
+    _texturePrefetcher.Cancel();
     hdArnoldUninstallNodes();
     AiUniverseDestroy(_universe);
     AiEnd();
+    const auto& traceFile = HdArnoldConfig::GetInstance().trace_file;
+    if (!traceFile.empty()) {
+        TraceCollector::GetInstance().SetEnabled(false);
+        std::ofstream traceStream(traceFile);
+        if (traceStream.is_open()) {
+            TraceReporter::GetGlobalReporter()->ReportChromeTracing(traceStream);
+        } else {
+            TF_WARN("Unable to open trace file %s", traceFile.c_str());
+        }
+    }
 }
 
 HdRenderParam* HdArnoldRenderDelegate::GetRenderParam() const { return _renderParam.get(); }
@@ -484,18 +529,31 @@ void HdArnoldRenderDelegate::_SetRenderSetting(const TfToken& _key, const VtValu
         }
     } else if (key == str::t_progressive_min_AA_samples) {
         if (_context != HdArnoldRenderContext::Husk) {
-            _CheckForIntValue(value, [&](const int i) { AiRenderSetHintInt(str::progressive_min_AA_samples, i); });
+            _CheckForIntValue(value, [&](const int i) {
+                AiRenderSetHintInt(str::progressive_min_AA_samples, i);
+                _UpdateFrameRateSettings(_renderParam.get(), [&](FrameRateSettings& settings) {
+                    settings.progressiveMinAASamples = i;
+                });
+            });
         }
     } else if (key == str::t_interactive_target_fps) {
         if (_context != HdArnoldRenderContext::Husk) {
             if (value.IsHolding<float>()) {
-                AiRenderSetHintFlt(str::interactive_target_fps, value.UncheckedGet<float>());
+                const auto fps = value.UncheckedGet<float>();
+                AiRenderSetHintFlt(str::interactive_target_fps, fps);
+                _UpdateFrameRateSettings(_renderParam.get(), [&](FrameRateSettings& settings) {
+                    settings.targetFps = fps;
+                });
             }
         }
     } else if (key == str::t_interactive_target_fps_min) {
         if (_context != HdArnoldRenderContext::Husk) {
             if (value.IsHolding<float>()) {
-                AiRenderSetHintFlt(str::interactive_target_fps_min, value.UncheckedGet<float>());
+                const auto fps = value.UncheckedGet<float>();
+                AiRenderSetHintFlt(str::interactive_target_fps_min, fps);
+                _UpdateFrameRateSettings(_renderParam.get(), [&](FrameRateSettings& settings) {
+                    settings.targetFpsMin = fps;
+                });
             }
         }
     } else if (key == str::t_interactive_fps_min) {
@@ -504,6 +562,20 @@ void HdArnoldRenderDelegate::_SetRenderSetting(const TfToken& _key, const VtValu
                 AiRenderSetHintFlt(str::interactive_fps_min, value.UncheckedGet<float>());
             }
         }
+    } else if (key == str::t_enable_adaptive_frame_rate) {
+        if (_context != HdArnoldRenderContext::Husk) {
+            _CheckForBoolValue(value, [&](const bool b) {
+                _UpdateFrameRateSettings(_renderParam.get(), [&](FrameRateSettings& settings) {
+                    settings.enabled = b;
+                });
+            });
+        }
+    } else if (key == str::t_bucket_size) {
+        _CheckForIntValue(value, [&](const int i) {
+            AiNodeSetInt(_options, str::bucket_size, i);
+            // The scheduler overwrites the bucket size while interacting, and restores this value when idle.
+            _UpdateFrameRateSettings(_renderParam.get(), [&](FrameRateSettings& settings) { settings.bucketSize = i; });
+        });
     } else if (key == str::t_profile_file) {
         if (value.IsHolding<std::string>()) {
             AiProfileSetFileName(value.UncheckedGet<std::string>().c_str());
@@ -633,9 +705,12 @@ VtValue HdArnoldRenderDelegate::GetRenderSetting(const TfToken& _key) const
         AiRenderGetHintBool(str::progressive, v);
         return VtValue(v);
     } else if (key == str::t_progressive_min_AA_samples) {
-        int v = -4;
-        AiRenderGetHintInt(str::progressive_min_AA_samples, v);
-        return VtValue(v);
+        // The frame rate scheduler changes the hint while interacting, so we return the value set by the user.
+        return VtValue(_renderParam->GetFrameRateScheduler().GetSettings().progressiveMinAASamples);
+    } else if (key == str::t_bucket_size) {
+        return VtValue(_renderParam->GetFrameRateScheduler().GetSettings().bucketSize);
+    } else if (key == str::t_enable_adaptive_frame_rate) {
+        return VtValue(_renderParam->GetFrameRateScheduler().GetSettings().enabled);
     } else if (key == str::t_log_verbosity) {
         return VtValue(_GetLogVerbosityFromFlags(_verbosityLogFlags));
     } else if (key == str::t_log_file) {
@@ -688,6 +763,31 @@ VtDictionary HdArnoldRenderDelegate::GetRenderStats() const
     float total_progress = 100.0f;
     AiRenderGetHintFlt(str::total_progress, total_progress);
     stats[_tokens->percentDone] = total_progress;
+    stats[_tokens->texturePrefetchProgress] = _texturePrefetcher.GetProgress() * 100.0f;
+
+    auto& renderStats = _renderParam->GetStats();
+    renderStats.SetMemory(static_cast<uint64_t>(AiMsgUtilGetUsedMemory()));
+    renderStats.Fill(stats);
+
+    // Iterating over all the nodes in the universe is not cheap, so we only count them again when rendering was
+    // restarted, which happens after every change to the scene.
+    std::lock_guard<std::mutex> guard(_nodeCountsMutex);
+    const auto restarts = renderStats.GetRestarts();
+    if (restarts != _nodeCountsRestarts) {
+        _nodeCountsRestarts = restarts;
+        std::unordered_map<AtString, uint64_t, AtStringHash> nodeCounts;
+        auto* nodeIter = AiUniverseGetNodeIterator(_universe, AI_NODE_ALL);
+        while (!AiNodeIteratorFinished(nodeIter)) {
+            const auto* node = AiNodeIteratorGetNext(nodeIter);
+            nodeCounts[AiNodeEntryGetNameAtString(AiNodeGetNodeEntry(node))] += 1;
+        }
+        AiNodeIteratorDestroy(nodeIter);
+        _nodeCounts.clear();
+        for (const auto& nodeCount : nodeCounts) {
+            _nodeCounts[nodeCount.first.c_str()] = nodeCount.second;
+        }
+    }
+    stats[_tokens->nodeCount] = _nodeCounts;
     return stats;
 }
 
@@ -933,6 +1033,8 @@ HdAovDescriptor HdArnoldRenderDelegate::GetDefaultAovDescriptor(const TfToken& n
 void HdArnoldRenderDelegate::RegisterLightLinking(const TfToken& name, HdLight* light, bool isShadow)
 {
     std::lock_guard<std::mutex> guard(_lightLinkingMutex);
+    // Light nodes can be recreated when a light changes type, which always registers the light again.
+    _lightGroups.clear();
     auto& links = isShadow ? _shadowLinks : _lightLinks;
     auto it = links.find(name);
     if (it == links.end()) {
@@ -955,6 +1057,7 @@ void HdArnoldRenderDelegate::RegisterLightLinking(const TfToken& name, HdLight*
 void HdArnoldRenderDelegate::DeregisterLightLinking(const TfToken& name, HdLight* light, bool isShadow)
 {
     std::lock_guard<std::mutex> guard(_lightLinkingMutex);
+    _lightGroups.clear();
     auto& links = isShadow ? _shadowLinks : _lightLinks;
     auto it = links.find(name);
     if (it != links.end()) {
@@ -988,29 +1091,42 @@ void HdArnoldRenderDelegate::ApplyLightLinking(AtNode* shape, const VtArray<TfTo
     if (lightEmpty && shadowEmpty) {
         return;
     }
-    auto applyGroups = [&](const AtString& group, const AtString& useGroup, const LightLinkingMap& links) {
-        std::vector<AtNode*> lights;
-        for (const auto& category : categories) {
-            auto it = links.find(category);
-            if (it != links.end()) {
-                for (auto* light : it->second) {
-                    auto* arnoldLight = HdArnoldLight::GetLightNode(light);
-                    if (arnoldLight != nullptr) {
-                        lights.push_back(arnoldLight);
-                    }
-                }
-            }
+    // Shapes with the same light links in their categories are affected by the same lights, so the groups are only
+    // built once for each unique set of light links, instead of for every shape.
+    std::vector<TfToken> linkSet;
+    for (const auto& category : categories) {
+        if (_lightLinks.count(category) != 0 || _shadowLinks.count(category) != 0) {
+            linkSet.push_back(category);
         }
-        // Add the lights with an empty collection to the list.
-        auto it = links.find(TfToken{});
-        if (it != links.end()) {
-            for (auto* light : it->second) {
-                auto* arnoldLight = HdArnoldLight::GetLightNode(light);
-                if (arnoldLight != nullptr) {
-                    lights.push_back(arnoldLight);
+    }
+    std::sort(linkSet.begin(), linkSet.end());
+    linkSet.erase(std::unique(linkSet.begin(), linkSet.end()), linkSet.end());
+    auto groupsIt = _lightGroups.find(linkSet);
+    if (groupsIt == _lightGroups.end()) {
+        auto collectLights = [&](const LightLinkingMap& links, std::vector<AtNode*>& lights) {
+            auto addLights = [&](const TfToken& link) {
+                auto it = links.find(link);
+                if (it != links.end()) {
+                    for (auto* light : it->second) {
+                        auto* arnoldLight = HdArnoldLight::GetLightNode(light);
+                        if (arnoldLight != nullptr) {
+                            lights.push_back(arnoldLight);
+                        }
+                    }
                 }
+            };
+            for (const auto& link : linkSet) {
+                addLights(link);
             }
-        }
+            // Add the lights with an empty collection to the list.
+            addLights(TfToken{});
+        };
+        LightGroups groups;
+        collectLights(_lightLinks, groups.lights);
+        collectLights(_shadowLinks, groups.shadows);
+        groupsIt = _lightGroups.emplace(std::move(linkSet), std::move(groups)).first;
+    }
+    auto applyGroups = [&](const AtString& group, const AtString& useGroup, const std::vector<AtNode*>& lights) {
         // If lights is empty, then no lights affect the shape, and we still have to set useGroup to true.
         if (lights.empty()) {
             AiNodeResetParameter(shape, group);
@@ -1021,10 +1137,10 @@ void HdArnoldRenderDelegate::ApplyLightLinking(AtNode* shape, const VtArray<TfTo
         AiNodeSetBool(shape, useGroup, true);
     };
     if (!lightEmpty) {
-        applyGroups(str::light_group, str::use_light_group, _lightLinks);
+        applyGroups(str::light_group, str::use_light_group, groupsIt->second.lights);
     }
     if (!shadowEmpty) {
-        applyGroups(str::shadow_group, str::use_shadow_group, _shadowLinks);
+        applyGroups(str::shadow_group, str::use_shadow_group, groupsIt->second.shadows);
     }
 }
 
@@ -44,9 +44,15 @@
 
 #include "hdarnold.h"
 #include "render_param.h"
+#include "light_filter_registry.h"
+#include "texture_prefetcher.h"
+#include "volume_registry.h"
 
 #include <ai.h>
 
+#include <map>
+#include <vector>
+
 PXR_NAMESPACE_OPEN_SCOPE
 
 struct HdArnoldRenderVar {
@@ -140,6 +146,16 @@ public:
     HdRenderSettingDescriptorList GetRenderSettingDescriptors() const override;
     /// Returns an open-format dictionary of render statistics
     ///
+    /// The dictionary contains the following keys:
+    /// - percentDone (float): Progress of the current render.
+    /// - totalMemory, peakMemory (uint64_t): Current and peak memory used by Arnold in bytes.
+    /// - restarts (uint64_t): Number of times rendering was started or restarted.
+    /// - iterations (uint64_t): Number of render pass iterations.
+    /// - iterationTime, lastIterationTime (double): Average and last render pass iteration time in seconds.
+    /// - syncTime (VtDictionary): Total time spent syncing each primitive type in seconds.
+    /// - syncCount (VtDictionary): Number of syncs for each primitive type.
+    /// - nodeCount (VtDictionary): Number of Arnold nodes for each node type.
+    ///
     /// @return VtDictionary holding the render stats.
     HDARNOLD_API
     VtDictionary GetRenderStats() const override;
@@ -294,6 +310,18 @@ public:
     /// @return Pointer to the fallback Arnold Volume Shader.
     HDARNOLD_API
     AtNode* GetFallbackVolumeShader() const;
+    /// Gets the registry of volumes shared between Hydra Volumes.
+    ///
+    /// @return Reference to the volume registry.
+    HdArnoldVolumeRegistry& GetVolumeRegistry() { return _volumeRegistry; }
+    /// Gets the registry of light filters shared between lights.
+    ///
+    /// @return Reference to the light filter registry.
+    HdArnoldLightFilterRegistry& GetLightFilterRegistry() { return _lightFilterRegistry; }
+    /// Gets the prefetcher loading light textures in the background.
+    ///
+    /// @return Reference to the texture prefetcher.
+    HdArnoldTexturePrefetcher& GetTexturePrefetcher() { return _texturePrefetcher; }
     /// Gets the default settings for supported aovs.
     HDARNOLD_API
     HdAovDescriptor GetDefaultAovDescriptor(const TfToken& name) const override;
@@ -414,6 +442,12 @@ private:
     static HdResourceRegistrySharedPtr _resourceRegistry;
 
     using LightLinkingMap = std::unordered_map<TfToken, std::vector<HdLight*>, TfToken::HashFunctor>;
+    /// Lights affecting shapes with the same set of light links.
+    struct LightGroups {
+        std::vector<AtNode*> lights;  ///< Lights illuminating the shapes.
+        std::vector<AtNode*> shadows; ///< Lights casting shadows from the shapes.
+    };
+    using LightGroupsMap = std::map<std::vector<TfToken>, LightGroups>;
     using NativeRprimTypeMap = std::unordered_map<TfToken, AtString, TfToken::HashFunctor>;
     using NativeRprimParams = std::unordered_map<AtString, NativeRprimParamList, AtStringHash>;
     // Should we use a std::vector here instead?
@@ -439,6 +473,10 @@ private:
     ShapeMaterialChangesQueue _shapeMaterialUntrackQueue; ///< Queue to untrack shape material assignment changes.
     MaterialToShapeMap _materialToShapeMap;               ///< Map to track dependencies between materials and shapes.
 
+    mutable std::mutex _nodeCountsMutex;                 ///< Mutex to guard the cached node counts.
+    mutable VtDictionary _nodeCounts;                    ///< Cached number of Arnold nodes for each node type.
+    mutable uint64_t _nodeCountsRestarts = ~uint64_t{0}; ///< Number of restarts when the nodes were counted.
+
     std::mutex _lightLinkingMutex;                  ///< Mutex to lock all light linking operations.
     LightLinkingMap _lightLinks;                    ///< Light Link categories.
     LightLinkingMap _shadowLinks;                   ///< Shadow Link categories.
@@ -447,6 +485,11 @@ private:
     TfTokenVector _supportedRprimTypes;             ///< List of supported rprim types.
     NativeRprimTypeMap _nativeRprimTypes;           ///< Remapping between the native rprim type names and arnold types.
     NativeRprimParams _nativeRprimParams;           ///< List of parameters for native rprims.
+    HdArnoldVolumeRegistry _volumeRegistry;         ///< Volumes shared between Hydra Volumes.
+    HdArnoldTexturePrefetcher _texturePrefetcher;   ///< Loads light textures in the background.
+    LightGroupsMap _lightGroups;                    ///< Light and shadow groups for each unique set of light links.
+    /// Light filters shared between lights.
+    HdArnoldLightFilterRegistry _lightFilterRegistry;
     /// Pointer to an instance of HdArnoldRenderParam.
     ///
     /// This is shared with all the primitives, so they can control the flow of
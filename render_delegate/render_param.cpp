@@ -27,8 +27,12 @@
 // limitations under the License.
 #include "render_param.h"
 
+#include <pxr/base/trace/trace.h>
+
 #include <ai.h>
 
+#include <constant_strings.h>
+
 PXR_NAMESPACE_OPEN_SCOPE
 
 HdArnoldRenderParam::HdArnoldRenderParam()
@@ -39,6 +43,7 @@ HdArnoldRenderParam::HdArnoldRenderParam()
 
 HdArnoldRenderParam::Status HdArnoldRenderParam::Render()
 {
+    TRACE_FUNCTION();
     const auto aborted = _aborted.load(std::memory_order_acquire);
     // Checking early if the render was aborted earlier.
     if (aborted) {
@@ -53,6 +58,7 @@ HdArnoldRenderParam::Status HdArnoldRenderParam::Render()
         const auto needsRestart = _needsRestart.exchange(false, std::memory_order_acq_rel);
         if (needsRestart) {
             _paused.store(false, std::memory_order_release);
+            _ScheduleRestart();
             AiRenderRestart();
             return Status::Converging;
         }
@@ -64,6 +70,7 @@ HdArnoldRenderParam::Status HdArnoldRenderParam::Render()
         const auto needsRestart = _needsRestart.exchange(false, std::memory_order_acq_rel);
         if (needsRestart) {
             _paused.store(false, std::memory_order_release);
+            _ScheduleRestart();
             AiRenderRestart();
         } else if (!_paused.load(std::memory_order_acquire)) {
             AiRenderResume();
@@ -102,6 +109,7 @@ HdArnoldRenderParam::Status HdArnoldRenderParam::Render()
         return Status::Aborted;
     }
     _paused.store(false, std::memory_order_release);
+    _ScheduleRestart();
     AiRenderBegin();
     return Status::Converging;
 }
@@ -134,4 +142,25 @@ void HdArnoldRenderParam::Restart()
     _needsRestart.store(true, std::memory_order_release);
 }
 
+void HdArnoldRenderParam::_ScheduleRestart()
+{
+    _stats.AddRestart();
+    const auto& settings = _frameRateScheduler.GetSettings();
+    if (!settings.enabled) {
+        // The scheduler was disabled after it changed the render settings, so the values set by the user are
+        // restored, instead of keeping the last interactive ones.
+        if (_frameRateSchedulerApplied) {
+            _frameRateSchedulerApplied = false;
+            AiRenderSetHintInt(str::progressive_min_AA_samples, settings.progressiveMinAASamples);
+            AiNodeSetInt(AiUniverseGetOptions(nullptr), str::bucket_size, settings.bucketSize);
+        }
+        return;
+    }
+    _frameRateScheduler.Restart(HdArnoldFrameRateScheduler::Clock::now());
+    _frameRateSchedulerApplied = true;
+    // The render delegate uses the default universe.
+    AiRenderSetHintInt(str::progressive_min_AA_samples, _frameRateScheduler.GetAASamples());
+    AiNodeSetInt(AiUniverseGetOptions(nullptr), str::bucket_size, _frameRateScheduler.GetBucketSize());
+}
+
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -38,6 +38,9 @@
 
 #include <atomic>
 
+#include "frame_rate_scheduler.h"
+#include "render_stats.h"
+
 PXR_NAMESPACE_OPEN_SCOPE
 
 /// Utility class to control the flow of rendering.
@@ -82,8 +85,29 @@ public:
     /// Resumes an already running,stopped/paused/finished render.
     HDARNOLD_API
     void Restart();
+    /// Returns the runtime statistics collected for the Render Delegate.
+    ///
+    /// @return Reference to the render statistics.
+    HdArnoldRenderStats& GetStats() { return _stats; }
+    /// Returns the runtime statistics collected for the Render Delegate.
+    ///
+    /// @return Constant reference to the render statistics.
+    const HdArnoldRenderStats& GetStats() const { return _stats; }
+    /// Returns the scheduler adapting progressive rendering to the target frame rate.
+    ///
+    /// @return Reference to the frame rate scheduler.
+    HdArnoldFrameRateScheduler& GetFrameRateScheduler() { return _frameRateScheduler; }
 
 private:
+    /// Lets the frame rate scheduler choose the settings before starting or restarting the render.
+    void _ScheduleRestart();
+
+    /// Runtime statistics shared with all the primitives.
+    HdArnoldRenderStats _stats;
+    /// Scheduler adapting progressive rendering to the target frame rate.
+    HdArnoldFrameRateScheduler _frameRateScheduler;
+    /// Indicate if the frame rate scheduler changed the render settings since it was last disabled.
+    bool _frameRateSchedulerApplied = false;
     /// Indicate if render needs restarting, in case interrupt is called after rendering has finished.
     std::atomic<bool> _needsRestart;
     /// Indicate if rendering has been aborted at one point or another.
@@ -29,6 +29,7 @@
 
 #include <pxr/base/tf/envSetting.h>
 #include <pxr/base/tf/staticTokens.h>
+#include <pxr/base/trace/trace.h>
 
 #include <pxr/base/gf/rect2i.h>
 
@@ -285,6 +286,36 @@ void _ReadNodeParameters(AtNode* node, const TfToken& prefix, const HdAovSetting
     }
 };
 
+/// Checks if an Arnold array holds the same strings as a vector.
+bool _ArrayEquals(const AtArray* array, const std::vector<AtString>& values)
+{
+    if (array == nullptr || AiArrayGetType(array) != AI_TYPE_STRING || AiArrayGetNumKeys(array) != 1 ||
+        AiArrayGetNumElements(array) != values.size()) {
+        return false;
+    }
+    for (auto i = decltype(values.size()){0}; i < values.size(); i += 1) {
+        if (AiArrayGetStr(array, static_cast<uint32_t>(i)) != values[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Checks if an Arnold array holds the same nodes as a vector.
+bool _ArrayEquals(const AtArray* array, const std::vector<AtNode*>& values)
+{
+    if (array == nullptr || AiArrayGetType(array) != AI_TYPE_NODE || AiArrayGetNumKeys(array) != 1 ||
+        AiArrayGetNumElements(array) != values.size()) {
+        return false;
+    }
+    for (auto i = decltype(values.size()){0}; i < values.size(); i += 1) {
+        if (AiArrayGetPtr(array, static_cast<uint32_t>(i)) != values[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
 AtNode* _CreateFilter(HdArnoldRenderDelegate* renderDelegate, const HdAovSettingsMap& aovSettings)
 {
     // We need to make sure that it's holding a string, then try to create it to make sure
@@ -431,8 +462,10 @@ HdArnoldRenderPass::~HdArnoldRenderPass()
 
 void HdArnoldRenderPass::_Execute(const HdRenderPassStateSharedPtr& renderPassState, const TfTokenVector& renderTags)
 {
+    TRACE_FUNCTION();
     TF_UNUSED(renderTags);
     auto* renderParam = reinterpret_cast<HdArnoldRenderParam*>(_renderDelegate->GetRenderParam());
+    const auto executeStart = HdArnoldRenderStats::Clock::now();
     const auto dataWindow = _GetDataWindow(renderPassState);
 
     const auto* currentUniverseCamera =
@@ -509,13 +542,17 @@ void HdArnoldRenderPass::_Execute(const HdRenderPassStateSharedPtr& renderPassSt
             }),
         aovBindings.end());
 
-    auto clearBuffers = [&](HdArnoldRenderBufferStorage& storage) {
+    auto clearBuffer = [&](HdArnoldRenderBuffer* buffer) {
         static std::vector<uint8_t> zeroData;
-        zeroData.resize(_width * _height * 4);
+        if (buffer != nullptr) {
+            zeroData.resize(_width * _height * 4);
+            buffer->WriteBucket(0, 0, _width, _height, HdFormatUNorm8Vec4, zeroData.data());
+        }
+    };
+
+    auto clearBuffers = [&](HdArnoldRenderBufferStorage& storage) {
         for (auto& buffer : storage) {
-            if (buffer.second.buffer != nullptr) {
-                buffer.second.buffer->WriteBucket(0, 0, _width, _height, HdFormatUNorm8Vec4, zeroData.data());
-            }
+            clearBuffer(buffer.second.buffer);
         }
     };
 
@@ -559,14 +596,18 @@ void HdArnoldRenderPass::_Execute(const HdRenderPassStateSharedPtr& renderPassSt
         const auto& delegateRenderProducts = _renderDelegate->GetDelegateRenderProducts();
         if (_RenderBuffersChanged(aovBindings) || (!delegateRenderProducts.empty() && _deepProducts.empty()) ||
             _usingFallbackBuffers) {
+            TRACE_SCOPE("HdArnoldRenderPass::_Execute rebuild outputs");
             _usingFallbackBuffers = false;
             renderParam->Interrupt();
-            _ClearRenderBuffers();
             AiNodeSetPtr(_mainDriver, str::color_pointer, nullptr);
             AiNodeSetPtr(_mainDriver, str::depth_pointer, nullptr);
             AiNodeSetPtr(_mainDriver, str::id_pointer, nullptr);
-            // Rebuilding render buffers
+            // Updating render buffers. Toggling a single AOV should not rebuild all the others, so we only create
+            // nodes for new AOVs or AOVs with changed settings, and destroy the ones that were removed or changed.
+            // Existing drivers, filters and aov shaders are reused as is.
             const auto numBindings = static_cast<unsigned int>(aovBindings.size());
+            HdArnoldRenderBufferStorage renderBuffers;
+            std::vector<HdArnoldRenderBuffer*> newBuffers;
             std::vector<AtString> outputs;
             outputs.reserve(numBindings);
             std::vector<AtString> lightPathExpressions;
@@ -581,15 +622,10 @@ void HdArnoldRenderPass::_Execute(const HdRenderPassStateSharedPtr& renderPassSt
             const auto* closestName = AiNodeGetName(_closestFilter);
             const auto* mainDriverName = AiNodeGetName(_mainDriver);
             for (const auto& binding : aovBindings) {
-                auto& buffer = _renderBuffers[binding.aovName];
+                auto& buffer = renderBuffers[binding.aovName];
                 // Sadly we only get a raw pointer here, so we have to expect hydra not clearing up render buffers
                 // while they are being used.
-                buffer.buffer = dynamic_cast<HdArnoldRenderBuffer*>(binding.renderBuffer);
-                buffer.settings = binding.aovSettings;
-                buffer.filter = _CreateFilter(_renderDelegate, binding.aovSettings);
-                const auto* filterName = buffer.filter != nullptr ? AiNodeGetName(buffer.filter) : boxName;
-                // Different possible filter for P and ID AOVs.
-                const auto* filterGeoName = buffer.filter != nullptr ? AiNodeGetName(buffer.filter) : closestName;
+                auto* renderBuffer = dynamic_cast<HdArnoldRenderBuffer*>(binding.renderBuffer);
                 const auto sourceType =
                     _GetOptionalSetting<TfToken>(binding.aovSettings, _tokens->sourceType, _tokens->raw);
                 const auto sourceName = _GetOptionalSetting<std::string>(
@@ -598,67 +634,79 @@ void HdArnoldRenderPass::_Execute(const HdRenderPassStateSharedPtr& renderPassSt
                 // an aov with the same name. We can't just check for the source name; for example: using a primvar
                 // type and displaying a "color" or a "depth" user data is a valid use case.
                 const auto isRaw = sourceType == _tokens->raw;
-                AtString output;
                 if (isRaw && sourceName == HdAovTokens->color) {
-                    output = AtString{TfStringPrintf("RGBA RGBA %s %s", filterName, mainDriverName).c_str()};
                     AiNodeSetPtr(_mainDriver, str::color_pointer, binding.renderBuffer);
                 } else if (isRaw && sourceName == HdAovTokens->depth) {
-                    output = AtString{TfStringPrintf("P VECTOR %s %s", filterGeoName, mainDriverName).c_str()};
                     AiNodeSetPtr(_mainDriver, str::depth_pointer, binding.renderBuffer);
                 } else if (isRaw && sourceName == HdAovTokens->primId) {
-                    output = AtString{TfStringPrintf("ID UINT %s %s", filterGeoName, mainDriverName).c_str()};
                     AiNodeSetPtr(_mainDriver, str::id_pointer, binding.renderBuffer);
-                } else {
-                    // Querying the data format from USD, with a default value of color3f.
-                    const auto format = _GetOptionalSetting<TfToken>(
-                        binding.aovSettings, _tokens->dataType, _GetTokenFromRenderBufferType(buffer.buffer));
-                    // Creating a separate driver for each aov.
-                    buffer.driver = AiNode(_renderDelegate->GetUniverse(), str::HdArnoldDriverAOV);
-                    const auto driverNameStr = _renderDelegate->GetLocalNodeName(
-                        AtString{TfStringPrintf("HdArnoldRenderPass_aov_driver_%p", buffer.driver).c_str()});
-                    AiNodeSetStr(buffer.driver, str::name, driverNameStr);
-                    AiNodeSetPtr(buffer.driver, str::aov_pointer, buffer.buffer);
-                    const auto arnoldTypes = _GetArnoldAOVTypeFromTokenType(format);
-                    const char* aovName = nullptr;
-                    if (sourceType == _tokens->lpe) {
-                        aovName = binding.aovName.GetText();
-                        // We have to add the light path expression to the outputs node in the format of:
-                        // "aov_name lpe" like "beauty C.*"
-                        lightPathExpressions.emplace_back(
-                            TfStringPrintf("%s %s", binding.aovName.GetText(), sourceName.c_str()).c_str());
-                    } else if (sourceType == _tokens->primvar) {
-                        aovName = binding.aovName.GetText();
-                        // We need to add a aov write shader to the list of aov_shaders on the options node. Each
-                        // of this shader will be executed on every surface.
-                        buffer.writer = AiNode(_renderDelegate->GetUniverse(), arnoldTypes.writer);
-                        if (sourceName == "st" || sourceName == "uv") { // st and uv are written to the built-in UV
-                            buffer.reader = AiNode(_renderDelegate->GetUniverse(), str::utility);
-                            AiNodeSetStr(buffer.reader, str::color_mode, str::uv);
-                            AiNodeSetStr(buffer.reader, str::shade_mode, str::flat);
-                        } else {
-                            buffer.reader = AiNode(_renderDelegate->GetUniverse(), arnoldTypes.reader);
-                            AiNodeSetStr(buffer.reader, str::attribute, AtString(sourceName.c_str()));
+                }
+                const auto existingBuffer = _renderBuffers.find(binding.aovName);
+                if (existingBuffer != _renderBuffers.end() && existingBuffer->second.settings == binding.aovSettings) {
+                    // Nothing has changed for the AOV, we only have to relink the render buffer if hydra has
+                    // given us a different one.
+                    buffer = std::move(existingBuffer->second);
+                    _renderBuffers.erase(existingBuffer);
+                    if (buffer.buffer != renderBuffer) {
+                        buffer.buffer = renderBuffer;
+                        if (buffer.driver != nullptr) {
+                            AiNodeSetPtr(buffer.driver, str::aov_pointer, buffer.buffer);
                         }
-                        const auto writerName = _renderDelegate->GetLocalNodeName(
-                            AtString{TfStringPrintf("HdArnoldRenderPass_aov_writer_%p", buffer.writer).c_str()});
-                        const auto readerName = _renderDelegate->GetLocalNodeName(
-                            AtString{TfStringPrintf("HdArnoldRenderPass_aov_reader_%p", buffer.reader).c_str()});
-                        AiNodeSetStr(buffer.writer, str::name, writerName);
-                        AiNodeSetStr(buffer.reader, str::name, readerName);
-                        AiNodeSetStr(buffer.writer, str::aov_name, AtString(aovName));
-                        AiNodeSetBool(buffer.writer, str::blend_opacity, false);
-                        AiNodeLink(buffer.reader, str::aov_input, buffer.writer);
-                        aovShaders.push_back(buffer.writer);
+                        newBuffers.push_back(buffer.buffer);
+                    }
+                } else {
+                    buffer.buffer = renderBuffer;
+                    buffer.settings = binding.aovSettings;
+                    buffer.filter = _CreateFilter(_renderDelegate, binding.aovSettings);
+                    newBuffers.push_back(buffer.buffer);
+                    const auto* filterName = buffer.filter != nullptr ? AiNodeGetName(buffer.filter) : boxName;
+                    // Different possible filter for P and ID AOVs.
+                    const auto* filterGeoName = buffer.filter != nullptr ? AiNodeGetName(buffer.filter) : closestName;
+                    if (isRaw && sourceName == HdAovTokens->color) {
+                        buffer.output =
+                            AtString{TfStringPrintf("RGBA RGBA %s %s", filterName, mainDriverName).c_str()};
+                    } else if (isRaw && sourceName == HdAovTokens->depth) {
+                        buffer.output =
+                            AtString{TfStringPrintf("P VECTOR %s %s", filterGeoName, mainDriverName).c_str()};
+                    } else if (isRaw && sourceName == HdAovTokens->primId) {
+                        buffer.output =
+                            AtString{TfStringPrintf("ID UINT %s %s", filterGeoName, mainDriverName).c_str()};
                     } else {
-                        aovName = sourceName.c_str();
+                        // Querying the data format from USD, with a default value of color3f.
+                        const auto format = _GetOptionalSetting<TfToken>(
+                            binding.aovSettings, _tokens->dataType, _GetTokenFromRenderBufferType(buffer.buffer));
+                        // Creating a separate driver for each aov.
+                        buffer.driver = AiNode(_renderDelegate->GetUniverse(), str::HdArnoldDriverAOV);
+                        const auto driverNameStr = _renderDelegate->GetLocalNodeName(
+                            AtString{TfStringPrintf("HdArnoldRenderPass_aov_driver_%p", buffer.driver).c_str()});
+                        AiNodeSetStr(buffer.driver, str::name, driverNameStr);
+                        AiNodeSetPtr(buffer.driver, str::aov_pointer, buffer.buffer);
+                        const auto arnoldTypes = _GetArnoldAOVTypeFromTokenType(format);
+                        std::vector<AtString> bufferLightPathExpressions;
+                        std::vector<AtNode*> bufferAovShaders;
+                        const auto aovName = _CreateAOV(
+                            _renderDelegate, arnoldTypes, binding.aovName.GetString(), sourceType, sourceName,
+                            buffer.writer, buffer.reader, bufferLightPathExpressions, bufferAovShaders);
+                        if (!bufferLightPathExpressions.empty()) {
+                            buffer.lightPathExpression = bufferLightPathExpressions.front();
+                        }
+                        buffer.output = AtString{TfStringPrintf(
+                                                     "%s %s %s %s", aovName.c_str(), arnoldTypes.outputString,
+                                                     filterName, AiNodeGetName(buffer.driver))
+                                                     .c_str()};
                     }
-                    output = AtString{
-                        TfStringPrintf(
-                            "%s %s %s %s", aovName, arnoldTypes.outputString, filterName, AiNodeGetName(buffer.driver))
-                            .c_str()};
                 }
-                outputs.push_back(output);
+                outputs.push_back(buffer.output);
+                if (!buffer.lightPathExpression.empty()) {
+                    lightPathExpressions.push_back(buffer.lightPathExpression);
+                }
+                if (buffer.writer != nullptr) {
+                    aovShaders.push_back(buffer.writer);
+                }
             }
+            // Anything left in the old storage was removed or changed.
+            _ClearRenderBuffers();
+            _renderBuffers.swap(renderBuffers);
             // We haven't initialized the deep products yet.
             // At the moment this won't work if delegate render products are set interactively, it's not something we
             // would potentially encounter as deep exrs are typically not rendered for interactive sessions, and
@@ -752,28 +800,54 @@ void HdArnoldRenderPass::_Execute(const HdRenderPassStateSharedPtr& renderPassSt
                     }
                 }
             }
-            if (!outputs.empty()) {
+            // The options arrays are only replaced if their contents changed, ie. when only the render buffer
+            // pointers were updated.
+            auto* options = _renderDelegate->GetOptions();
+            if (!outputs.empty() && !_ArrayEquals(AiNodeGetArray(options, str::outputs), outputs)) {
                 AiNodeSetArray(
-                    _renderDelegate->GetOptions(), str::outputs,
+                    options, str::outputs,
                     AiArrayConvert(static_cast<uint32_t>(outputs.size()), 1, AI_TYPE_STRING, outputs.data()));
             }
-            AiNodeSetArray(
-                _renderDelegate->GetOptions(), str::light_path_expressions,
-                lightPathExpressions.empty() ? AiArray(0, 1, AI_TYPE_STRING)
-                                             : AiArrayConvert(
-                                                   static_cast<uint32_t>(lightPathExpressions.size()), 1,
-                                                   AI_TYPE_STRING, lightPathExpressions.data()));
-            AiNodeSetArray(
-                _renderDelegate->GetOptions(), str::aov_shaders,
-                aovShaders.empty()
-                    ? AiArray(0, 1, AI_TYPE_NODE)
-                    : AiArrayConvert(static_cast<uint32_t>(aovShaders.size()), 1, AI_TYPE_NODE, aovShaders.data()));
-            clearBuffers(_renderBuffers);
+            if (!_ArrayEquals(AiNodeGetArray(options, str::light_path_expressions), lightPathExpressions)) {
+                AiNodeSetArray(
+                    options, str::light_path_expressions,
+                    lightPathExpressions.empty() ? AiArray(0, 1, AI_TYPE_STRING)
+                                                 : AiArrayConvert(
+                                                       static_cast<uint32_t>(lightPathExpressions.size()), 1,
+                                                       AI_TYPE_STRING, lightPathExpressions.data()));
+            }
+            if (!_ArrayEquals(AiNodeGetArray(options, str::aov_shaders), aovShaders)) {
+                AiNodeSetArray(
+                    options, str::aov_shaders,
+                    aovShaders.empty() ? AiArray(0, 1, AI_TYPE_NODE)
+                                       : AiArrayConvert(
+                                             static_cast<uint32_t>(aovShaders.size()), 1, AI_TYPE_NODE,
+                                             aovShaders.data()));
+            }
+            for (auto* buffer : newBuffers) {
+                clearBuffer(buffer);
+            }
         }
 #ifndef USD_DO_NOT_BLIT
     }
 #endif
 
+    // Checking for new pixels before calling Render, so buckets written by a render that is about to be restarted
+    // are not measured as the result of the restart.
+    auto hasUpdates = false;
+    for (auto& buffer : _renderBuffers) {
+        if (buffer.second.buffer != nullptr) {
+            hasUpdates = buffer.second.buffer->HasUpdates() || hasUpdates;
+        }
+    }
+#ifndef USD_DO_NOT_BLIT
+    const auto fallbackColorHasUpdates = _fallbackColor.HasUpdates();
+    hasUpdates = hasUpdates || fallbackColorHasUpdates;
+#endif
+    if (hasUpdates) {
+        renderParam->GetFrameRateScheduler().Update(HdArnoldFrameRateScheduler::Clock::now());
+    }
+
     // We skip an iteration step if the render delegate tells us to do so, this is the easiest way to force
     // a sync step before calling the render function. Currently, this is used to trigger light linking updates.
     const auto renderStatus = _renderDelegate->ShouldSkipIteration(
@@ -803,12 +877,14 @@ void HdArnoldRenderPass::_Execute(const HdRenderPassStateSharedPtr& renderPassSt
             clearBuffers(_fallbackBuffers);
         }
         // No AOV bindings means blit current framebuffer contents.
-        // TODO(pal): Only update the compositor and the fullscreen shader if something has changed.
-        //  When using fallback buffers, it's enough to check if the color has any updates.
+        // Color and depth are uploaded separately, and only if they received any buckets since the last upload.
+        // Color updates were already checked before rendering.
+        // The compositor and the fullscreen shader only accept full resolution textures, so buffers that changed are
+        // uploaded entirely. We have to draw every frame, as the host application clears the framebuffer before
+        // executing the render pass.
 #ifdef USD_HAS_FULLSCREEN_SHADER
-        if (_fallbackColor.HasUpdates()) {
+        if (fallbackColorHasUpdates) {
             auto* color = _fallbackColor.Map();
-            auto* depth = _fallbackDepth.Map();
             _fullscreenShader.SetTexture(
                 _tokens->color, _width, _height,
 #ifdef USD_HAS_UPDATED_COMPOSITOR
@@ -817,30 +893,36 @@ void HdArnoldRenderPass::_Execute(const HdRenderPassStateSharedPtr& renderPassSt
                 HdFormat::HdFormatUNorm8Vec4,
 #endif
                 color);
+            _fallbackColor.Unmap();
+        }
+        if (_fallbackDepth.HasUpdates()) {
+            auto* depth = _fallbackDepth.Map();
             _fullscreenShader.SetTexture(
                 _tokens->depth, _width, _height, HdFormatFloat32, reinterpret_cast<uint8_t*>(depth));
-            _fallbackColor.Unmap();
             _fallbackDepth.Unmap();
         }
         _fullscreenShader.SetProgramToCompositor(true);
         _fullscreenShader.Draw();
 #else
-        if (_fallbackColor.HasUpdates()) {
+        if (fallbackColorHasUpdates) {
             auto* color = _fallbackColor.Map();
-            auto* depth = _fallbackDepth.Map();
 #ifdef USD_HAS_UPDATED_COMPOSITOR
             _compositor.UpdateColor(_width, _height, HdFormat::HdFormatFloat32Vec4, color);
 #else
             _compositor.UpdateColor(_width, _height, reinterpret_cast<uint8_t*>(color));
 #endif
-            _compositor.UpdateDepth(_width, _height, reinterpret_cast<uint8_t*>(depth));
             _fallbackColor.Unmap();
+        }
+        if (_fallbackDepth.HasUpdates()) {
+            auto* depth = _fallbackDepth.Map();
+            _compositor.UpdateDepth(_width, _height, reinterpret_cast<uint8_t*>(depth));
             _fallbackDepth.Unmap();
         }
         _compositor.Draw();
 #endif
     }
 #endif
+    renderParam->GetStats().AddIteration(HdArnoldRenderStats::Clock::now() - executeStart);
 }
 
 bool HdArnoldRenderPass::_RenderBuffersChanged(const HdRenderPassAovBindingVector& aovBindings)
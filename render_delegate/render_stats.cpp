@@ -0,0 +1,155 @@
+// Copyright 2021 Autodesk, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "render_stats.h"
+
+#include <pxr/base/tf/staticTokens.h>
+
+#include "render_param.h"
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+// clang-format off
+TF_DEFINE_PRIVATE_TOKENS(_tokens,
+    (totalMemory)
+    (peakMemory)
+    (restarts)
+    (iterations)
+    (iterationTime)
+    (lastIterationTime)
+    (syncTime)
+    (syncCount)
+);
+// clang-format on
+
+namespace {
+
+inline double _ToSeconds(uint64_t nanoseconds) { return static_cast<double>(nanoseconds) * 1e-9; }
+
+inline uint64_t _ToNanoseconds(HdArnoldRenderStats::Clock::duration duration)
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+}
+
+} // namespace
+
+HdArnoldRenderStats::HdArnoldRenderStats()
+{
+    for (auto& sync : _sync) {
+        sync.time.store(0, std::memory_order_relaxed);
+        sync.count.store(0, std::memory_order_relaxed);
+    }
+    _restarts.store(0, std::memory_order_relaxed);
+    _iterations.store(0, std::memory_order_relaxed);
+    _iterationTime.store(0, std::memory_order_relaxed);
+    _lastIterationTime.store(0, std::memory_order_relaxed);
+    _memory.store(0, std::memory_order_relaxed);
+    _peakMemory.store(0, std::memory_order_relaxed);
+}
+
+void HdArnoldRenderStats::AddSyncTime(PrimType primType, Clock::duration duration)
+{
+    if (primType >= PrimType::Count) {
+        return;
+    }
+    auto& sync = _sync[static_cast<size_t>(primType)];
+    sync.time.fetch_add(_ToNanoseconds(duration), std::memory_order_relaxed);
+    sync.count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void HdArnoldRenderStats::AddRestart() { _restarts.fetch_add(1, std::memory_order_relaxed); }
+
+void HdArnoldRenderStats::AddIteration(Clock::duration duration)
+{
+    const auto nanoseconds = _ToNanoseconds(duration);
+    _iterations.fetch_add(1, std::memory_order_relaxed);
+    _iterationTime.fetch_add(nanoseconds, std::memory_order_relaxed);
+    _lastIterationTime.store(nanoseconds, std::memory_order_relaxed);
+}
+
+void HdArnoldRenderStats::SetMemory(uint64_t memory)
+{
+    _memory.store(memory, std::memory_order_relaxed);
+    auto peakMemory = _peakMemory.load(std::memory_order_relaxed);
+    while (memory > peakMemory &&
+           !_peakMemory.compare_exchange_weak(peakMemory, memory, std::memory_order_relaxed)) {
+    }
+}
+
+void HdArnoldRenderStats::Fill(VtDictionary& stats) const
+{
+    stats[_tokens->totalMemory] = _memory.load(std::memory_order_relaxed);
+    stats[_tokens->peakMemory] = _peakMemory.load(std::memory_order_relaxed);
+    stats[_tokens->restarts] = _restarts.load(std::memory_order_relaxed);
+    const auto iterations = _iterations.load(std::memory_order_relaxed);
+    stats[_tokens->iterations] = iterations;
+    stats[_tokens->iterationTime] =
+        iterations == 0 ? 0.0 : _ToSeconds(_iterationTime.load(std::memory_order_relaxed)) / iterations;
+    stats[_tokens->lastIterationTime] = _ToSeconds(_lastIterationTime.load(std::memory_order_relaxed));
+    VtDictionary syncTime;
+    VtDictionary syncCount;
+    for (auto primType = size_t{0}; primType < _sync.size(); primType += 1) {
+        const auto* primTypeName = GetPrimTypeName(static_cast<PrimType>(primType));
+        syncTime[primTypeName] = _ToSeconds(_sync[primType].time.load(std::memory_order_relaxed));
+        syncCount[primTypeName] = _sync[primType].count.load(std::memory_order_relaxed);
+    }
+    stats[_tokens->syncTime] = syncTime;
+    stats[_tokens->syncCount] = syncCount;
+}
+
+const char* HdArnoldRenderStats::GetPrimTypeName(PrimType primType)
+{
+    switch (primType) {
+        case PrimType::Mesh:
+            return "mesh";
+        case PrimType::Volume:
+            return "volume";
+        case PrimType::Points:
+            return "points";
+        case PrimType::BasisCurves:
+            return "basisCurves";
+        case PrimType::NativeRprim:
+            return "nativeRprim";
+        case PrimType::Instancer:
+            return "instancer";
+        case PrimType::Material:
+            return "material";
+        case PrimType::Light:
+            return "light";
+        case PrimType::Camera:
+            return "camera";
+        case PrimType::OpenvdbAsset:
+            return "openvdbAsset";
+        default:
+            return "unknown";
+    }
+}
+
+HdArnoldRenderStatsScope::HdArnoldRenderStatsScope(HdRenderParam* renderParam, HdArnoldRenderStats::PrimType primType)
+    : _primType(primType)
+{
+    // Fallback prims can be synced without a render param.
+    if (renderParam != nullptr) {
+        _stats = &reinterpret_cast<HdArnoldRenderParam*>(renderParam)->GetStats();
+        _start = HdArnoldRenderStats::Clock::now();
+    }
+}
+
+HdArnoldRenderStatsScope::~HdArnoldRenderStatsScope()
+{
+    if (_stats != nullptr) {
+        _stats->AddSyncTime(_primType, HdArnoldRenderStats::Clock::now() - _start);
+    }
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
@@ -0,0 +1,143 @@
+// Copyright 2021 Autodesk, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+/// @file render_stats.h
+///
+/// Utilities for collecting runtime statistics of the Render Delegate.
+#pragma once
+
+#include "api.h"
+
+#include <pxr/pxr.h>
+
+#include <pxr/base/vt/dictionary.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+class HdRenderParam;
+
+/// Class collecting runtime statistics for the Render Delegate.
+///
+/// All the counters are lock-free atomics, so they can be updated from multiple sync threads with very little
+/// overhead. The collected values are exposed via HdArnoldRenderDelegate::GetRenderStats.
+class HdArnoldRenderStats {
+public:
+    /// Type of the primitives tracked separately for sync timings.
+    enum class PrimType : uint8_t {
+        Mesh,
+        Volume,
+        Points,
+        BasisCurves,
+        NativeRprim,
+        Instancer,
+        Material,
+        Light,
+        Camera,
+        OpenvdbAsset,
+        Count ///< Number of tracked primitive types, not a valid type.
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    /// Constructor for HdArnoldRenderStats.
+    HDARNOLD_API
+    HdArnoldRenderStats();
+
+    /// Adds the time spent syncing a primitive.
+    ///
+    /// @param primType Type of the primitive.
+    /// @param duration Time spent syncing the primitive.
+    HDARNOLD_API
+    void AddSyncTime(PrimType primType, Clock::duration duration);
+
+    /// Increments the number of times rendering has been started or restarted.
+    HDARNOLD_API
+    void AddRestart();
+
+    /// Adds the time spent executing a single render pass iteration.
+    ///
+    /// @param duration Time spent in the render pass iteration.
+    HDARNOLD_API
+    void AddIteration(Clock::duration duration);
+
+    /// Stores the current memory usage and tracks the peak memory usage.
+    ///
+    /// @param memory Currently used memory in bytes.
+    HDARNOLD_API
+    void SetMemory(uint64_t memory);
+
+    /// Returns the number of times rendering has been started or restarted.
+    ///
+    /// @return Number of restarts.
+    uint64_t GetRestarts() const { return _restarts.load(std::memory_order_relaxed); }
+
+    /// Writes all the collected statistics to a dictionary.
+    ///
+    /// @param stats Output dictionary.
+    HDARNOLD_API
+    void Fill(VtDictionary& stats) const;
+
+    /// Returns the name used for the primitive type in the statistics dictionary.
+    ///
+    /// @param primType Type of the primitive.
+    /// @return Name of the primitive type.
+    HDARNOLD_API
+    static const char* GetPrimTypeName(PrimType primType);
+
+private:
+    /// Sync counters for a single primitive type.
+    struct SyncCounter {
+        std::atomic<uint64_t> time;  ///< Total time spent syncing in nanoseconds.
+        std::atomic<uint64_t> count; ///< Number of sync calls.
+    };
+
+    std::array<SyncCounter, static_cast<size_t>(PrimType::Count)> _sync; ///< Sync counters per primitive type.
+    std::atomic<uint64_t> _restarts;                                      ///< Number of render restarts.
+    std::atomic<uint64_t> _iterations;                                    ///< Number of render pass iterations.
+    std::atomic<uint64_t> _iterationTime;     ///< Total time spent in render pass iterations in nanoseconds.
+    std::atomic<uint64_t> _lastIterationTime; ///< Time spent in the last render pass iteration in nanoseconds.
+    std::atomic<uint64_t> _memory;            ///< Last queried memory usage in bytes.
+    std::atomic<uint64_t> _peakMemory;        ///< Peak memory usage in bytes.
+};
+
+/// Utility class to time the sync of a primitive.
+///
+/// The elapsed time is added to the render statistics when the scope is destroyed.
+class HdArnoldRenderStatsScope {
+public:
+    /// Constructor for HdArnoldRenderStatsScope.
+    ///
+    /// @param renderParam Pointer to the HdArnoldRenderParam owning the statistics.
+    /// @param primType Type of the primitive being synced.
+    HDARNOLD_API
+    HdArnoldRenderStatsScope(HdRenderParam* renderParam, HdArnoldRenderStats::PrimType primType);
+
+    /// Destructor for HdArnoldRenderStatsScope.
+    HDARNOLD_API
+    ~HdArnoldRenderStatsScope();
+
+    HdArnoldRenderStatsScope(const HdArnoldRenderStatsScope&) = delete;
+    HdArnoldRenderStatsScope& operator=(const HdArnoldRenderStatsScope&) = delete;
+
+private:
+    HdArnoldRenderStats* _stats = nullptr;         ///< Pointer to the render statistics.
+    HdArnoldRenderStats::Clock::time_point _start; ///< Time when the scope was created.
+    HdArnoldRenderStats::PrimType _primType;       ///< Type of the primitive being synced.
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
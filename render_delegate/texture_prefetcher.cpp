@@ -0,0 +1,151 @@
+// Copyright 2021 Autodesk, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "texture_prefetcher.h"
+
+#include <pxr/base/trace/trace.h>
+
+#include <ai.h>
+
+#include <fstream>
+#include <vector>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+namespace {
+
+// Reading in large blocks keeps the number of system calls low, while still allowing to cancel quickly.
+constexpr std::streamsize _blockSize = 8 * 1024 * 1024;
+
+} // namespace
+
+HdArnoldTexturePrefetcher::HdArnoldTexturePrefetcher()
+{
+    _enabled.store(true, std::memory_order_relaxed);
+    _cancelled.store(false, std::memory_order_relaxed);
+    _currentProgress.store(0.0f, std::memory_order_relaxed);
+}
+
+HdArnoldTexturePrefetcher::~HdArnoldTexturePrefetcher() { Cancel(); }
+
+void HdArnoldTexturePrefetcher::Prefetch(const std::string& path)
+{
+    // Paths with tokens, like <udim>, are resolved by the image node and can't be opened directly.
+    if (!IsEnabled() || path.empty() || path.find('<') != std::string::npos) {
+        return;
+    }
+    std::lock_guard<std::mutex> guard(_mutex);
+    if (_cancelled.load(std::memory_order_relaxed) || !_requested.insert(path).second) {
+        return;
+    }
+    // Progress is reported for all the textures requested since the prefetcher was last idle.
+    if (_queue.empty() && !_busy) {
+        _numQueued = 0;
+        _numDone = 0;
+    }
+    _queue.push_back(path);
+    _numQueued += 1;
+    // The thread is only started when the first texture is requested, so scenes without light textures don't pay
+    // for it.
+    if (!_thread.joinable()) {
+        _thread = std::thread(&HdArnoldTexturePrefetcher::_Run, this);
+    }
+    _queueChanged.notify_one();
+}
+
+float HdArnoldTexturePrefetcher::GetProgress() const
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    if (_numQueued == 0 || _numDone == _numQueued) {
+        return 1.0f;
+    }
+    const auto currentProgress = _busy ? _currentProgress.load(std::memory_order_relaxed) : 0.0f;
+    return (static_cast<float>(_numDone) + currentProgress) / static_cast<float>(_numQueued);
+}
+
+void HdArnoldTexturePrefetcher::Wait()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _idle.wait(
+        lock, [this]() -> bool { return (_queue.empty() && !_busy) || _cancelled.load(std::memory_order_relaxed); });
+}
+
+void HdArnoldTexturePrefetcher::Cancel()
+{
+    {
+        std::lock_guard<std::mutex> guard(_mutex);
+        _cancelled.store(true, std::memory_order_relaxed);
+        _queue.clear();
+        _queueChanged.notify_one();
+    }
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+    _idle.notify_all();
+}
+
+void HdArnoldTexturePrefetcher::_Run()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+        _queueChanged.wait(
+            lock, [this]() -> bool { return !_queue.empty() || _cancelled.load(std::memory_order_relaxed); });
+        if (_cancelled.load(std::memory_order_relaxed)) {
+            break;
+        }
+        const auto path = _queue.front();
+        _queue.pop_front();
+        _busy = true;
+        _currentProgress.store(0.0f, std::memory_order_relaxed);
+        lock.unlock();
+        _Prefetch(path);
+        lock.lock();
+        _busy = false;
+        _numDone += 1;
+        if (_queue.empty()) {
+            _idle.notify_all();
+        }
+    }
+    _busy = false;
+    _idle.notify_all();
+}
+
+void HdArnoldTexturePrefetcher::_Prefetch(const std::string& path)
+{
+    TRACE_FUNCTION();
+    // Querying the resolution opens the file via the texture system, which reads and caches the header and the
+    // tile layout of the texture.
+    unsigned int width = 0;
+    unsigned int height = 0;
+    if (!AiTextureGetResolution(path.c_str(), &width, &height)) {
+        return;
+    }
+    // Reading the whole file pulls it into the file cache of the operating system, so the tiles are not read from
+    // disk when the first rays hit the texture.
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return;
+    }
+    const auto fileSize = static_cast<float>(file.tellg());
+    file.seekg(0, std::ios::beg);
+    std::vector<char> buffer(_blockSize);
+    std::streamsize bytesRead = 0;
+    while (!_cancelled.load(std::memory_order_relaxed) && file.read(buffer.data(), _blockSize).gcount() > 0) {
+        bytesRead += file.gcount();
+        if (fileSize > 0.0f) {
+            _currentProgress.store(static_cast<float>(bytesRead) / fileSize, std::memory_order_relaxed);
+        }
+    }
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
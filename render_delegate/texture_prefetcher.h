@@ -0,0 +1,109 @@
+// Copyright 2021 Autodesk, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+/// @file texture_prefetcher.h
+///
+/// Utilities for loading light textures in the background.
+#pragma once
+
+#include "api.h"
+
+#include <pxr/pxr.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/// Utility class prefetching textures on a background thread.
+///
+/// Arnold loads textures lazily when the first ray hits them, so a large environment map on a dome light stalls the
+/// first progressive pass until it is read from disk. The prefetcher opens the texture via the Arnold texture system
+/// and reads the whole file once, as soon as the light is synced, so the file is already in the system's file cache
+/// when rendering starts. Files are processed in the order they were requested, on a single thread, so the
+/// prefetcher does not compete with the render threads for disk bandwidth.
+class HdArnoldTexturePrefetcher {
+public:
+    /// Constructor for HdArnoldTexturePrefetcher.
+    HDARNOLD_API
+    HdArnoldTexturePrefetcher();
+
+    /// Destructor for HdArnoldTexturePrefetcher, cancels all the pending requests.
+    HDARNOLD_API
+    ~HdArnoldTexturePrefetcher();
+
+    HdArnoldTexturePrefetcher(const HdArnoldTexturePrefetcher&) = delete;
+    HdArnoldTexturePrefetcher& operator=(const HdArnoldTexturePrefetcher&) = delete;
+
+    /// Sets if new textures are prefetched.
+    ///
+    /// @param enabled True if new textures should be prefetched.
+    void SetEnabled(bool enabled) { _enabled.store(enabled, std::memory_order_relaxed); }
+
+    /// Returns true if new textures are prefetched.
+    ///
+    /// @return True if new textures are prefetched.
+    bool IsEnabled() const { return _enabled.load(std::memory_order_relaxed); }
+
+    /// Requests prefetching a texture.
+    ///
+    /// Textures already prefetched or queued are skipped. The function returns immediately.
+    ///
+    /// @param path Path to the texture file.
+    HDARNOLD_API
+    void Prefetch(const std::string& path);
+
+    /// Returns the progress of prefetching all the textures requested since the prefetcher was last idle.
+    ///
+    /// @return Progress between 0 and 1, 1 if there is nothing to prefetch.
+    HDARNOLD_API
+    float GetProgress() const;
+
+    /// Blocks until all the requested textures are prefetched.
+    HDARNOLD_API
+    void Wait();
+
+    /// Cancels all the pending requests and stops the background thread.
+    ///
+    /// This has to be called before shutting down Arnold, as the background thread uses the texture system.
+    HDARNOLD_API
+    void Cancel();
+
+private:
+    /// Function executed by the background thread.
+    void _Run();
+    /// Prefetches a single texture.
+    ///
+    /// @param path Path to the texture file.
+    void _Prefetch(const std::string& path);
+
+    mutable std::mutex _mutex;                  ///< Mutex guarding the queue and the requested textures.
+    std::condition_variable _queueChanged;      ///< Signals new requests or cancelling.
+    std::condition_variable _idle;              ///< Signals when there is nothing left to prefetch.
+    std::deque<std::string> _queue;             ///< Textures waiting to be prefetched.
+    std::unordered_set<std::string> _requested; ///< Textures already prefetched or queued.
+    std::thread _thread;                        ///< Background thread prefetching the textures.
+    std::atomic<bool> _enabled;                 ///< If new textures are prefetched.
+    std::atomic<bool> _cancelled;               ///< If the pending requests were cancelled.
+    std::atomic<float> _currentProgress;        ///< Progress of the texture currently prefetched.
+    size_t _numQueued = 0;                      ///< Number of textures requested since the prefetcher was idle.
+    size_t _numDone = 0;                        ///< Number of textures prefetched since the prefetcher was idle.
+    bool _busy = false;                         ///< If the background thread is prefetching a texture.
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
@@ -37,6 +37,8 @@
 
 #include <pxr/base/tf/stringUtils.h>
 
+#include <pxr/base/work/loops.h>
+
 #include <pxr/usd/sdf/assetPath.h>
 
 #include "pxr/imaging/hd/extComputationUtils.h"
@@ -45,6 +47,7 @@
 #include "debug_codes.h"
 #include "hdarnold.h"
 
+#include <cstring>
 #include <type_traits>
 
 PXR_NAMESPACE_OPEN_SCOPE
@@ -851,6 +854,65 @@ inline bool _SetFromValueOrArray(
            _SetFromValueOrArray<T...>(node, paramName, value, std::forward<decltype(fs)>(fs)...);
 }
 
+/// Number of elements above which array conversions are split across multiple threads.
+constexpr size_t _parallelConversionThreshold = 1 << 16;
+
+/// Returns the array already set on a parameter if it matches the requested layout, or allocates a new one.
+///
+/// Particle simulations and deforming geometry update every frame without changing the number of points, so the
+/// existing array can be overwritten instead of allocating and copying a new one for every update.
+///
+/// @param node Pointer to an Arnold node.
+/// @param paramName Name of the array parameter.
+/// @param numElements Number of elements in the array.
+/// @param numKeys Number of motion keys in the array.
+/// @param type Arnold type of the array elements.
+/// @return Pointer to an array with the requested layout.
+AtArray* _GetReusableArray(
+    AtNode* node, const AtString& paramName, uint32_t numElements, uint8_t numKeys, uint8_t type)
+{
+    auto* arr = AiNodeGetArray(node, paramName);
+    if (arr != nullptr && AiArrayGetType(arr) == type && AiArrayGetNumElements(arr) == numElements &&
+        AiArrayGetNumKeys(arr) == numKeys) {
+        return arr;
+    }
+    return AiArrayAllocate(numElements, numKeys, type);
+}
+
+/// Copies a contiguous block of memory to a key of an array, splitting large copies across multiple threads.
+template <typename T>
+void _CopyToArrayKey(AtArray* arr, uint8_t key, const T* in, size_t numElements)
+{
+    auto* out = static_cast<T*>(AiArrayMapKey(arr, key));
+    if (numElements < _parallelConversionThreshold) {
+        std::memcpy(out, in, numElements * sizeof(T));
+    } else {
+        WorkParallelForN(numElements, [&](size_t start, size_t end) {
+            std::memcpy(out + start, in + start, (end - start) * sizeof(T));
+        });
+    }
+    AiArrayUnmap(arr);
+}
+
+/// Converts widths to radius in a single pass, writing directly to a key of an array.
+///
+/// The loop works on raw pointers, so the compiler can vectorize it.
+void _ConvertWidthsToArrayKey(AtArray* arr, uint8_t key, const float* in, size_t numElements)
+{
+    auto* out = static_cast<float*>(AiArrayMapKey(arr, key));
+    auto convertWidths = [&](size_t start, size_t end) {
+        for (auto i = start; i < end; i += 1) {
+            out[i] = in[i] * 0.5f;
+        }
+    };
+    if (numElements < _parallelConversionThreshold) {
+        convertWidths(0, numElements);
+    } else {
+        WorkParallelForN(numElements, convertWidths);
+    }
+    AiArrayUnmap(arr);
+}
+
 } // namespace
 
 AtMatrix HdArnoldConvertMatrix(const GfMatrix4d& in)
@@ -1279,16 +1341,12 @@ size_t HdArnoldSetPositionFromPrimvar(
             break;
         }
     }
-    auto* arr = AiArrayAllocate(v0.size(), xf.count, AI_TYPE_VECTOR);
-    AiArraySetKey(arr, 0, v0.data());
-    for (auto index = decltype(xf.count){1}; index < xf.count; index += 1) {
-        const auto& vi = xf.values[index].Get<VtVec3fArray>();
-        if (ARCH_LIKELY(vi.size() == v0.size())) {
-            AiArraySetKey(arr, index, vi.data());
-        } else {
-            AiArraySetKey(arr, index, v0.data());
-        }
+    auto* arr = _GetReusableArray(node, paramName, v0.size(), xf.count, AI_TYPE_VECTOR);
+    for (auto index = decltype(xf.count){0}; index < xf.count; index += 1) {
+        const auto& vi = xf.values[index].UncheckedGet<VtVec3fArray>();
+        _CopyToArrayKey(arr, index, ARCH_LIKELY(vi.size() == v0.size()) ? vi.cdata() : v0.cdata(), v0.size());
     }
+    // Setting the same array again is required to notify Arnold about the change, the array is not destroyed.
     AiNodeSetArray(node, paramName, arr);
     return xf.count;
 }
@@ -1299,7 +1357,9 @@ void HdArnoldSetPositionFromValue(AtNode* node, const AtString& paramName, const
         return;
     }
     const auto& values = value.UncheckedGet<VtVec3fArray>();
-    AiNodeSetArray(node, paramName, AiArrayConvert(values.size(), 1, AI_TYPE_VECTOR, values.data()));
+    auto* arr = _GetReusableArray(node, paramName, values.size(), 1, AI_TYPE_VECTOR);
+    _CopyToArrayKey(arr, 0, values.cdata(), values.size());
+    AiNodeSetArray(node, paramName, arr);
 }
 
 void HdArnoldSetRadiusFromPrimvar(AtNode* node, const SdfPath& id, HdSceneDelegate* sceneDelegate)
@@ -1320,18 +1380,11 @@ void HdArnoldSetRadiusFromPrimvar(AtNode* node, const SdfPath& id, HdSceneDelega
             break;
         }
     }
-    auto* arr = AiArrayAllocate(v0.size(), xf.count, AI_TYPE_FLOAT);
-    auto* out = static_cast<float*>(AiArrayMapKey(arr, 0));
-    auto convertWidth = [](const float w) -> float { return w * 0.5f; };
-    std::transform(v0.begin(), v0.end(), out, convertWidth);
-    for (auto index = decltype(xf.count){1}; index < xf.count; index += 1) {
-        out = static_cast<float*>(AiArrayMapKey(arr, index));
-        const auto& vi = xf.values[index].Get<VtFloatArray>();
-        if (ARCH_LIKELY(vi.size() == v0.size())) {
-            std::transform(vi.begin(), vi.end(), out, convertWidth);
-        } else {
-            std::transform(v0.begin(), v0.end(), out, convertWidth);
-        }
+    auto* arr = _GetReusableArray(node, str::radius, v0.size(), xf.count, AI_TYPE_FLOAT);
+    for (auto index = decltype(xf.count){0}; index < xf.count; index += 1) {
+        const auto& vi = xf.values[index].UncheckedGet<VtFloatArray>();
+        _ConvertWidthsToArrayKey(
+            arr, index, ARCH_LIKELY(vi.size() == v0.size()) ? vi.cdata() : v0.cdata(), v0.size());
     }
     AiNodeSetArray(node, str::radius, arr);
 }
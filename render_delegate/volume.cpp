@@ -28,6 +28,7 @@
 #include "volume.h"
 
 #include <pxr/base/tf/dl.h>
+#include <pxr/base/trace/trace.h>
 
 #include <pxr/imaging/hd/changeTracker.h>
 #include <pxr/imaging/hd/instancer.h>
@@ -170,9 +171,66 @@ const HtoAFnSet _GetHtoAFunctionSet()
 TF_DEFINE_PRIVATE_TOKENS(_tokens,
     (openvdbAsset)
     (filePath)
+    ((arnoldPrefix, "arnold:"))
 );
 // clang-format on
 
+namespace {
+
+/// Constant primvars setting parameters that only exist on the volume and not on the ginstances.
+using VolumeParameters = std::vector<std::pair<HdPrimvarDescriptor, VtValue>>;
+
+/// Collects primvars remapped to parameters of the shared volumes, ie. step_size or velocity_scale.
+///
+/// These have to be set on the shared volume, so volumes with different values can not be shared.
+///
+/// @param id Path to the Hydra Volume.
+/// @param sceneDelegate Pointer to the Scene Delegate.
+/// @return List of primvars and their values.
+VolumeParameters _GetVolumeParameters(const SdfPath& id, HdSceneDelegate* sceneDelegate)
+{
+    VolumeParameters parameters;
+    const auto* volumeEntry = AiNodeEntryLookUp(str::volume);
+    const auto* ginstanceEntry = AiNodeEntryLookUp(str::ginstance);
+    for (const auto& primvar : sceneDelegate->GetPrimvarDescriptors(id, HdInterpolation::HdInterpolationConstant)) {
+        if (!TfStringStartsWith(primvar.name.GetString(), _tokens->arnoldPrefix)) {
+            continue;
+        }
+        const AtString paramName(primvar.name.GetText() + _tokens->arnoldPrefix.size());
+        if (AiNodeEntryLookUpParameter(volumeEntry, paramName) == nullptr ||
+            AiNodeEntryLookUpParameter(ginstanceEntry, paramName) != nullptr) {
+            continue;
+        }
+        parameters.emplace_back(primvar, sceneDelegate->Get(id, primvar.name));
+    }
+    return parameters;
+}
+
+/// Returns the names and values of the volume parameters, used to find a matching shared volume.
+///
+/// @param parameters Primvars setting parameters of the shared volumes, and their values.
+/// @return Names and values of the parameters.
+HdArnoldVolumeRegistry::Parameters _GetRegistryParameters(const VolumeParameters& parameters)
+{
+    HdArnoldVolumeRegistry::Parameters registryParameters;
+    registryParameters.reserve(parameters.size());
+    for (const auto& parameter : parameters) {
+        registryParameters.emplace_back(parameter.first.name, parameter.second);
+    }
+    return registryParameters;
+}
+
+/// Returns the shared volume instanced by a ginstance.
+///
+/// @param shape Pointer to the HdArnoldShape storing the ginstance.
+/// @return Pointer to the shared Arnold Volume.
+inline AtNode* _GetSharedVolume(HdArnoldShape* shape)
+{
+    return static_cast<AtNode*>(AiNodeGetPtr(shape->GetShape(), str::node));
+}
+
+} // namespace
+
 #if PXR_VERSION >= 2102
 HdArnoldVolume::HdArnoldVolume(HdArnoldRenderDelegate* renderDelegate, const SdfPath& id)
     : HdVolume(id), _renderDelegate(renderDelegate)
@@ -188,20 +246,35 @@ HdArnoldVolume::HdArnoldVolume(HdArnoldRenderDelegate* renderDelegate, const Sdf
 HdArnoldVolume::~HdArnoldVolume()
 {
     _materialTracker.UntrackMaterials(_renderDelegate, GetId());
-    _ForEachVolume([](HdArnoldShape* s) { delete s; });
+    auto& volumeRegistry = _renderDelegate->GetVolumeRegistry();
+    for (auto* shape : _volumes) {
+        auto* sharedVolume = _GetSharedVolume(shape);
+        delete shape;
+        volumeRegistry.Release(sharedVolume);
+    }
+    for (auto* shape : _inMemoryVolumes) {
+        delete shape;
+    }
 }
 
 void HdArnoldVolume::Sync(
     HdSceneDelegate* sceneDelegate, HdRenderParam* renderParam, HdDirtyBits* dirtyBits, const TfToken& reprToken)
 {
+    TRACE_FUNCTION();
+    HdArnoldRenderStatsScope statsScope(renderParam, HdArnoldRenderStats::PrimType::Volume);
     TF_UNUSED(reprToken);
     HdArnoldRenderParamInterrupt param(renderParam);
     const auto& id = GetId();
     auto volumesChanged = false;
-    if (HdChangeTracker::IsTopologyDirty(*dirtyBits, id)) {
+    const auto topologyDirty = HdChangeTracker::IsTopologyDirty(*dirtyBits, id);
+    auto volumesDirty = topologyDirty || (*dirtyBits & DirtyFields);
+    // Parameters of the shared volumes are set via primvars, and changing them requires a different shared volume.
+    if (!volumesDirty && !_volumes.empty() && (*dirtyBits & HdChangeTracker::DirtyPrimvar)) {
+        volumesDirty = _GetRegistryParameters(_GetVolumeParameters(id, sceneDelegate)) != _volumeParameters;
+    }
+    if (volumesDirty) {
         param.Interrupt();
-        _CreateVolumes(id, sceneDelegate);
-        volumesChanged = true;
+        volumesChanged = _CreateVolumes(id, sceneDelegate, topologyDirty);
     }
 
     if (volumesChanged || (*dirtyBits & HdChangeTracker::DirtyMaterialId)) {
@@ -215,20 +288,23 @@ void HdArnoldVolume::Sync(
         _ForEachVolume([&](HdArnoldShape* s) { AiNodeSetPtr(s->GetShape(), str::shader, volumeShader); });
     }
 
+    // Newly created volumes need all the parameters of the existing ones.
     auto transformDirtied = false;
-    if (HdChangeTracker::IsTransformDirty(*dirtyBits, id)) {
+    if (volumesChanged || HdChangeTracker::IsTransformDirty(*dirtyBits, id)) {
         param.Interrupt();
         _ForEachVolume([&](HdArnoldShape* s) { HdArnoldSetTransform(s->GetShape(), sceneDelegate, GetId()); });
         transformDirtied = true;
     }
 
-    if (HdChangeTracker::IsVisibilityDirty(*dirtyBits, id)) {
+    if (volumesChanged || HdChangeTracker::IsVisibilityDirty(*dirtyBits, id)) {
         param.Interrupt();
-        _UpdateVisibility(sceneDelegate, dirtyBits);
+        if (HdChangeTracker::IsVisibilityDirty(*dirtyBits, id)) {
+            _UpdateVisibility(sceneDelegate, dirtyBits);
+        }
         _ForEachVolume([&](HdArnoldShape* s) { s->SetVisibility(_sharedData.visible ? AI_RAY_ALL : uint8_t{0}); });
     }
 
-    if (*dirtyBits & HdChangeTracker::DirtyPrimvar) {
+    if (volumesChanged || (*dirtyBits & HdChangeTracker::DirtyPrimvar)) {
         param.Interrupt();
         auto visibility = AI_RAY_ALL;
         if (!_volumes.empty()) {
@@ -258,7 +334,7 @@ void HdArnoldVolume::Sync(
     *dirtyBits = HdChangeTracker::Clean;
 }
 
-void HdArnoldVolume::_CreateVolumes(const SdfPath& id, HdSceneDelegate* sceneDelegate)
+bool HdArnoldVolume::_CreateVolumes(const SdfPath& id, HdSceneDelegate* sceneDelegate, bool rebuildInMemoryVolumes)
 {
     std::unordered_map<std::string, std::vector<TfToken>> openvdbs;
     std::unordered_map<std::string, std::vector<TfToken>> houVdbs;
@@ -291,60 +367,93 @@ void HdArnoldVolume::_CreateVolumes(const SdfPath& id, HdSceneDelegate* sceneDel
         }
     }
 
+    // Ginstances of files not used anymore are reused for the new files, so only the shared volume is changed when
+    // the file path of a field changes.
+    auto volumesCreated = false;
+    auto& volumeRegistry = _renderDelegate->GetVolumeRegistry();
+    std::vector<HdArnoldShape*> unusedVolumes;
     _volumes.erase(
         std::remove_if(
             _volumes.begin(), _volumes.end(),
-            [&openvdbs](HdArnoldShape* shape) -> bool {
-                if (openvdbs.find(std::string(AiNodeGetStr(shape->GetShape(), str::filename).c_str())) ==
-                    openvdbs.end()) {
-                    delete shape;
+            [&openvdbs, &unusedVolumes](HdArnoldShape* shape) -> bool {
+                auto* sharedVolume = _GetSharedVolume(shape);
+                if (openvdbs.find(std::string(AiNodeGetStr(sharedVolume, str::filename).c_str())) == openvdbs.end()) {
+                    unusedVolumes.push_back(shape);
                     return true;
                 }
                 return false;
             }),
         _volumes.end());
-
+    const auto numUsedVolumes = _volumes.size();
+
+    // Volumes loading the same grids from the same file with the same parameters are shared between all the Hydra
+    // Volumes, each Hydra Volume only creates ginstances of them.
+    const auto parameters = _GetVolumeParameters(id, sceneDelegate);
+    _volumeParameters = _GetRegistryParameters(parameters);
+    const auto setupVolume = [&parameters](AtNode* volume) {
+        for (const auto& parameter : parameters) {
+            HdArnoldSetConstantPrimvar(volume, parameter.first.name, parameter.first.role, parameter.second);
+        }
+    };
     for (const auto& openvdb : openvdbs) {
-        AtNode* volume = nullptr;
-        for (auto* shape : _volumes) {
-            auto* v = shape->GetShape();
-            if (openvdb.first == AiNodeGetStr(v, str::filename).c_str()) {
-                volume = v;
+        auto* sharedVolume = volumeRegistry.Acquire(
+            _renderDelegate->GetUniverse(), openvdb.first, openvdb.second, _volumeParameters, setupVolume);
+        HdArnoldShape* instance = nullptr;
+        for (auto i = decltype(numUsedVolumes){0}; i < numUsedVolumes; i += 1) {
+            if (openvdb.first == AiNodeGetStr(_GetSharedVolume(_volumes[i]), str::filename).c_str()) {
+                instance = _volumes[i];
                 break;
             }
         }
-        if (volume == nullptr) {
-            auto* shape = new HdArnoldShape(str::volume, _renderDelegate, id, GetPrimId());
-            volume = shape->GetShape();
-            AiNodeSetStr(volume, str::filename, AtString(openvdb.first.c_str()));
-            AiNodeSetStr(volume, str::name, AtString(TfStringPrintf("%s_p_%p", id.GetText(), volume).c_str()));
-            _volumes.push_back(shape);
+        if (instance == nullptr && !unusedVolumes.empty()) {
+            instance = unusedVolumes.back();
+            unusedVolumes.pop_back();
+            _volumes.push_back(instance);
         }
-        const auto numFields = openvdb.second.size();
-        auto* fields = AiArrayAllocate(numFields, 1, AI_TYPE_STRING);
-        for (auto i = decltype(numFields){0}; i < numFields; ++i) {
-            AiArraySetStr(fields, i, AtString(openvdb.second[i].GetText()));
+        if (instance == nullptr) {
+            instance = new HdArnoldShape(str::ginstance, _renderDelegate, id, GetPrimId());
+            auto* ginstance = instance->GetShape();
+            AiNodeSetStr(ginstance, str::name, AtString(TfStringPrintf("%s_p_%p", id.GetText(), ginstance).c_str()));
+            _volumes.push_back(instance);
+            AiNodeSetPtr(instance->GetShape(), str::node, sharedVolume);
+            volumesCreated = true;
+        } else {
+            // Releasing the previous volume after acquiring the new one, so an unchanged volume is not recreated.
+            auto* previousVolume = _GetSharedVolume(instance);
+            AiNodeSetPtr(instance->GetShape(), str::node, sharedVolume);
+            volumeRegistry.Release(previousVolume);
         }
-        AiNodeSetArray(volume, str::grids, fields);
     }
 
+    for (auto* shape : unusedVolumes) {
+        auto* sharedVolume = _GetSharedVolume(shape);
+        delete shape;
+        volumeRegistry.Release(sharedVolume);
+    }
+
+    // Converting the in-memory volumes is expensive, so they are only rebuilt if the fields changed, or if the data
+    // of the fields might have changed.
+    if (!rebuildInMemoryVolumes && houVdbs == _inMemoryFields) {
+        return volumesCreated;
+    }
+    _inMemoryFields = houVdbs;
     for (auto* volume : _inMemoryVolumes) {
         delete volume;
     }
     _inMemoryVolumes.clear();
 
     if (houVdbs.empty()) {
-        return;
+        return volumesCreated;
     }
 
     const auto& houdiniFnSet = _GetHoudiniFunctionSet();
     if (houdiniFnSet.getVdbPrimitive == nullptr || houdiniFnSet.getVolumePrimitive == nullptr) {
-        return;
+        return volumesCreated;
     }
 
     const auto& htoaFnSet = _GetHtoAFunctionSet();
     if (htoaFnSet.convertPrimVdbToArnold == nullptr) {
-        return;
+        return volumesCreated;
     }
 
     for (const auto& houVdb : houVdbs) {
@@ -365,7 +474,9 @@ void HdArnoldVolume::_CreateVolumes(const SdfPath& id, HdSceneDelegate* sceneDel
         AiNodeSetStr(volume, str::name, AtString(TfStringPrintf("%s_p_%p", id.GetText(), volume).c_str()));
         htoaFnSet.convertPrimVdbToArnold(volume, static_cast<int>(gridVec.size()), gridVec.data());
         _inMemoryVolumes.push_back(shape);
+        volumesCreated = true;
     }
+    return volumesCreated;
 }
 
 HdDirtyBits HdArnoldVolume::GetInitialDirtyBitsMask() const { return HdChangeTracker::AllDirty; }
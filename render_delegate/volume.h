@@ -42,6 +42,8 @@
 
 #include <ai.h>
 
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 PXR_NAMESPACE_OPEN_SCOPE
@@ -49,6 +51,9 @@ PXR_NAMESPACE_OPEN_SCOPE
 /// Utility class for Hydra Volumes.
 class HdArnoldVolume : public HdVolume {
 public:
+    /// Dirty bit set by HdArnoldOpenvdbAsset when the file path or the grid name of a field changes.
+    static constexpr HdDirtyBits DirtyFields = HdChangeTracker::CustomBitsBegin;
+
 #if PXR_VERSION >= 2102
     /// Constructor for HdArnoldVolume.
     ///
@@ -114,10 +119,18 @@ protected:
     /// we check each grid/field connected, and create multiple Volume
     /// primitives for each file loaded.
     ///
+    /// Volumes loading files from disk are shared via HdArnoldVolumeRegistry
+    /// between all the Hydra Volumes loading the same grids from the same
+    /// file, and each Hydra Volume only creates a ginstance for them.
+    /// Existing ginstances are reused when possible, so changing the file
+    /// of a field only changes the volume instanced.
+    ///
     /// @param id Path to the Primitive.
     /// @param sceneDelegate Pointer to the Scene Delegate.
+    /// @param rebuildInMemoryVolumes Rebuilds the in-memory volumes even if the fields did not change.
+    /// @return True if new Arnold shapes were created.
     HDARNOLD_API
-    void _CreateVolumes(const SdfPath& id, HdSceneDelegate* sceneDelegate);
+    bool _CreateVolumes(const SdfPath& id, HdSceneDelegate* sceneDelegate, bool rebuildInMemoryVolumes);
 
     /// Iterates through all available volumes and calls a function on each of them.
     ///
@@ -136,8 +149,11 @@ protected:
 
     HdArnoldRenderDelegate* _renderDelegate;      ///< Pointer to the Render Delegate.
     HdArnoldMaterialTracker _materialTracker;     ///< Utility to track material assignments to the volume.
-    std::vector<HdArnoldShape*> _volumes;         ///< Vector storing all the Volumes created.
+    std::vector<HdArnoldShape*> _volumes;         ///< Vector storing the ginstances of the shared Volumes.
     std::vector<HdArnoldShape*> _inMemoryVolumes; ///< Vectoring storing all the Volumes for in-memory VDB storage.
+    /// Fields of the in-memory VDB storages used to create the in-memory Volumes.
+    std::unordered_map<std::string, std::vector<TfToken>> _inMemoryFields;
+    HdArnoldVolumeRegistry::Parameters _volumeParameters; ///< Primvars set on the shared Volumes.
 };
 
 PXR_NAMESPACE_CLOSE_SCOPE
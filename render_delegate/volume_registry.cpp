@@ -0,0 +1,151 @@
+// Copyright 2021 Autodesk, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "volume_registry.h"
+
+#include <pxr/base/tf/stringUtils.h>
+
+#include <constant_strings.h>
+
+#include <algorithm>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+namespace {
+
+using Parameters = HdArnoldVolumeRegistry::Parameters;
+
+// The order of the parameters does not change the volume either.
+Parameters _SortParameters(const Parameters& parameters)
+{
+    auto sortedParameters = parameters;
+    std::sort(
+        sortedParameters.begin(), sortedParameters.end(),
+        [](const Parameters::value_type& a, const Parameters::value_type& b) -> bool {
+            return TfTokenFastArbitraryLessThan()(a.first, b.first);
+        });
+    return sortedParameters;
+}
+
+size_t _HashParameters(const Parameters& parameters)
+{
+    size_t hash = 0;
+    for (const auto& parameter : parameters) {
+        for (const auto h : {parameter.first.Hash(), parameter.second.GetHash()}) {
+            hash ^= h + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        }
+    }
+    return hash;
+}
+
+std::string _GetKey(const std::string& filename, const std::vector<TfToken>& grids, size_t parametersHash)
+{
+    // The order of the grids does not change what the volume loads.
+    auto sortedGrids = grids;
+    std::sort(sortedGrids.begin(), sortedGrids.end(), TfTokenFastArbitraryLessThan());
+    std::string key = filename;
+    for (const auto& grid : sortedGrids) {
+        key += '\n';
+        key += grid.GetString();
+    }
+    key += '\n';
+    key += std::to_string(parametersHash);
+    return key;
+}
+
+} // namespace
+
+AtNode* HdArnoldVolumeRegistry::Acquire(
+    AtUniverse* universe, const std::string& filename, const std::vector<TfToken>& grids,
+    const Parameters& parameters, const SetupVolume& setupVolume)
+{
+    auto sortedParameters = _SortParameters(parameters);
+    auto key = _GetKey(filename, grids, _HashParameters(sortedParameters));
+    std::lock_guard<std::mutex> guard(_mutex);
+    auto& entries = _volumes[key];
+    // The hash is only used to find candidates, shared volumes must have identical parameters.
+    auto entryIt = std::find_if(entries.begin(), entries.end(), [&sortedParameters](const Entry& entry) -> bool {
+        return entry.parameters == sortedParameters;
+    });
+    if (entryIt == entries.end()) {
+        entries.emplace_back();
+        entryIt = entries.end() - 1;
+        entryIt->parameters = std::move(sortedParameters);
+    }
+    auto& entry = *entryIt;
+    if (entry.volume == nullptr) {
+        entry.volume = AiNode(universe, str::volume);
+        AiNodeSetStr(
+            entry.volume, str::name, AtString(TfStringPrintf("%s_shared_%p", filename.c_str(), entry.volume).c_str()));
+        AiNodeSetStr(entry.volume, str::filename, AtString(filename.c_str()));
+        const auto numGrids = grids.size();
+        auto* gridsArray = AiArrayAllocate(numGrids, 1, AI_TYPE_STRING);
+        for (auto i = decltype(numGrids){0}; i < numGrids; ++i) {
+            AiArraySetStr(gridsArray, i, AtString(grids[i].GetText()));
+        }
+        AiNodeSetArray(entry.volume, str::grids, gridsArray);
+        if (setupVolume) {
+            setupVolume(entry.volume);
+        }
+        // The shared volume is only rendered through the ginstances.
+        AiNodeSetByte(entry.volume, str::visibility, 0);
+        _keys.emplace(entry.volume, key);
+    }
+    entry.refCount += 1;
+    return entry.volume;
+}
+
+void HdArnoldVolumeRegistry::Release(AtNode* volume)
+{
+    if (volume == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> guard(_mutex);
+    const auto keyIt = _keys.find(volume);
+    if (keyIt == _keys.end()) {
+        return;
+    }
+    const auto volumesIt = _volumes.find(keyIt->second);
+    if (volumesIt == _volumes.end()) {
+        _keys.erase(keyIt);
+        return;
+    }
+    auto& entries = volumesIt->second;
+    const auto entryIt = std::find_if(
+        entries.begin(), entries.end(), [volume](const Entry& entry) -> bool { return entry.volume == volume; });
+    if (entryIt == entries.end()) {
+        _keys.erase(keyIt);
+        return;
+    }
+    entryIt->refCount -= 1;
+    if (entryIt->refCount == 0) {
+        AiNodeDestroy(volume);
+        entries.erase(entryIt);
+        if (entries.empty()) {
+            _volumes.erase(volumesIt);
+        }
+        _keys.erase(keyIt);
+    }
+}
+
+size_t HdArnoldVolumeRegistry::GetNumVolumes() const
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    size_t numVolumes = 0;
+    for (const auto& entries : _volumes) {
+        numVolumes += entries.second.size();
+    }
+    return numVolumes;
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
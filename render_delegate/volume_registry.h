@@ -0,0 +1,100 @@
+// Copyright 2021 Autodesk, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+/// @file volume_registry.h
+///
+/// Registry for sharing Arnold Volumes loading the same files.
+#pragma once
+
+#include "api.h"
+
+#include <pxr/pxr.h>
+
+#include <pxr/base/tf/token.h>
+#include <pxr/base/vt/value.h>
+
+#include <ai.h>
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/// Utility class sharing Arnold Volumes between Hydra Volumes loading the same grids from the same file.
+///
+/// Each shared volume is a hidden Arnold Volume, that Hydra Volumes instance via ginstance nodes, so the VDB file is
+/// only loaded and the acceleration structure is only built once. Volumes are reference counted and destroyed when
+/// the last Hydra Volume using them releases them. The registry is thread safe, so it can be used from parallel syncs.
+class HdArnoldVolumeRegistry {
+public:
+    /// Function setting up parameters on a newly created shared volume.
+    using SetupVolume = std::function<void(AtNode*)>;
+    /// Names and values of the additional parameters set on a shared volume.
+    using Parameters = std::vector<std::pair<TfToken, VtValue>>;
+
+    /// Constructor for HdArnoldVolumeRegistry.
+    HdArnoldVolumeRegistry() = default;
+
+    /// Destructor for HdArnoldVolumeRegistry.
+    ///
+    /// Volumes still in the registry are owned by the universe, so they are not destroyed here.
+    ~HdArnoldVolumeRegistry() = default;
+
+    HdArnoldVolumeRegistry(const HdArnoldVolumeRegistry&) = delete;
+    HdArnoldVolumeRegistry& operator=(const HdArnoldVolumeRegistry&) = delete;
+
+    /// Returns a shared volume loading the given grids from a file, and increments its reference count.
+    ///
+    /// @param universe Universe to create the volume in.
+    /// @param filename Path to the VDB file.
+    /// @param grids Names of the grids to load.
+    /// @param parameters Additional parameters set by @p setupVolume, volumes are only shared if they are equal.
+    /// @param setupVolume Function setting additional parameters on a newly created volume.
+    /// @return Pointer to the shared Arnold Volume.
+    HDARNOLD_API
+    AtNode* Acquire(
+        AtUniverse* universe, const std::string& filename, const std::vector<TfToken>& grids,
+        const Parameters& parameters, const SetupVolume& setupVolume);
+
+    /// Decrements the reference count of a shared volume, and destroys it if it's not used anymore.
+    ///
+    /// @param volume Pointer to the shared Arnold Volume.
+    HDARNOLD_API
+    void Release(AtNode* volume);
+
+    /// Returns the number of shared volumes.
+    ///
+    /// @return Number of shared volumes.
+    HDARNOLD_API
+    size_t GetNumVolumes() const;
+
+private:
+    /// A single shared volume.
+    struct Entry {
+        AtNode* volume = nullptr; ///< Pointer to the shared Arnold Volume.
+        size_t refCount = 0;      ///< Number of Hydra Volumes using the volume.
+        Parameters parameters;    ///< Sorted additional parameters of the volume.
+    };
+
+    mutable std::mutex _mutex; ///< Mutex guarding the registry.
+    /// Shared volumes by their key, built from the file, the grids and the hash of the parameters. Parameters with
+    /// colliding hashes are told apart by comparing their values.
+    std::unordered_map<std::string, std::vector<Entry>> _volumes;
+    std::unordered_map<const AtNode*, std::string> _keys; ///< Keys of the shared volumes.
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
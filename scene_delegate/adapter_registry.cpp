@@ -48,6 +48,13 @@ ImagingArnoldAdapterRegistry::ImagingArnoldAdapterRegistry()
 ImagingArnoldAdapterRegistry::~ImagingArnoldAdapterRegistry() {}
 
 ImagingArnoldPrimAdapterPtr ImagingArnoldAdapterRegistry::FindAdapter(const AtString& arnoldType) const
+{
+    const auto* factory = FindAdapterFactory(arnoldType);
+    return factory == nullptr ? nullptr : factory->Create();
+}
+
+const ImagingArnoldPrimAdapterFactoryBase* ImagingArnoldAdapterRegistry::FindAdapterFactory(
+    const AtString& arnoldType) const
 {
     auto type = _typeMap.find(arnoldType);
     if (type == _typeMap.end()) {
@@ -60,11 +67,7 @@ ImagingArnoldPrimAdapterPtr ImagingArnoldAdapterRegistry::FindAdapter(const AtSt
         return nullptr;
     }
 
-    auto* factory = type->second.GetFactory<ImagingArnoldPrimAdapterFactoryBase>();
-    if (factory == nullptr) {
-        return nullptr;
-    }
-    return factory->Create();
+    return type->second.GetFactory<ImagingArnoldPrimAdapterFactoryBase>();
 }
 
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -56,6 +56,17 @@ public:
     IMAGINGARNOLD_API
     ImagingArnoldPrimAdapterPtr FindAdapter(const AtString& arnoldType) const;
 
+    /// Finds the adapter factory for an Arnold node type.
+    ///
+    /// Loads the plugin providing the adapter. The returned factory can be used to create adapters from multiple
+    /// threads, without querying the plugin registry for every node.
+    ///
+    /// @param arnoldType Type of the Arnold node.
+    /// @return Pointer to the adapter factory for a given Arnold node, nullptr if no adapters are available for any
+    /// given node type.
+    IMAGINGARNOLD_API
+    const ImagingArnoldPrimAdapterFactoryBase* FindAdapterFactory(const AtString& arnoldType) const;
+
 private:
     using TypeMap = std::unordered_map<AtString, TfType, AtStringHash>;
 
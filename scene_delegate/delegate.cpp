@@ -13,12 +13,59 @@
 // limitations under the License.
 #include "delegate.h"
 
+#include <pxr/base/work/loops.h>
+
+#include <pxr/imaging/hd/changeTracker.h>
+#include <pxr/imaging/hd/renderIndex.h>
+#include <pxr/imaging/hd/tokens.h>
+
 #include "adapter_registry.h"
 
 #include <constant_strings.h>
 
+#include <vector>
+
 PXR_NAMESPACE_OPEN_SCOPE
 
+namespace {
+
+/// Returns the cached value, or updates it if the Arnold node was marked dirty or its data changed since it was cached.
+template <typename T, typename F>
+inline const T& _GetCachedValue(
+    T& value, uint64_t& cachedVersion, uint64_t& cachedHash, uint64_t version, uint64_t hash, F&& f)
+{
+    if (cachedVersion != version || cachedHash != hash) {
+        value = f();
+        cachedVersion = version;
+        cachedHash = hash;
+    }
+    return value;
+}
+
+// Only checking for ASCII digits, constructing an std::locale for each node is expensive.
+inline bool _IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+/// Converts an Arnold node name to a relative SdfPath string, replacing characters that are not valid in SdfPaths.
+void _SanitizeNodeName(std::string& path)
+{
+    for (size_t i = 0; i < path.length(); ++i) {
+        char& c = path[i];
+        if (c == '|') {
+            c = '/';
+        } else if (c == '@' || c == '.' || c == ':' || c == '-') {
+            c = '_';
+        }
+        // If the first character after each '/' is a digit, USD will complain.
+        // We'll insert a dummy character in that case
+        if (path[i] == '/' && i < (path.length() - 1) && _IsDigit(path[i + 1])) {
+            path.insert(i + 1, 1, '_');
+            i++;
+        }
+    }
+}
+
+} // namespace
+
 ImagingArnoldDelegate::ImagingArnoldDelegate(HdRenderIndex* parentIndex, const SdfPath& delegateID)
     : HdSceneDelegate(parentIndex, delegateID), _proxy(this)
 {
@@ -43,7 +90,13 @@ bool ImagingArnoldDelegate::IsEnabled(const TfToken& option) const
 HdMeshTopology ImagingArnoldDelegate::GetMeshTopology(const SdfPath& id)
 {
     auto* entry = TfMapLookupPtr(_primEntries, id);
-    return Ai_unlikely(entry == nullptr) ? HdMeshTopology() : entry->adapter->GetMeshTopology(entry->node);
+    if (Ai_unlikely(entry == nullptr)) {
+        return {};
+    }
+    return _GetCachedValue(
+        entry->topology.value, entry->topology.version, entry->topology.hash, entry->version,
+        entry->adapter->GetSourceHash(entry->node, HdTokens->topology),
+        [entry]() { return entry->adapter->GetMeshTopology(entry->node); });
 }
 
 HdBasisCurvesTopology ImagingArnoldDelegate::GetBasisCurvesTopology(const SdfPath& id) { return {}; }
@@ -52,9 +105,14 @@ PxOsdSubdivTags ImagingArnoldDelegate::GetSubdivTags(const SdfPath& id) { return
 
 GfRange3d ImagingArnoldDelegate::GetExtent(const SdfPath& id)
 {
-    // TODO(pal): Should we cache this? Or we expect the render delegates to cache?
     auto* entry = TfMapLookupPtr(_primEntries, id);
-    return Ai_unlikely(entry == nullptr) ? GfRange3d{} : entry->adapter->GetExtent(entry->node);
+    if (Ai_unlikely(entry == nullptr)) {
+        return {};
+    }
+    return _GetCachedValue(
+        entry->extent.value, entry->extent.version, entry->extent.hash, entry->version,
+        entry->adapter->GetSourceHash(entry->node, HdTokens->extent),
+        [entry]() { return entry->adapter->GetExtent(entry->node); });
 }
 
 GfMatrix4d ImagingArnoldDelegate::GetTransform(const SdfPath& id)
@@ -76,7 +134,17 @@ HdDisplayStyle ImagingArnoldDelegate::GetDisplayStyle(const SdfPath& id) { retur
 VtValue ImagingArnoldDelegate::Get(const SdfPath& id, const TfToken& key)
 {
     auto* entry = TfMapLookupPtr(_primEntries, id);
-    return Ai_unlikely(entry == nullptr) ? VtValue{} : entry->adapter->Get(entry->node, key);
+    if (Ai_unlikely(entry == nullptr)) {
+        return {};
+    }
+    // Points are the largest values queried and are requested on every sync.
+    if (key == HdTokens->points) {
+        return _GetCachedValue(
+            entry->points.value, entry->points.version, entry->points.hash, entry->version,
+            entry->adapter->GetSourceHash(entry->node, key),
+            [entry, &key]() { return entry->adapter->Get(entry->node, key); });
+    }
+    return entry->adapter->Get(entry->node, key);
 }
 
 HdReprSelector ImagingArnoldDelegate::GetReprSelector(const SdfPath& id) { return HdReprSelector{}; }
@@ -178,11 +246,21 @@ TfTokenVector ImagingArnoldDelegate::GetTaskRenderTags(const SdfPath& taskId) {}
 
 void ImagingArnoldDelegate::Populate(AtUniverse* universe)
 {
-    // Does it make sense to parallelize this? It should be pretty lightweight, and most of the render index
-    // insertion would need to be locked anyway.
-    // For example, UsdImagingDelegate caches lots of the values when Populating the scene, we don't use an intermediate
-    // cache, just do the conversions on the fly.
+    // Populating happens in three steps. First we gather the nodes and look up the adapter factories for each node
+    // type, which is cheap as most universes only use a handful of node types. Then paths and adapters are created
+    // in parallel, and finally the primitives are inserted into the render index, which is not thread safe.
+    // Topology and points are converted on the fly and cached on first use, extents are computed in parallel
+    // once all the primitives are inserted. Cached values are refreshed when the hash of the Arnold data they were
+    // computed from changes, so nodes edited after populating are picked up without marking the prims dirty.
+    struct NodeToPopulate {
+        AtNode* node;
+        const ImagingArnoldPrimAdapterFactoryBase* factory;
+        ImagingArnoldPrimAdapterPtr adapter;
+        SdfPath id;
+    };
     const auto& registry = ImagingArnoldAdapterRegistry::GetInstance();
+    std::unordered_map<const AtNodeEntry*, const ImagingArnoldPrimAdapterFactoryBase*> factories;
+    std::vector<NodeToPopulate> nodes;
     auto* nodeIter = AiUniverseGetNodeIterator(universe, AI_NODE_SHAPE | AI_NODE_CAMERA);
     while (!AiNodeIteratorFinished(nodeIter)) {
         auto* node = AiNodeIteratorGetNext(nodeIter);
@@ -191,41 +269,113 @@ void ImagingArnoldDelegate::Populate(AtUniverse* universe)
             continue;
         }
         const auto* nodeEntry = AiNodeGetNodeEntry(node);
-        auto adapter = registry.FindAdapter(AiNodeEntryGetNameAtString(nodeEntry));
-        if (adapter == nullptr || !adapter->IsSupported(&_proxy)) {
+        auto factoryIt = factories.find(nodeEntry);
+        if (factoryIt == factories.end()) {
+            const auto* factory = registry.FindAdapterFactory(AiNodeEntryGetNameAtString(nodeEntry));
+            if (factory != nullptr) {
+                auto adapter = factory->Create();
+                if (adapter == nullptr || !adapter->IsSupported(&_proxy)) {
+                    factory = nullptr;
+                }
+            }
+            factoryIt = factories.emplace(nodeEntry, factory).first;
+        }
+        if (factoryIt->second != nullptr) {
+            nodes.push_back({node, factoryIt->second, nullptr, SdfPath{}});
+        }
+    }
+    AiNodeIteratorDestroy(nodeIter);
+
+    WorkParallelForN(nodes.size(), [&](size_t begin, size_t end) {
+        for (auto i = begin; i < end; ++i) {
+            auto& node = nodes[i];
+            node.id = GetIdFromNode(node.node);
+            node.adapter = node.factory->Create();
+        }
+    });
+    // Parent ids are only shared between the nodes of a single populate call, so the cache does not keep growing
+    // with the names of every universe populated.
+    _parentIds.clear();
+
+    std::vector<PrimEntry*> newEntries;
+    newEntries.reserve(nodes.size());
+    _primEntries.reserve(_primEntries.size() + nodes.size());
+    for (auto& node : nodes) {
+        if (node.id.IsEmpty()) {
+            continue;
+        }
+        auto inserted = _primEntries.emplace(node.id, PrimEntry{node.adapter, node.node});
+        if (!inserted.second) {
             continue;
         }
-        const auto id = GetIdFromNode(node);
         // We expect every prim adapter to only create a single prim.
-        adapter->Populate(node, &_proxy, id);
-        _primEntries.emplace(id, PrimEntry{adapter, node});
+        node.adapter->Populate(node.node, &_proxy, node.id);
+        newEntries.push_back(&inserted.first->second);
     }
+
+    // Pointers to the values of an unordered_map are stable, and each task only touches its own entries.
+    WorkParallelForN(newEntries.size(), [&newEntries](size_t begin, size_t end) {
+        for (auto i = begin; i < end; ++i) {
+            auto* entry = newEntries[i];
+            entry->extent.value = entry->adapter->GetExtent(entry->node);
+            entry->extent.version = entry->version;
+            entry->extent.hash = entry->adapter->GetSourceHash(entry->node, HdTokens->extent);
+        }
+    });
 }
 
-SdfPath ImagingArnoldDelegate::GetIdFromNodeName(const std::string& name)
+void ImagingArnoldDelegate::MarkPrimDirty(const SdfPath& id, HdDirtyBits dirtyBits)
 {
-    auto path = name;
-    // Paths have to start with /
-    if (path.front() == '/') {
-        path = name.substr(1);
+    auto* entry = TfMapLookupPtr(_primEntries, id);
+    if (Ai_unlikely(entry == nullptr)) {
+        return;
+    }
+    entry->version += 1;
+    auto& changeTracker = GetRenderIndex().GetChangeTracker();
+    if (GetRenderIndex().GetRprim(id) != nullptr) {
+        changeTracker.MarkRprimDirty(id, dirtyBits);
+    } else {
+        changeTracker.MarkSprimDirty(id, dirtyBits);
     }
+}
 
-    std::locale loc;
+SdfPath ImagingArnoldDelegate::GetIdFromNodeName(const std::string& name)
+{
+    if (name.empty()) {
+        return {};
+    }
+    // Paths have to start with /
+    return _GetIdFromNodeName(name.front() == '/' ? name.substr(1) : name);
+}
 
-    for (size_t i = 0; i < path.length(); ++i) {
-        char& c = path[i];
-        if (c == '|') {
-            c = '/';
-        } else if (c == '@' || c == '.' || c == ':' || c == '-') {
-            c = '_';
+SdfPath ImagingArnoldDelegate::_GetIdFromNodeName(const std::string& name)
+{
+    // Nodes in large universes are usually organized in hierarchies, so the parent of each node is converted once and
+    // cached, and only the last component is sanitized for each node.
+    const auto separator = name.find_last_of("|/");
+    if (separator != std::string::npos && separator > 0 && separator < name.length() - 1) {
+        const auto parentName = name.substr(0, separator);
+        SdfPath parentId;
+        const auto cachedParentId = _parentIds.find(parentName);
+        if (cachedParentId != _parentIds.end()) {
+            parentId = cachedParentId->second;
+        } else {
+            parentId = _GetIdFromNodeName(parentName);
+            _parentIds.insert({parentName, parentId});
         }
-        // If the first character after each '/' is a digit, USD will complain.
-        // We'll insert a dummy character in that case
-        if (path[i] == '/' && i < (path.length() - 1) && std::isdigit(path[i + 1], loc)) {
-            path.insert(i + 1, 1, '_');
-            i++;
+        auto childName = name.substr(separator + 1);
+        _SanitizeNodeName(childName);
+        // If the first character of the component is a digit, USD will complain.
+        if (_IsDigit(childName.front())) {
+            childName.insert(0, 1, '_');
+        }
+        if (!parentId.IsEmpty() && SdfPath::IsValidIdentifier(childName)) {
+            return parentId.AppendChild(TfToken{childName});
         }
     }
+    // Root level nodes and names that are not valid identifiers are converted as a single path.
+    auto path = name;
+    _SanitizeNodeName(path);
     return GetDelegateID().AppendPath(SdfPath{path});
 }
 
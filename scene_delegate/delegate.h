@@ -26,6 +26,9 @@
 #include "delegate_proxy.h"
 #include "prim_adapter.h"
 
+#include <tbb/concurrent_unordered_map.h>
+
+#include <cstdint>
 #include <unordered_map>
 
 PXR_NAMESPACE_OPEN_SCOPE
@@ -68,6 +71,8 @@ public:
 
     /// Gets the mesh topology.
     ///
+    /// The topology is cached until the Arnold node changes.
+    ///
     /// @param id Path to the Hydra mesh primitive.
     /// @return Hydra mesh topology of the primitive.
     IMAGINGARNOLD_API
@@ -93,7 +98,7 @@ public:
 
     /// Gets the extent.
     ///
-    /// Currently returns an extent between -AI_BIG and AI_BIG.
+    /// Extents are computed when populating the render index and cached until the Arnold node changes.
     ///
     /// @param id Path to the Hydra primitive.
     /// @return Extent of the primitive.
@@ -154,6 +159,8 @@ public:
 
     /// Gets a named value.
     ///
+    /// Points are cached until the Arnold node changes.
+    ///
     /// @param id Path to the Hydra primitive.
     /// @param key Name of the value.
     /// @return Named value if it exists on the primitive, an empty VtValue otherwise.
@@ -417,6 +424,8 @@ public:
 
     /// Populating the Render Index from the Arnold universe.
     ///
+    /// Paths and adapters are created in parallel, then the primitives are inserted into the render index.
+    ///
     /// @param universe Input universe to use for populating the render index.
     IMAGINGARNOLD_API
     virtual void Populate(AtUniverse* universe);
@@ -435,18 +444,58 @@ public:
     IMAGINGARNOLD_API
     SdfPath GetIdFromNode(const AtNode* node);
 
+    /// Notifies the scene delegate that the Arnold node of a primitive has changed.
+    ///
+    /// Increments the change counter of the primitive, which invalidates the cached topology, points and extent, then
+    /// marks the primitive dirty in the change tracker. Cached values are also refreshed when the Arnold data they
+    /// were computed from changes, but Hydra only queries primitives marked dirty, so hosts editing Arnold nodes after
+    /// populating should call this function.
+    ///
+    /// @param id Path to the Hydra primitive.
+    /// @param dirtyBits Dirty bits to set on the primitive.
+    IMAGINGARNOLD_API
+    void MarkPrimDirty(const SdfPath& id, HdDirtyBits dirtyBits = HdChangeTracker::AllDirty);
+
 private:
+    /// Gets a path to the prim in the Hydra render index from an Arnold Node name without the leading /.
+    ///
+    /// Paths of parent names are cached, so siblings only sanitize their own name.
+    ///
+    /// @param name Name of the arnold node without the leading /.
+    /// @return Path to the primitive in the Hydra render index.
+    SdfPath _GetIdFromNodeName(const std::string& name);
+
+    /// Utility struct to hold a value cached for a given version of an Arnold node.
+    template <typename T>
+    struct CachedValue {
+        T value;              ///< Cached value.
+        uint64_t version = 0; ///< Change counter of the Arnold node when the value was cached, 0 if never cached.
+        uint64_t hash = 0;    ///< Hash of the Arnold data the value was computed from.
+    };
+
     /// Utility struct to hold a primitive entry.
+    ///
+    /// Hydra syncs each primitive from a single thread, so the caches are not guarded.
     struct PrimEntry {
         PrimEntry(ImagingArnoldPrimAdapterPtr _adapter, AtNode* _node) : adapter(_adapter), node(_node) {}
         /// Pointer to the adapter.
         ImagingArnoldPrimAdapterPtr adapter;
         /// Pointer to the Arnold node.
         AtNode* node = nullptr;
+        /// Change counter of the Arnold node, incremented each time the node is marked dirty.
+        uint64_t version = 1;
+        /// Cached mesh topology.
+        CachedValue<HdMeshTopology> topology;
+        /// Cached points.
+        CachedValue<VtValue> points;
+        /// Cached extent.
+        CachedValue<GfRange3d> extent;
     };
 
     /// List of primitive entries.
     std::unordered_map<SdfPath, PrimEntry, SdfPath::Hash> _primEntries;
+    /// Paths of the parent names, safe to access from multiple threads when populating, cleared after populating.
+    tbb::concurrent_unordered_map<std::string, SdfPath> _parentIds;
     /// Proxy delegate for the adapters.
     ImagingArnoldDelegateProxy _proxy;
 };
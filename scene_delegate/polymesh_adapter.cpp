@@ -13,6 +13,8 @@
 // limitations under the License.
 #include "polymesh_adapter.h"
 
+#include <pxr/base/arch/hash.h>
+#include <pxr/base/gf/range3f.h>
 #include <pxr/base/tf/type.h>
 
 #include <pxr/imaging/hd/tokens.h>
@@ -21,6 +23,26 @@
 
 PXR_NAMESPACE_OPEN_SCOPE
 
+namespace {
+
+/// Hashes the contents of an Arnold array, including all of its keys.
+uint64_t _HashArray(const AtArray* array, uint64_t seed)
+{
+    if (array == nullptr) {
+        return seed;
+    }
+    const auto dataSize = static_cast<size_t>(AiArrayGetKeySize(array)) * AiArrayGetNumKeys(array);
+    if (dataSize == 0) {
+        return seed;
+    }
+    auto* mutableArray = const_cast<AtArray*>(array);
+    const auto hash = ArchHash64(static_cast<const char*>(AiArrayMap(mutableArray)), dataSize, seed);
+    AiArrayUnmap(mutableArray);
+    return hash;
+}
+
+} // namespace
+
 DEFINE_SHARED_ADAPTER_FACTORY(ImagingArnoldPolymeshAdapter)
 
 bool ImagingArnoldPolymeshAdapter::IsSupported(ImagingArnoldDelegateProxy* proxy) const
@@ -61,6 +83,25 @@ HdMeshTopology ImagingArnoldPolymeshAdapter::GetMeshTopology(const AtNode* node)
     return topology;
 }
 
+GfRange3d ImagingArnoldPolymeshAdapter::GetExtent(const AtNode* node) const
+{
+    auto* vlistArray = AiNodeGetArray(node, str::vlist);
+    if (vlistArray == nullptr || AiArrayGetNumKeys(vlistArray) < 1) {
+        return {};
+    }
+    const auto numElements = AiArrayGetNumElements(vlistArray);
+    if (numElements < 1) {
+        return {};
+    }
+    const auto* vlist = static_cast<const GfVec3f*>(AiArrayMap(vlistArray));
+    GfRange3f extent;
+    for (auto i = decltype(numElements){0}; i < numElements; i += 1) {
+        extent.UnionWith(vlist[i]);
+    }
+    AiArrayUnmap(vlistArray);
+    return GfRange3d{extent.GetMin(), extent.GetMax()};
+}
+
 HdPrimvarDescriptorVector ImagingArnoldPolymeshAdapter::GetPrimvarDescriptors(
     const AtNode* node, HdInterpolation interpolation) const
 {
@@ -98,4 +139,16 @@ VtValue ImagingArnoldPolymeshAdapter::Get(const AtNode* node, const TfToken& key
     return {};
 }
 
+uint64_t ImagingArnoldPolymeshAdapter::GetSourceHash(const AtNode* node, const TfToken& key) const
+{
+    // Hashing the arrays is a single pass over memory that is already laid out, which is much cheaper than
+    // converting them, and it catches edits made with both AiNodeSetArray and writes to mapped arrays.
+    if (key == HdTokens->topology) {
+        return _HashArray(AiNodeGetArray(node, str::vidxs), _HashArray(AiNodeGetArray(node, str::nsides), 1));
+    } else if (key == HdTokens->points || key == HdTokens->extent) {
+        return _HashArray(AiNodeGetArray(node, str::vlist), 1);
+    }
+    return 0;
+}
+
 PXR_NAMESPACE_CLOSE_SCOPE
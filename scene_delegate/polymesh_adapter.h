@@ -52,6 +52,15 @@ public:
     IMAGINGARNOLD_API
     HdMeshTopology GetMeshTopology(const AtNode* node) const override;
 
+    /// Gets the extent of an Arnold polymesh.
+    ///
+    /// The extent is computed from the first key of the vertex positions.
+    ///
+    /// @param node Pointer to the Arnold polymesh node.
+    /// @return Extent of the polymesh, an empty range if the polymesh has no vertices.
+    IMAGINGARNOLD_API
+    GfRange3d GetExtent(const AtNode* node) const override;
+
     /// Gets the primvar descriptors of an Arnold polymesh.
     ///
     /// @param node Pointer to the Arnold polymesh.
@@ -67,6 +76,16 @@ public:
     /// @return Value of a given name named value, empty VtValue if not available.
     IMAGINGARNOLD_API
     VtValue Get(const AtNode* node, const TfToken& key) const override;
+
+    /// Gets a hash of the Arnold polymesh data a cached value is computed from.
+    ///
+    /// The topology is computed from nsides and vidxs, the points and the extent from vlist.
+    ///
+    /// @param node Pointer to the Arnold polymesh.
+    /// @param key Name of the cached value.
+    /// @return Hash of the arrays the value is computed from, 0 for unknown values.
+    IMAGINGARNOLD_API
+    uint64_t GetSourceHash(const AtNode* node, const TfToken& key) const override;
 };
 
 PXR_NAMESPACE_CLOSE_SCOPE
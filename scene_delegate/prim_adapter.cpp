@@ -82,4 +82,6 @@ VtValue ImagingArnoldPrimAdapter::Get(const AtNode* node, const TfToken& key) co
     return {};
 }
 
+uint64_t ImagingArnoldPrimAdapter::GetSourceHash(const AtNode* node, const TfToken& key) const { return 0; }
+
 PXR_NAMESPACE_CLOSE_SCOPE
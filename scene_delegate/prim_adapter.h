@@ -106,6 +106,17 @@ public:
     /// @return Value of a given name named value, empty VtValue if not available.
     IMAGINGARNOLD_API
     virtual VtValue Get(const AtNode* node, const TfToken& key) const;
+
+    /// Gets a hash of the Arnold data a value cached by the scene delegate is computed from.
+    ///
+    /// The scene delegate compares the hash each time a cached value is queried, so the value is refreshed when the
+    /// Arnold node is edited after populating.
+    ///
+    /// @param node Pointer to the Arnold node.
+    /// @param key Name of the cached value, HdTokens->topology, HdTokens->points or HdTokens->extent.
+    /// @return Hash of the data the value is computed from, 0 if the value does not depend on the Arnold node.
+    IMAGINGARNOLD_API
+    virtual uint64_t GetSourceHash(const AtNode* node, const TfToken& key) const;
 };
 
 using ImagingArnoldPrimAdapterPtr = std::shared_ptr<ImagingArnoldPrimAdapter>;
@@ -57,6 +57,48 @@ TEST(HdArnoldSetRadiusFromValue, SettingMultipleRadius)
     EXPECT_EQ(std::vector<float>({2.0f, 4.0f, 8.0f, 16.0f}), getRadii());
 }
 
+TEST(ArnoldUsdCurvesData, RemapCurvesVertexPrimvar)
+{
+    // Bezier curves with two and one segments.
+    const VtIntArray vertexCounts{7, 4};
+    ArnoldUsdCurvesData curvesData(4, 3, vertexCounts);
+    VtValue floats{VtFloatArray{0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 10.0f, 11.0f, 12.0f, 13.0f}};
+    ASSERT_TRUE(curvesData.RemapCurvesVertexPrimvar<float>(floats));
+    EXPECT_EQ(floats.Get<VtFloatArray>(), VtFloatArray({0.0f, 3.0f, 6.0f, 10.0f, 13.0f}));
+    // Types that can't be interpolated use the closest value.
+    VtValue ints{VtIntArray{0, 1, 2, 3, 4, 5, 6, 10, 11, 12, 13}};
+    ASSERT_TRUE((curvesData.RemapCurvesVertexPrimvar<float, int>(ints)));
+    EXPECT_EQ(ints.Get<VtIntArray>(), VtIntArray({0, 3, 6, 10, 13}));
+    // Values with the wrong number of elements are left untouched.
+    VtValue wrongSize{VtFloatArray{0.0f, 1.0f, 2.0f}};
+    ASSERT_TRUE(curvesData.RemapCurvesVertexPrimvar<float>(wrongSize));
+    EXPECT_EQ(wrongSize.Get<VtFloatArray>().size(), size_t{3});
+    // Unsupported types are not remapped.
+    VtValue doubles{VtDoubleArray{0.0, 1.0}};
+    EXPECT_FALSE(curvesData.RemapCurvesVertexPrimvar<float>(doubles));
+}
+
+TEST(ArnoldUsdCurvesData, RemapCurvesVertexPrimvarManyCurves)
+{
+    // Enough curves to remap them in parallel.
+    constexpr int numCurves = 10000;
+    VtIntArray vertexCounts(numCurves, 7);
+    VtFloatArray original(numCurves * 7);
+    VtFloatArray expected(numCurves * 3);
+    for (auto curve = 0; curve < numCurves; curve += 1) {
+        for (auto vertex = 0; vertex < 7; vertex += 1) {
+            original[curve * 7 + vertex] = static_cast<float>(curve * 10 + vertex);
+        }
+        expected[curve * 3] = static_cast<float>(curve * 10);
+        expected[curve * 3 + 1] = static_cast<float>(curve * 10 + 3);
+        expected[curve * 3 + 2] = static_cast<float>(curve * 10 + 6);
+    }
+    ArnoldUsdCurvesData curvesData(4, 3, vertexCounts);
+    VtValue value{original};
+    ASSERT_TRUE(curvesData.RemapCurvesVertexPrimvar<float>(value));
+    EXPECT_EQ(value.Get<VtFloatArray>(), expected);
+}
+
 int main(int argc, char** argv)
 {
     testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+
+#include "render_delegate/frame_rate_scheduler.h"
+
+#include <cmath>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+using Clock = HdArnoldFrameRateScheduler::Clock;
+using Settings = HdArnoldFrameRateScheduler::Settings;
+
+namespace {
+
+Clock::duration _Seconds(float seconds)
+{
+    return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(seconds));
+}
+
+// Very simple model of the renderer, the time to the first pixels scales with the number of pixels rendered in the
+// first pass, and smaller buckets keep more threads busy.
+struct SimulatedRenderer {
+    float fullResolutionTime = 1.0f;
+
+    float GetLatency(int aaSamples, int bucketSize) const
+    {
+        const auto pixels = aaSamples < 0 ? 1.0f / static_cast<float>(aaSamples * aaSamples)
+                                          : static_cast<float>(aaSamples * aaSamples);
+        return fullResolutionTime * pixels * (0.5f + static_cast<float>(bucketSize) / 128.0f);
+    }
+};
+
+// Simulates tumbling the camera, rendering is restarted on every viewport frame and the first pixels only show up if
+// they arrive before the next restart.
+void _Tumble(
+    HdArnoldFrameRateScheduler& scheduler, const SimulatedRenderer& renderer, Clock::time_point& now, int frames,
+    float fps = 30.0f)
+{
+    const auto frameTime = 1.0f / fps;
+    for (auto frame = 0; frame < frames; frame += 1) {
+        scheduler.Restart(now);
+        const auto latency = renderer.GetLatency(scheduler.GetAASamples(), scheduler.GetBucketSize());
+        if (latency < frameTime) {
+            scheduler.Update(now + _Seconds(latency));
+        }
+        now += _Seconds(frameTime);
+    }
+}
+
+} // namespace
+
+TEST(HdArnoldFrameRateScheduler, IdleRestartsUseUserSettings)
+{
+    HdArnoldFrameRateScheduler scheduler;
+    Clock::time_point now{};
+    scheduler.Restart(now);
+    EXPECT_FALSE(scheduler.IsInteractive());
+    EXPECT_EQ(scheduler.GetAASamples(), -4);
+    EXPECT_EQ(scheduler.GetBucketSize(), 64);
+    // Slow first pixels for idle restarts do not change the interactive settings.
+    scheduler.Update(now + _Seconds(1.0f));
+    EXPECT_EQ(scheduler.GetLatency(), 0.0f);
+    now += _Seconds(2.0f);
+    scheduler.Restart(now);
+    EXPECT_FALSE(scheduler.IsInteractive());
+    EXPECT_EQ(scheduler.GetAASamples(), -4);
+    EXPECT_EQ(scheduler.GetBucketSize(), 64);
+}
+
+TEST(HdArnoldFrameRateScheduler, RecordedSequence)
+{
+    HdArnoldFrameRateScheduler scheduler;
+    Clock::time_point now{};
+    // Restart, first pixels, restart, first pixels, etc. recorded while tumbling a heavy scene.
+    enum class Event { Restart, Update };
+    const std::vector<std::pair<Event, float>> events{
+        {Event::Restart, 0.0f},   {Event::Update, 0.2f},   {Event::Restart, 0.25f}, {Event::Update, 0.4f},
+        {Event::Restart, 0.42f},  {Event::Update, 0.5f},   {Event::Restart, 0.55f}, {Event::Update, 0.57f},
+        {Event::Restart, 0.58f},  {Event::Restart, 0.7f},
+    };
+    std::vector<int> aaSamples;
+    for (const auto& event : events) {
+        if (event.first == Event::Restart) {
+            scheduler.Restart(now + _Seconds(event.second));
+            aaSamples.push_back(scheduler.GetAASamples());
+        } else {
+            scheduler.Update(now + _Seconds(event.second));
+        }
+    }
+    // First restart is idle, the next ones lower the quality until the first pixels arrive in time. The restart at
+    // 0.7 lowers the quality as well, because the previous restart did not produce any pixels for too long, and the
+    // AA samples are already at the minimum.
+    EXPECT_EQ(aaSamples, std::vector<int>({-4, -4, -5, -6, -6, -6}));
+    EXPECT_EQ(scheduler.GetBucketSize(), 32);
+}
+
+TEST(HdArnoldFrameRateScheduler, LowersQualityOnSlowRenders)
+{
+    HdArnoldFrameRateScheduler scheduler;
+    SimulatedRenderer renderer;
+    renderer.fullResolutionTime = 2.0f;
+    Clock::time_point now{};
+    _Tumble(scheduler, renderer, now, 60);
+    EXPECT_TRUE(scheduler.IsInteractive());
+    // AA samples are lowered first, then the bucket size, until the first pixels arrive before the next restart.
+    EXPECT_EQ(scheduler.GetAASamples(), -6);
+    EXPECT_EQ(scheduler.GetBucketSize(), 8);
+    EXPECT_LE(renderer.GetLatency(scheduler.GetAASamples(), scheduler.GetBucketSize()), 1.0f / 30.0f);
+    // Never going below the minimums, even if the target is not met.
+    renderer.fullResolutionTime = 100.0f;
+    _Tumble(scheduler, renderer, now, 60);
+    EXPECT_EQ(scheduler.GetAASamples(), -6);
+    EXPECT_EQ(scheduler.GetBucketSize(), 8);
+}
+
+TEST(HdArnoldFrameRateScheduler, RaisesQualityOnFastRenders)
+{
+    HdArnoldFrameRateScheduler scheduler;
+    SimulatedRenderer renderer;
+    renderer.fullResolutionTime = 0.05f;
+    Clock::time_point now{};
+    _Tumble(scheduler, renderer, now, 60);
+    EXPECT_TRUE(scheduler.IsInteractive());
+    EXPECT_EQ(scheduler.GetAASamples(), -1);
+    EXPECT_EQ(scheduler.GetBucketSize(), 64);
+}
+
+TEST(HdArnoldFrameRateScheduler, SkipsZeroAASamples)
+{
+    Settings settings;
+    settings.progressiveMinAASamples = -2;
+    settings.maxAASamples = 2;
+    HdArnoldFrameRateScheduler scheduler(settings);
+    SimulatedRenderer renderer;
+    renderer.fullResolutionTime = 0.001f;
+    Clock::time_point now{};
+    std::vector<int> aaSamples;
+    for (auto frame = 0; frame < 30; frame += 1) {
+        _Tumble(scheduler, renderer, now, 1);
+        if (aaSamples.empty() || aaSamples.back() != scheduler.GetAASamples()) {
+            aaSamples.push_back(scheduler.GetAASamples());
+        }
+    }
+    EXPECT_EQ(aaSamples, std::vector<int>({-2, -1, 1, 2}));
+}
+
+TEST(HdArnoldFrameRateScheduler, ReturnsToIdleSettings)
+{
+    HdArnoldFrameRateScheduler scheduler;
+    SimulatedRenderer renderer;
+    renderer.fullResolutionTime = 2.0f;
+    Clock::time_point now{};
+    _Tumble(scheduler, renderer, now, 60);
+    ASSERT_TRUE(scheduler.IsInteractive());
+    ASSERT_EQ(scheduler.GetAASamples(), -6);
+    // A single change after the user stopped interacting renders with the user settings.
+    now += _Seconds(1.0f);
+    scheduler.Restart(now);
+    EXPECT_FALSE(scheduler.IsInteractive());
+    EXPECT_EQ(scheduler.GetAASamples(), -4);
+    EXPECT_EQ(scheduler.GetBucketSize(), 64);
+    // Interacting again starts from the settings measured previously.
+    now += _Seconds(0.1f);
+    scheduler.Restart(now);
+    EXPECT_TRUE(scheduler.IsInteractive());
+    EXPECT_EQ(scheduler.GetAASamples(), -6);
+    EXPECT_EQ(scheduler.GetBucketSize(), 8);
+}
+
+TEST(HdArnoldFrameRateScheduler, Disabled)
+{
+    Settings settings;
+    settings.enabled = false;
+    HdArnoldFrameRateScheduler scheduler(settings);
+    SimulatedRenderer renderer;
+    renderer.fullResolutionTime = 2.0f;
+    Clock::time_point now{};
+    _Tumble(scheduler, renderer, now, 60);
+    EXPECT_FALSE(scheduler.IsInteractive());
+    EXPECT_EQ(scheduler.GetAASamples(), -4);
+    EXPECT_EQ(scheduler.GetBucketSize(), 64);
+    EXPECT_EQ(scheduler.GetLatency(), 0.0f);
+}
+
+TEST(HdArnoldFrameRateScheduler, UpdatesWithoutRestartAreIgnored)
+{
+    HdArnoldFrameRateScheduler scheduler;
+    Clock::time_point now{};
+    scheduler.Restart(now);
+    scheduler.Restart(now + _Seconds(0.01f));
+    scheduler.Update(now + _Seconds(0.02f));
+    const auto latency = scheduler.GetLatency();
+    const auto aaSamples = scheduler.GetAASamples();
+    // Progressive passes after the first one keep sending updates.
+    scheduler.Update(now + _Seconds(5.0f));
+    scheduler.Update(now + _Seconds(10.0f));
+    EXPECT_EQ(scheduler.GetLatency(), latency);
+    EXPECT_EQ(scheduler.GetAASamples(), aaSamples);
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include <pxr/base/tf/token.h>
+#include <pxr/base/vt/value.h>
+
+#include "render_delegate/volume_registry.h"
+
+#include <constant_strings.h>
+
+#include <ai.h>
+
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+TEST(HdArnoldVolumeRegistry, SharesVolumes)
+{
+    HdArnoldVolumeRegistry registry;
+    auto setupCount = 0;
+    const auto setupVolume = [&setupCount](AtNode* volume) {
+        AiNodeSetFlt(volume, str::step_size, 0.5f);
+        setupCount += 1;
+    };
+    const std::vector<TfToken> grids{TfToken{"density"}, TfToken{"temperature"}};
+    const std::vector<TfToken> reversedGrids{TfToken{"temperature"}, TfToken{"density"}};
+    const HdArnoldVolumeRegistry::Parameters stepSize{{TfToken{"arnold:step_size"}, VtValue{0.25f}}};
+    auto* volume0 = registry.Acquire(nullptr, "explosion.vdb", grids, {}, setupVolume);
+    ASSERT_NE(volume0, nullptr);
+    EXPECT_EQ(AiNodeGetStr(volume0, str::filename), AtString("explosion.vdb"));
+    EXPECT_EQ(AiNodeGetByte(volume0, str::visibility), 0);
+    EXPECT_EQ(AiNodeGetFlt(volume0, str::step_size), 0.5f);
+    // The order of the grids does not matter.
+    auto* volume1 = registry.Acquire(nullptr, "explosion.vdb", reversedGrids, {}, setupVolume);
+    EXPECT_EQ(volume0, volume1);
+    EXPECT_EQ(setupCount, 1);
+    EXPECT_EQ(registry.GetNumVolumes(), 1);
+    // Different grids, files or parameters require a different volume.
+    auto* volume2 = registry.Acquire(nullptr, "explosion.vdb", {TfToken{"density"}}, {}, setupVolume);
+    auto* volume3 = registry.Acquire(nullptr, "smoke.vdb", {TfToken{"density"}}, {}, setupVolume);
+    auto* volume4 = registry.Acquire(nullptr, "smoke.vdb", {TfToken{"density"}}, stepSize, setupVolume);
+    EXPECT_NE(volume2, volume0);
+    EXPECT_NE(volume3, volume2);
+    EXPECT_NE(volume4, volume3);
+    EXPECT_EQ(registry.GetNumVolumes(), 4);
+    // Volumes are only shared when their parameters have the same values, in any order.
+    const HdArnoldVolumeRegistry::Parameters parameters{
+        {TfToken{"arnold:step_size"}, VtValue{0.25f}}, {TfToken{"arnold:velocity_scale"}, VtValue{2.0f}}};
+    const HdArnoldVolumeRegistry::Parameters reversedParameters{parameters[1], parameters[0]};
+    const HdArnoldVolumeRegistry::Parameters otherParameters{
+        {TfToken{"arnold:step_size"}, VtValue{0.25f}}, {TfToken{"arnold:velocity_scale"}, VtValue{3.0f}}};
+    auto* volume5 = registry.Acquire(nullptr, "smoke.vdb", {TfToken{"density"}}, parameters, setupVolume);
+    auto* volume6 = registry.Acquire(nullptr, "smoke.vdb", {TfToken{"density"}}, reversedParameters, setupVolume);
+    auto* volume7 = registry.Acquire(nullptr, "smoke.vdb", {TfToken{"density"}}, otherParameters, setupVolume);
+    EXPECT_EQ(volume5, volume6);
+    EXPECT_NE(volume5, volume4);
+    EXPECT_NE(volume7, volume5);
+    EXPECT_EQ(registry.GetNumVolumes(), 6);
+    registry.Release(volume5);
+    registry.Release(volume6);
+    registry.Release(volume7);
+    EXPECT_EQ(registry.GetNumVolumes(), 4);
+    // Volumes are destroyed when the last user releases them.
+    registry.Release(volume0);
+    EXPECT_EQ(registry.GetNumVolumes(), 4);
+    registry.Release(volume1);
+    EXPECT_EQ(registry.GetNumVolumes(), 3);
+    registry.Release(volume2);
+    registry.Release(volume3);
+    registry.Release(volume4);
+    EXPECT_EQ(registry.GetNumVolumes(), 0);
+    // Releasing unknown volumes is safe.
+    registry.Release(nullptr);
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    AiBegin();
+    AiMsgSetConsoleFlags(AI_LOG_NONE);
+    auto result = RUN_ALL_TESTS();
+    AiEnd();
+    return result;
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include "render_delegate/texture_prefetcher.h"
+
+#include <ai.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+TEST(HdArnoldTexturePrefetcher, NothingToPrefetch)
+{
+    HdArnoldTexturePrefetcher prefetcher;
+    EXPECT_EQ(prefetcher.GetProgress(), 1.0f);
+    // Waiting without any requests returns immediately.
+    prefetcher.Wait();
+    EXPECT_EQ(prefetcher.GetProgress(), 1.0f);
+}
+
+TEST(HdArnoldTexturePrefetcher, PrefetchesTextures)
+{
+    const std::string path = "texture_prefetcher_test.ppm";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "P6\n64 64\n255\n" << std::string(64 * 64 * 3, '\x7f');
+    }
+    HdArnoldTexturePrefetcher prefetcher;
+    prefetcher.Prefetch(path);
+    // Requesting the same texture or textures that don't exist is safe.
+    prefetcher.Prefetch(path);
+    prefetcher.Prefetch("missing_texture.exr");
+    // Paths with tokens can't be opened directly and are skipped.
+    prefetcher.Prefetch("texture.<UDIM>.exr");
+    prefetcher.Prefetch("");
+    prefetcher.Wait();
+    EXPECT_EQ(prefetcher.GetProgress(), 1.0f);
+    std::remove(path.c_str());
+}
+
+TEST(HdArnoldTexturePrefetcher, Disabled)
+{
+    HdArnoldTexturePrefetcher prefetcher;
+    EXPECT_TRUE(prefetcher.IsEnabled());
+    prefetcher.SetEnabled(false);
+    EXPECT_FALSE(prefetcher.IsEnabled());
+    prefetcher.Prefetch("missing_texture.exr");
+    prefetcher.Wait();
+    EXPECT_EQ(prefetcher.GetProgress(), 1.0f);
+}
+
+TEST(HdArnoldTexturePrefetcher, Cancel)
+{
+    HdArnoldTexturePrefetcher prefetcher;
+    prefetcher.Prefetch("missing_texture.exr");
+    prefetcher.Cancel();
+    // Requests after cancelling are ignored.
+    prefetcher.Prefetch("another_missing_texture.exr");
+    prefetcher.Wait();
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    AiBegin();
+    AiMsgSetConsoleFlags(AI_LOG_NONE);
+    auto result = RUN_ALL_TESTS();
+    AiEnd();
+    return result;
+}
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+
+#include "render_delegate/light_filter_registry.h"
+
+#include <constant_strings.h>
+
+#include <ai.h>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+TEST(HdArnoldLightFilterRegistry, SharesFilters)
+{
+    HdArnoldLightFilterRegistry registry;
+    auto* filter0 = registry.Acquire(
+        nullptr, str::barndoor, {{str::barndoor_left_top, 0.25f}, {str::barndoor_right_top, 0.75f}});
+    ASSERT_NE(filter0, nullptr);
+    EXPECT_TRUE(AiNodeIs(filter0, str::barndoor));
+    EXPECT_EQ(AiNodeGetFlt(filter0, str::barndoor_left_top), 0.25f);
+    EXPECT_EQ(AiNodeGetFlt(filter0, str::barndoor_right_top), 0.75f);
+    // Identical parameters return the same filter.
+    auto* filter1 = registry.Acquire(
+        nullptr, str::barndoor, {{str::barndoor_left_top, 0.25f}, {str::barndoor_right_top, 0.75f}});
+    EXPECT_EQ(filter0, filter1);
+    EXPECT_EQ(registry.GetNumFilters(), 1);
+    // Any difference in the parameters requires a different filter.
+    auto* filter2 = registry.Acquire(
+        nullptr, str::barndoor, {{str::barndoor_left_top, 0.25f}, {str::barndoor_right_top, 0.5f}});
+    auto* filter3 = registry.Acquire(nullptr, str::barndoor, {{str::barndoor_left_top, 0.25f}});
+    EXPECT_NE(filter2, filter0);
+    EXPECT_NE(filter3, filter0);
+    EXPECT_NE(filter3, filter2);
+    EXPECT_EQ(registry.GetNumFilters(), 3);
+    // Filters are destroyed when the last light releases them.
+    registry.Release(filter0);
+    EXPECT_EQ(registry.GetNumFilters(), 3);
+    registry.Release(filter1);
+    EXPECT_EQ(registry.GetNumFilters(), 2);
+    registry.Release(filter2);
+    registry.Release(filter3);
+    EXPECT_EQ(registry.GetNumFilters(), 0);
+    // Releasing unknown filters is safe.
+    registry.Release(nullptr);
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    AiBegin();
+    AiMsgSetConsoleFlags(AI_LOG_NONE);
+    auto result = RUN_ALL_TESTS();
+    AiEnd();
+    return result;
+}
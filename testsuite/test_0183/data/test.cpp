@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include "translator/writer/prim_writer.h"
+
+#include <ai.h>
+
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+
+// Fills each element of the array with a different value, so converting the wrong element or key is detected.
+template <typename T>
+AtArray* _CreateArray(unsigned int numElements, unsigned int numKeys, uint8_t type)
+{
+    auto* array = AiArrayAllocate(numElements, numKeys, type);
+    auto* data = static_cast<uint8_t*>(AiArrayMap(array));
+    const auto numBytes = static_cast<size_t>(numElements) * numKeys * sizeof(T);
+    for (size_t i = 0; i < numBytes; ++i) {
+        data[i] = static_cast<uint8_t>(i % 127);
+    }
+    AiArrayUnmap(array);
+    return array;
+}
+
+template <typename UsdT, typename ArnoldT = UsdT>
+void _TestConversion(uint8_t type, const char* typeName)
+{
+    const unsigned int numElements = 17;
+    const unsigned int numKeys = 3;
+    auto* array = _CreateArray<ArnoldT>(numElements, numKeys, type);
+    std::vector<VtArray<UsdT>> keys;
+    ConvertArnoldArrayKeys<UsdT, ArnoldT>(array, keys);
+    ASSERT_EQ(keys.size(), numKeys) << typeName;
+    const auto* arrayMap = static_cast<const ArnoldT*>(AiArrayMap(array));
+    for (unsigned int j = 0; j < numKeys; ++j) {
+        ASSERT_EQ(keys[j].size(), numElements) << typeName;
+        for (unsigned int i = 0; i < numElements; ++i) {
+            EXPECT_EQ(keys[j][i], static_cast<UsdT>(arrayMap[j * numElements + i])) << typeName;
+        }
+    }
+    AiArrayUnmap(array);
+    AiArrayDestroy(array);
+}
+
+} // namespace
+
+TEST(ConvertArnoldArrayKeys, ConvertsAllTypes)
+{
+    _TestConversion<unsigned char>(AI_TYPE_BYTE, "byte");
+    _TestConversion<int>(AI_TYPE_INT, "int");
+    _TestConversion<unsigned int>(AI_TYPE_UINT, "uint");
+    _TestConversion<int, unsigned int>(AI_TYPE_UINT, "uint to int");
+    _TestConversion<float>(AI_TYPE_FLOAT, "float");
+    _TestConversion<GfVec3f>(AI_TYPE_RGB, "rgb");
+    _TestConversion<GfVec3f>(AI_TYPE_VECTOR, "vector");
+    _TestConversion<GfVec4f>(AI_TYPE_RGBA, "rgba");
+    _TestConversion<GfVec2f>(AI_TYPE_VECTOR2, "vector2");
+}
+
+TEST(ConvertArnoldArrayKeys, ConvertsBooleans)
+{
+    auto* array = AiArrayAllocate(3, 2, AI_TYPE_BOOLEAN);
+    for (unsigned int i = 0; i < 6; ++i) {
+        AiArraySetBool(array, i, i % 3 == 1);
+    }
+    std::vector<VtArray<bool>> keys;
+    ConvertArnoldArrayKeys(array, keys);
+    ASSERT_EQ(keys.size(), 2);
+    EXPECT_EQ(keys[0], VtArray<bool>({false, true, false}));
+    EXPECT_EQ(keys[1], VtArray<bool>({false, true, false}));
+    AiArrayDestroy(array);
+}
+
+TEST(ConvertArnoldArrayKeys, ConvertsMatrices)
+{
+    auto* array = AiArrayAllocate(2, 2, AI_TYPE_MATRIX);
+    for (unsigned int i = 0; i < 4; ++i) {
+        auto matrix = AiM4Identity();
+        matrix[3][0] = static_cast<float>(i);
+        matrix[1][2] = 0.5f;
+        AiArraySetMtx(array, i, matrix);
+    }
+    std::vector<VtArray<GfMatrix4d>> keys;
+    ConvertArnoldArrayKeys(array, keys);
+    ASSERT_EQ(keys.size(), 2);
+    for (unsigned int j = 0; j < 2; ++j) {
+        ASSERT_EQ(keys[j].size(), 2);
+        for (unsigned int i = 0; i < 2; ++i) {
+            auto expected = GfMatrix4d(1.0);
+            expected[3][0] = static_cast<double>(j * 2 + i);
+            expected[1][2] = 0.5;
+            EXPECT_EQ(keys[j][i], expected);
+        }
+    }
+    AiArrayDestroy(array);
+}
+
+TEST(ConvertArnoldArray, ConvertsFirstKeyAndEmptyArrays)
+{
+    auto* array = AiArrayAllocate(3, 2, AI_TYPE_UINT);
+    for (unsigned int i = 0; i < 6; ++i) {
+        AiArraySetUInt(array, i, 300 + i);
+    }
+    VtIntArray values;
+    ConvertArnoldArray<int, unsigned int>(array, values);
+    // Values above 255 are not truncated.
+    EXPECT_EQ(values, VtIntArray({300, 301, 302}));
+    AiArrayDestroy(array);
+
+    array = AiArrayAllocate(0, 1, AI_TYPE_UINT);
+    ConvertArnoldArray<int, unsigned int>(array, values);
+    EXPECT_TRUE(values.empty());
+    AiArrayDestroy(array);
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    AiBegin();
+    AiMsgSetConsoleFlags(AI_LOG_NONE);
+    auto result = RUN_ALL_TESTS();
+    AiEnd();
+    return result;
+}
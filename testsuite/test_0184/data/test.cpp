@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+
+#include "translator/writer/writer.h"
+
+#include <ai.h>
+
+#include <pxr/usd/sdf/schema.h>
+#include <pxr/usd/sdf/types.h>
+#include <pxr/usd/usd/attribute.h>
+#include <pxr/usd/usd/stage.h>
+
+#include <string>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+
+const TfToken tagToken("test:tag");
+
+// Prims keep this attribute until their node is written again
+void _TagPrim(const UsdStageRefPtr& stage, const char* path)
+{
+    auto prim = stage->GetPrimAtPath(SdfPath(path));
+    ASSERT_TRUE(prim.IsValid()) << path;
+    prim.CreateAttribute(tagToken, SdfValueTypeNames->Int).Set(1);
+}
+
+bool _IsTagged(const UsdStageRefPtr& stage, const char* path)
+{
+    auto prim = stage->GetPrimAtPath(SdfPath(path));
+    return prim && prim.GetAttribute(tagToken).IsAuthored();
+}
+
+float _GetRadius(const UsdStageRefPtr& stage, const char* path)
+{
+    float radius = 0.0f;
+    stage->GetPrimAtPath(SdfPath(path)).GetAttribute(TfToken("arnold:radius")).Get(&radius);
+    return radius;
+}
+
+} // namespace
+
+TEST(UsdArnoldWriter, IncrementalWrite)
+{
+    auto* sphere1 = AiNode("sphere", "sphere1");
+    auto* sphere2 = AiNode("sphere", "sphere2");
+    auto* sphere3 = AiNode("sphere", "sphere3");
+    AiNodeSetFlt(sphere1, "radius", 1.5f);
+    AiNodeSetFlt(sphere2, "radius", 1.5f);
+
+    auto stage = UsdStage::CreateInMemory();
+    UsdArnoldWriter writer;
+    writer.SetUsdStage(stage);
+    writer.SetMask(AI_NODE_SHAPE);
+    writer.SetIncremental(true);
+    writer.Write(nullptr);
+    EXPECT_TRUE(stage->GetPrimAtPath(SdfPath("/sphere3")).IsValid());
+    _TagPrim(stage, "/sphere1");
+    _TagPrim(stage, "/sphere2");
+
+    // Nothing changed, so nothing is written again
+    writer.Write(nullptr);
+    EXPECT_TRUE(_IsTagged(stage, "/sphere1"));
+    EXPECT_TRUE(_IsTagged(stage, "/sphere2"));
+
+    // Metadata authored on a prim is cleared as well when its node is written again
+    stage->GetPrimAtPath(SdfPath("/sphere2")).SetMetadata(SdfFieldKeys->Kind, TfToken("component"));
+    const auto sphereType = stage->GetPrimAtPath(SdfPath("/sphere2")).GetTypeName();
+    AiNodeSetFlt(sphere2, "radius", 2.0f);
+    AiNodeDestroy(sphere3);
+    writer.Write(nullptr);
+    EXPECT_TRUE(_IsTagged(stage, "/sphere1"));
+    EXPECT_FALSE(_IsTagged(stage, "/sphere2"));
+    auto sphere2Prim = stage->GetPrimAtPath(SdfPath("/sphere2"));
+    EXPECT_FALSE(sphere2Prim.HasAuthoredMetadata(SdfFieldKeys->Kind));
+    EXPECT_TRUE(sphere2Prim.IsDefined());
+    EXPECT_EQ(sphere2Prim.GetTypeName(), sphereType);
+    EXPECT_EQ(_GetRadius(stage, "/sphere1"), 1.5f);
+    EXPECT_EQ(_GetRadius(stage, "/sphere2"), 2.0f);
+    EXPECT_FALSE(stage->GetPrimAtPath(SdfPath("/sphere3")).IsValid());
+
+    AiNodeDestroy(sphere1);
+    AiNodeDestroy(sphere2);
+}
+
+TEST(UsdArnoldWriter, IncrementalMaterials)
+{
+    auto* surface1 = AiNode("standard_surface", "surface1");
+    auto* surface2 = AiNode("standard_surface", "surface2");
+    auto* sphere1 = AiNode("sphere", "sphere1");
+    auto* sphere2 = AiNode("sphere", "sphere2");
+    AiNodeSetPtr(sphere1, "shader", surface1);
+    AiNodeSetPtr(sphere2, "shader", surface1);
+
+    auto stage = UsdStage::CreateInMemory();
+    UsdArnoldWriter writer;
+    writer.SetUsdStage(stage);
+    writer.SetMask(AI_NODE_SHAPE | AI_NODE_SHADER);
+    writer.SetIncremental(true);
+    writer.Write(nullptr);
+    EXPECT_TRUE(stage->GetPrimAtPath(SdfPath("/materials/surface1")).IsValid());
+    EXPECT_FALSE(stage->GetPrimAtPath(SdfPath("/materials/surface2")).IsValid());
+
+    // The material is kept as long as a shape binds it
+    AiNodeSetPtr(sphere1, "shader", surface2);
+    writer.Write(nullptr);
+    EXPECT_TRUE(stage->GetPrimAtPath(SdfPath("/materials/surface1")).IsValid());
+    EXPECT_TRUE(stage->GetPrimAtPath(SdfPath("/materials/surface2")).IsValid());
+
+    AiNodeSetPtr(sphere2, "shader", surface2);
+    AiNodeDestroy(surface1);
+    writer.Write(nullptr);
+    EXPECT_FALSE(stage->GetPrimAtPath(SdfPath("/surface1")).IsValid());
+    EXPECT_FALSE(stage->GetPrimAtPath(SdfPath("/materials/surface1")).IsValid());
+    EXPECT_TRUE(stage->GetPrimAtPath(SdfPath("/materials/surface2")).IsValid());
+
+    // Without any bound material, the materials scope is removed as well
+    AiNodeDestroy(sphere1);
+    AiNodeDestroy(sphere2);
+    writer.Write(nullptr);
+    EXPECT_TRUE(stage->GetPrimAtPath(SdfPath("/surface2")).IsValid());
+    EXPECT_FALSE(stage->GetPrimAtPath(SdfPath("/materials")).IsValid());
+
+    AiNodeDestroy(surface2);
+}
+
+TEST(UsdArnoldWriter, IncrementalParallelWrite)
+{
+    auto* surface = AiNode("standard_surface", "surface");
+    AiNodeSetFlt(surface, "base", 0.5f);
+    std::vector<AtNode*> spheres;
+    for (int i = 0; i < 20; ++i) {
+        const auto name = "sphere" + std::to_string(i);
+        spheres.push_back(AiNode("sphere", name.c_str()));
+        AiNodeSetPtr(spheres.back(), "shader", surface);
+    }
+
+    auto stage = UsdStage::CreateInMemory();
+    UsdArnoldWriter writer;
+    writer.SetUsdStage(stage);
+    writer.SetThreadCount(4);
+    writer.SetIncremental(true);
+    writer.Write(nullptr);
+    auto baseAttr = stage->GetPrimAtPath(SdfPath("/surface")).GetAttribute(TfToken("inputs:base"));
+    ASSERT_TRUE(baseAttr.IsValid());
+    // The value is only overwritten if the shader is written again
+    baseAttr.Set(0.25f);
+    for (int i = 0; i < 20; ++i)
+        _TagPrim(stage, ("/sphere" + std::to_string(i)).c_str());
+
+    // The unchanged shader connected to the changed spheres isn't written again by the threads
+    AiNodeSetFlt(spheres[3], "radius", 2.0f);
+    AiNodeSetFlt(spheres[17], "radius", 3.0f);
+    writer.Write(nullptr);
+    float base = 0.0f;
+    EXPECT_TRUE(baseAttr.Get(&base));
+    EXPECT_EQ(base, 0.25f);
+    // The materials of the changed spheres are still connected to the shader
+    SdfPathVector sources;
+    stage->GetPrimAtPath(SdfPath("/materials/surface"))
+        .GetAttribute(TfToken("outputs:arnold:surface"))
+        .GetConnections(&sources);
+    EXPECT_EQ(sources, SdfPathVector{SdfPath("/surface.outputs:surface")});
+    EXPECT_TRUE(stage->GetPrimAtPath(SdfPath("/surface")).IsDefined());
+    EXPECT_EQ(_GetRadius(stage, "/sphere3"), 2.0f);
+    EXPECT_EQ(_GetRadius(stage, "/sphere17"), 3.0f);
+    for (int i = 0; i < 20; ++i)
+        EXPECT_EQ(_IsTagged(stage, ("/sphere" + std::to_string(i)).c_str()), i != 3 && i != 17) << i;
+
+    for (auto* sphere : spheres)
+        AiNodeDestroy(sphere);
+    AiNodeDestroy(surface);
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    AiBegin();
+    AiMsgSetConsoleFlags(AI_LOG_NONE);
+    auto result = RUN_ALL_TESTS();
+    AiEnd();
+    return result;
+}
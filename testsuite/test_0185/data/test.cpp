@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include "translator/writer/writer.h"
+
+#include <ai.h>
+
+#include <pxr/base/gf/matrix4d.h>
+#include <pxr/usd/usd/stage.h>
+#include <pxr/usd/usdGeom/xformable.h>
+
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+
+GfMatrix4d _ToGfMatrix(const AtMatrix& matrix)
+{
+    GfMatrix4d out;
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            out[i][j] = matrix.data[i][j];
+        }
+    }
+    return out;
+}
+
+void _ExpectTransform(const UsdGeomXformable& xformable, double frame, const AtMatrix& expected)
+{
+    GfMatrix4d transform;
+    bool resetsXformStack = false;
+    ASSERT_TRUE(xformable.GetLocalTransformation(&transform, &resetsXformStack, UsdTimeCode(frame)));
+    EXPECT_TRUE(GfIsClose(transform, _ToGfMatrix(expected), 1e-4)) << "frame " << frame;
+}
+
+std::vector<UsdGeomXformOp::Type> _GetOpTypes(const UsdGeomXformable& xformable)
+{
+    bool resetsXformStack = false;
+    std::vector<UsdGeomXformOp::Type> opTypes;
+    for (const auto& op : xformable.GetOrderedXformOps(&resetsXformStack)) {
+        opTypes.push_back(op.GetOpType());
+    }
+    return opTypes;
+}
+
+} // namespace
+
+TEST(UsdArnoldWriter, CompactXformFrames)
+{
+    auto* sphere = AiNode("sphere", "sphere1");
+    const auto frame1 = AiM4Translation(AtVector(1.0f, 2.0f, 3.0f));
+    const auto frame2 = AiM4Mult(AiM4RotationZ(90.0f), frame1);
+    auto frame3 = frame2;
+    frame3.data[1][0] = 0.5f;
+
+    auto stage = UsdStage::CreateInMemory();
+    UsdArnoldWriter writer;
+    writer.SetUsdStage(stage);
+    writer.SetMask(AI_NODE_SHAPE);
+    writer.SetStreaming(true);
+    writer.SetCompactEncoding(true);
+
+    AiNodeSetMatrix(sphere, "matrix", frame1);
+    writer.SetFrame(1.0f);
+    writer.Write(nullptr);
+    UsdGeomXformable xformable(stage->GetPrimAtPath(SdfPath("/sphere1")));
+    ASSERT_TRUE(xformable);
+    // All the ops are added on the first frame, so the following frames can reuse them in the same order
+    const std::vector<UsdGeomXformOp::Type> compactOps = {
+        UsdGeomXformOp::TypeTranslate, UsdGeomXformOp::TypeOrient, UsdGeomXformOp::TypeScale};
+    EXPECT_EQ(_GetOpTypes(xformable), compactOps);
+
+    AiNodeSetMatrix(sphere, "matrix", frame2);
+    writer.SetFrame(2.0f);
+    writer.Write(nullptr);
+    EXPECT_EQ(_GetOpTypes(xformable), compactOps);
+    _ExpectTransform(xformable, 1.0, frame1);
+    _ExpectTransform(xformable, 2.0, frame2);
+
+    // The shear can't be represented by the ops, so the previous frames are converted to a matrix
+    AiNodeSetMatrix(sphere, "matrix", frame3);
+    writer.SetFrame(3.0f);
+    writer.Write(nullptr);
+    EXPECT_EQ(_GetOpTypes(xformable), std::vector<UsdGeomXformOp::Type>{UsdGeomXformOp::TypeTransform});
+    EXPECT_FALSE(xformable.GetPrim().HasAttribute(TfToken("xformOp:translate")));
+    _ExpectTransform(xformable, 1.0, frame1);
+    _ExpectTransform(xformable, 2.0, frame2);
+    _ExpectTransform(xformable, 3.0, frame3);
+
+    // Frames after a matrix keep writing the matrix
+    AiNodeSetMatrix(sphere, "matrix", frame1);
+    writer.SetFrame(4.0f);
+    writer.Write(nullptr);
+    EXPECT_EQ(_GetOpTypes(xformable), std::vector<UsdGeomXformOp::Type>{UsdGeomXformOp::TypeTransform});
+    _ExpectTransform(xformable, 3.0, frame3);
+    _ExpectTransform(xformable, 4.0, frame1);
+
+    AiNodeDestroy(sphere);
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    AiBegin();
+    AiMsgSetConsoleFlags(AI_LOG_NONE);
+    auto result = RUN_ALL_TESTS();
+    AiEnd();
+    return result;
+}
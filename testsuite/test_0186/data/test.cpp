@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include "translator/writer/registry.h"
+#include "translator/writer/writer.h"
+
+#include <ai.h>
+
+#include <pxr/usd/sdf/layer.h>
+#include <pxr/usd/usd/stage.h>
+
+#include <string>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+
+std::string _WriteUniverse(unsigned int threadCount, UsdArnoldWriterRegistry* registry = nullptr)
+{
+    auto stage = UsdStage::CreateInMemory();
+    UsdArnoldWriter writer;
+    if (registry != nullptr)
+        writer.SetRegistry(registry);
+    writer.SetUsdStage(stage);
+    writer.SetThreadCount(threadCount);
+    writer.Write(nullptr);
+    std::string output;
+    stage->GetRootLayer()->ExportToString(&output);
+    return output;
+}
+
+} // namespace
+
+TEST(UsdArnoldWriter, ParallelWrite)
+{
+    // Shapes in a hierarchy, with shaders shared by shapes written in different chunks and
+    // connected to other shaders
+    AtNode* shaders[4];
+    for (int i = 0; i < 4; ++i) {
+        const auto name = "/looks/surface" + std::to_string(i);
+        shaders[i] = AiNode("standard_surface", name.c_str());
+    }
+    auto* image = AiNode("image", "/looks/image");
+    AiNodeLink(image, "base_color", shaders[0]);
+    AiNodeLink(image, "specular_color", shaders[1]);
+    for (int i = 0; i < 1000; ++i) {
+        const auto name = "/group" + std::to_string(i % 7) + "/sphere" + std::to_string(i);
+        auto* sphere = AiNode("sphere", name.c_str());
+        AiNodeSetFlt(sphere, "radius", 1.0f + static_cast<float>(i));
+        AiNodeSetPtr(sphere, "shader", shaders[(i * 3) % 4]);
+    }
+
+    const auto serial = _WriteUniverse(1);
+    EXPECT_FALSE(serial.empty());
+    EXPECT_EQ(_WriteUniverse(2), serial);
+    EXPECT_EQ(_WriteUniverse(3), serial);
+    EXPECT_EQ(_WriteUniverse(8), serial);
+
+    // Writers with their own registry, like the jobs of arnold_to_usd in batch mode, are written
+    // in parallel as well, as long as no custom writers were registered
+    UsdArnoldWriterRegistry registry;
+    EXPECT_FALSE(registry.HasCustomWriters());
+    EXPECT_EQ(_WriteUniverse(4, &registry), serial);
+    UsdArnoldWriterRegistry customRegistry;
+    customRegistry.RegisterWriter("box", nullptr);
+    EXPECT_TRUE(customRegistry.HasCustomWriters());
+    EXPECT_EQ(_WriteUniverse(4, &customRegistry), serial);
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    AiBegin();
+    AiMsgSetConsoleFlags(AI_LOG_NONE);
+    auto result = RUN_ALL_TESTS();
+    AiEnd();
+    return result;
+}
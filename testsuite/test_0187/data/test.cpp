@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include "translator/writer/writer.h"
+
+#include <ai.h>
+
+#include <pxr/base/gf/matrix4d.h>
+#include <pxr/usd/usd/stage.h>
+#include <pxr/usd/usdGeom/xformable.h>
+
+#include <cstring>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+
+AtNode* _CreateQuad(const char* name, float size = 1.0f)
+{
+    auto* node = AiNode("polymesh", name);
+    const unsigned int nsides[] = {4};
+    const unsigned int vidxs[] = {0, 1, 2, 3};
+    const AtVector vlist[] = {{0.0f, 0.0f, 0.0f}, {size, 0.0f, 0.0f}, {size, size, 0.0f}, {0.0f, size, 0.0f}};
+    AiNodeSetArray(node, "nsides", AiArrayConvert(1, 1, AI_TYPE_UINT, nsides));
+    AiNodeSetArray(node, "vidxs", AiArrayConvert(4, 1, AI_TYPE_UINT, vidxs));
+    AiNodeSetArray(node, "vlist", AiArrayConvert(4, 1, AI_TYPE_VECTOR, vlist));
+    return node;
+}
+
+bool _IsInstanceOf(const UsdStageRefPtr& stage, const char* path, const char* prototypePath)
+{
+    const auto prim = stage->GetPrimAtPath(SdfPath(path));
+    if (!prim || !prim.IsInstanceable()) {
+        return false;
+    }
+    // The shape is composed from the prototype, under the instance
+    const auto shape = stage->GetPrimAtPath(SdfPath(path).AppendChild(TfToken("shape")));
+    const auto prototypeShape = stage->GetPrimAtPath(SdfPath(prototypePath).AppendChild(TfToken("shape")));
+    return shape && shape.IsInstanceProxy() && prototypeShape && shape.GetTypeName() == prototypeShape.GetTypeName();
+}
+
+bool _IsMesh(const UsdStageRefPtr& stage, const char* path)
+{
+    const auto prim = stage->GetPrimAtPath(SdfPath(path));
+    return prim && !prim.IsInstanceable() && prim.GetTypeName() == TfToken("Mesh");
+}
+
+} // namespace
+
+TEST(UsdArnoldWriter, Instancing)
+{
+    // Identical shapes, only differing by their transform
+    _CreateQuad("quad1");
+    auto* quad2 = _CreateQuad("quad2");
+    AiNodeSetMatrix(quad2, "matrix", AiM4Translation(AtVector(2.0f, 0.0f, 0.0f)));
+    // Same parameters, apart from the contents of an array
+    _CreateQuad("quad3", 2.0f);
+    // The hash of the arrays is computed from their data only, so arrays of different types
+    // with the same data collide
+    const float floatValue = 1.0f;
+    int intValue = 0;
+    memcpy(&intValue, &floatValue, sizeof(int));
+    auto* quad4 = _CreateQuad("quad4");
+    AiNodeDeclare(quad4, "data", "constant ARRAY FLOAT");
+    AiNodeSetArray(quad4, "data", AiArrayConvert(1, 1, AI_TYPE_FLOAT, &floatValue));
+    auto* quad5 = _CreateQuad("quad5");
+    AiNodeDeclare(quad5, "data", "constant ARRAY INT");
+    AiNodeSetArray(quad5, "data", AiArrayConvert(1, 1, AI_TYPE_INT, &intValue));
+    // Shapes referenced by other nodes are written as geometries, even if they're identical to other shapes
+    auto* quad6 = _CreateQuad("quad6");
+    auto* ginstance = AiNode("ginstance", "ginstance1");
+    AiNodeSetPtr(ginstance, "node", quad6);
+    auto* quad7 = _CreateQuad("quad7");
+    auto* meshLight = AiNode("mesh_light", "mesh_light1");
+    AiNodeSetPtr(meshLight, "mesh", quad7);
+
+    auto stage = UsdStage::CreateInMemory();
+    UsdArnoldWriter writer;
+    writer.SetUsdStage(stage);
+    writer.SetMask(AI_NODE_SHAPE | AI_NODE_LIGHT);
+    writer.SetInstancing(true);
+    writer.Write(nullptr);
+
+    EXPECT_TRUE(_IsInstanceOf(stage, "/quad1", "/__arnold_prototypes/proto_0"));
+    EXPECT_TRUE(_IsInstanceOf(stage, "/quad2", "/__arnold_prototypes/proto_0"));
+    EXPECT_FALSE(stage->GetPrimAtPath(SdfPath("/__arnold_prototypes/proto_1")).IsValid());
+    // The transform is written on the instances, not on the prototype
+    GfMatrix4d transform;
+    bool resetsXformStack = false;
+    UsdGeomXformable(stage->GetPrimAtPath(SdfPath("/quad1")))
+        .GetLocalTransformation(&transform, &resetsXformStack, UsdTimeCode::Default());
+    EXPECT_EQ(transform, GfMatrix4d(1.0));
+    UsdGeomXformable(stage->GetPrimAtPath(SdfPath("/quad2")))
+        .GetLocalTransformation(&transform, &resetsXformStack, UsdTimeCode::Default());
+    EXPECT_EQ(transform, GfMatrix4d(1.0).SetTranslate(GfVec3d(2.0, 0.0, 0.0)));
+    UsdGeomXformable(stage->GetPrimAtPath(SdfPath("/__arnold_prototypes/proto_0/shape")))
+        .GetLocalTransformation(&transform, &resetsXformStack, UsdTimeCode::Default());
+    EXPECT_EQ(transform, GfMatrix4d(1.0));
+
+    EXPECT_TRUE(_IsMesh(stage, "/quad3"));
+    EXPECT_TRUE(_IsMesh(stage, "/quad4"));
+    EXPECT_TRUE(_IsMesh(stage, "/quad5"));
+    EXPECT_TRUE(_IsMesh(stage, "/quad6"));
+    EXPECT_TRUE(_IsMesh(stage, "/quad7"));
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    AiBegin();
+    AiMsgSetConsoleFlags(AI_LOG_NONE);
+    auto result = RUN_ALL_TESTS();
+    AiEnd();
+    return result;
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include "translator/writer/writer.h"
+
+#include <ai.h>
+
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/usd/attribute.h>
+#include <pxr/usd/usd/relationship.h>
+#include <pxr/usd/usd/stage.h>
+#include <pxr/usd/usdShade/materialBindingAPI.h>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+
+AtNode* _CreateNetwork(const char* surfaceName, const char* imageName, const char* linkedParam)
+{
+    auto* surface = AiNode("standard_surface", surfaceName);
+    auto* image = AiNode("image", imageName);
+    AiNodeSetStr(image, "filename", "texture.tx");
+    AiNodeLink(image, linkedParam, surface);
+    return surface;
+}
+
+AtNode* _CreateSphere(const char* name, AtNode* shader)
+{
+    auto* sphere = AiNode("sphere", name);
+    AiNodeSetPtr(sphere, "shader", shader);
+    return sphere;
+}
+
+SdfPath _GetMaterial(const UsdStageRefPtr& stage, const char* path)
+{
+    const auto prim = stage->GetPrimAtPath(SdfPath(path));
+    SdfPathVector targets;
+    UsdShadeMaterialBindingAPI(prim).GetDirectBindingRel().GetTargets(&targets);
+    return targets.empty() ? SdfPath() : targets[0];
+}
+
+SdfPath _GetConnection(const UsdStageRefPtr& stage, const char* path, const char* input)
+{
+    const auto attr = stage->GetPrimAtPath(SdfPath(path)).GetAttribute(TfToken(input));
+    SdfPathVector sources;
+    attr.GetConnections(&sources);
+    return sources.empty() ? SdfPath() : sources[0].GetPrimPath();
+}
+
+bool _HasPrim(const UsdStageRefPtr& stage, const char* path)
+{
+    return stage->GetPrimAtPath(SdfPath(path)).IsValid();
+}
+
+} // namespace
+
+TEST(UsdArnoldWriter, ShaderDeduplication)
+{
+    // Cloned networks
+    _CreateSphere("sphere1", _CreateNetwork("surface1", "image1", "base_color"));
+    _CreateSphere("sphere2", _CreateNetwork("surface2", "image2", "base_color"));
+    // The image is identical to the previous ones, but it's linked to another parameter
+    _CreateSphere("sphere3", _CreateNetwork("surface3", "image3", "specular_color"));
+
+    // Shaders referenced by node parameters are written as the name of the node
+    auto* aovShader1 = AiNode("standard_surface", "aov_shader1");
+    auto* aovShader2 = AiNode("standard_surface", "aov_shader2");
+    const AtNode* aovShaders[] = {aovShader1, aovShader2};
+    AiNodeSetArray(AiUniverseGetOptions(), "aov_shaders", AiArrayConvert(2, 1, AI_TYPE_NODE, aovShaders));
+
+    // Networks with cycles are compared by their shaders
+    auto* cycle1 = AiNode("multiply", "cycle1");
+    auto* cycle2 = AiNode("multiply", "cycle2");
+    AiNodeLink(cycle1, "input1", cycle2);
+    AiNodeLink(cycle2, "input1", cycle1);
+    auto* cycle3 = AiNode("multiply", "cycle3");
+    auto* cycle4 = AiNode("multiply", "cycle4");
+    AiNodeLink(cycle3, "input1", cycle4);
+    AiNodeLink(cycle4, "input1", cycle3);
+
+    auto stage = UsdStage::CreateInMemory();
+    UsdArnoldWriter writer;
+    writer.SetUsdStage(stage);
+    writer.SetShaderDeduplication(true);
+    writer.Write(nullptr);
+
+    EXPECT_EQ(_GetMaterial(stage, "/sphere1"), SdfPath("/materials/surface1"));
+    EXPECT_EQ(_GetMaterial(stage, "/sphere2"), SdfPath("/materials/surface1"));
+    EXPECT_FALSE(_HasPrim(stage, "/surface2"));
+    EXPECT_FALSE(_HasPrim(stage, "/image2"));
+    EXPECT_FALSE(_HasPrim(stage, "/materials/surface2"));
+
+    EXPECT_EQ(_GetMaterial(stage, "/sphere3"), SdfPath("/materials/surface3"));
+    EXPECT_TRUE(_HasPrim(stage, "/surface3"));
+    EXPECT_FALSE(_HasPrim(stage, "/image3"));
+    EXPECT_EQ(_GetConnection(stage, "/surface3", "inputs:specular_color"), SdfPath("/image1"));
+
+    EXPECT_TRUE(_HasPrim(stage, "/aov_shader1"));
+    EXPECT_TRUE(_HasPrim(stage, "/aov_shader2"));
+
+    EXPECT_TRUE(_HasPrim(stage, "/cycle1"));
+    EXPECT_TRUE(_HasPrim(stage, "/cycle2"));
+    EXPECT_EQ(_GetConnection(stage, "/cycle1", "inputs:input1"), SdfPath("/cycle2"));
+    EXPECT_EQ(_GetConnection(stage, "/cycle2", "inputs:input1"), SdfPath("/cycle1"));
+    EXPECT_TRUE(_HasPrim(stage, "/cycle3"));
+    EXPECT_TRUE(_HasPrim(stage, "/cycle4"));
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    AiBegin();
+    AiMsgSetConsoleFlags(AI_LOG_NONE);
+    auto result = RUN_ALL_TESTS();
+    AiEnd();
+    return result;
+}
@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+
+#include <pxr/imaging/hd/sceneDelegate.h>
+
+#include "render_delegate/light.h"
+#include "render_delegate/render_delegate.h"
+
+#include <constant_strings.h>
+
+#include <ai.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+
+const TfToken lightLinkToken("lightLink");
+const TfToken shadowLinkToken("shadowLink");
+#if PXR_VERSION >= 2105
+const TfToken coneAngleToken("inputs:shaping:cone:angle");
+#else
+const TfToken coneAngleToken("shaping:cone:angle");
+#endif
+
+// Scene delegate only returning the light parameters set by the test.
+class LightParamDelegate : public HdSceneDelegate {
+public:
+    LightParamDelegate() : HdSceneDelegate(nullptr, SdfPath::AbsoluteRootPath()) {}
+
+    void SetLightParam(const SdfPath& id, const TfToken& name, const VtValue& value) { _params[id][name] = value; }
+
+    VtValue GetLightParamValue(const SdfPath& id, const TfToken& name) override
+    {
+        const auto lightIt = _params.find(id);
+        if (lightIt == _params.end()) {
+            return {};
+        }
+        const auto paramIt = lightIt->second.find(name);
+        return paramIt == lightIt->second.end() ? VtValue{} : paramIt->second;
+    }
+
+private:
+    std::map<SdfPath, std::map<TfToken, VtValue>> _params;
+};
+
+std::vector<AtNode*> getGroup(const AtNode* shape, const AtString& group)
+{
+    std::vector<AtNode*> lights;
+    const auto* array = AiNodeGetArray(shape, group);
+    if (array != nullptr) {
+        for (uint32_t i = 0; i < AiArrayGetNumElements(array); i += 1) {
+            lights.push_back(static_cast<AtNode*>(AiArrayGetPtr(array, i)));
+        }
+    }
+    std::sort(lights.begin(), lights.end());
+    return lights;
+}
+
+std::vector<AtNode*> sorted(std::vector<AtNode*> lights)
+{
+    std::sort(lights.begin(), lights.end());
+    return lights;
+}
+
+} // namespace
+
+TEST(HdArnoldRenderDelegate, LightLinkingGroups)
+{
+    HdArnoldRenderDelegate renderDelegate;
+    AiMsgSetConsoleFlags(AI_LOG_NONE);
+    auto* universe = renderDelegate.GetUniverse();
+    LightParamDelegate sceneDelegate;
+    const SdfPath id1("/light1");
+    const SdfPath id2("/light2");
+    const SdfPath id3("/light3");
+    sceneDelegate.SetLightParam(id1, lightLinkToken, VtValue(TfToken("a")));
+    sceneDelegate.SetLightParam(id1, shadowLinkToken, VtValue(TfToken("a")));
+    sceneDelegate.SetLightParam(id2, lightLinkToken, VtValue(TfToken("b")));
+    // The light with the empty link affects all the shapes.
+    sceneDelegate.SetLightParam(id3, lightLinkToken, VtValue(TfToken()));
+    std::unique_ptr<HdLight> light1(HdArnoldLight::CreatePointLight(&renderDelegate, id1));
+    std::unique_ptr<HdLight> light2(HdArnoldLight::CreatePointLight(&renderDelegate, id2));
+    std::unique_ptr<HdLight> light3(HdArnoldLight::CreatePointLight(&renderDelegate, id3));
+    auto syncLight = [&](HdLight* light) {
+        HdDirtyBits dirtyBits = HdLight::AllDirty;
+        light->Sync(&sceneDelegate, renderDelegate.GetRenderParam(), &dirtyBits);
+    };
+    syncLight(light1.get());
+    syncLight(light2.get());
+    syncLight(light3.get());
+    auto lookUpLight = [&](const SdfPath& id) { return AiNodeLookUpByName(universe, AtString(id.GetText())); };
+    auto* node1 = lookUpLight(id1);
+    auto* node2 = lookUpLight(id2);
+    auto* node3 = lookUpLight(id3);
+    ASSERT_NE(node1, nullptr);
+    ASSERT_NE(node2, nullptr);
+    ASSERT_NE(node3, nullptr);
+
+    auto* shapeA = AiNode(universe, str::polymesh, AtString("shapeA"));
+    auto* shapeAUnrelated = AiNode(universe, str::polymesh, AtString("shapeAUnrelated"));
+    auto* shapeB = AiNode(universe, str::polymesh, AtString("shapeB"));
+    auto* shapeAB = AiNode(universe, str::polymesh, AtString("shapeAB"));
+    auto* shapeBA = AiNode(universe, str::polymesh, AtString("shapeBA"));
+    auto* shapeNone = AiNode(universe, str::polymesh, AtString("shapeNone"));
+    auto applyAll = [&]() {
+        renderDelegate.ApplyLightLinking(shapeA, {TfToken("a")});
+        renderDelegate.ApplyLightLinking(shapeAUnrelated, {TfToken("a"), TfToken("unrelated")});
+        renderDelegate.ApplyLightLinking(shapeB, {TfToken("b")});
+        renderDelegate.ApplyLightLinking(shapeAB, {TfToken("a"), TfToken("b")});
+        renderDelegate.ApplyLightLinking(shapeBA, {TfToken("b"), TfToken("a"), TfToken("b")});
+        renderDelegate.ApplyLightLinking(shapeNone, {});
+    };
+
+    // Shapes with the same light links get the same groups, regardless of the order, duplicates and categories
+    // that are not light links.
+    applyAll();
+    EXPECT_TRUE(AiNodeGetBool(shapeA, str::use_light_group));
+    EXPECT_EQ(getGroup(shapeA, str::light_group), sorted({node1, node3}));
+    EXPECT_EQ(getGroup(shapeAUnrelated, str::light_group), sorted({node1, node3}));
+    EXPECT_EQ(getGroup(shapeB, str::light_group), sorted({node2, node3}));
+    EXPECT_EQ(getGroup(shapeAB, str::light_group), sorted({node1, node2, node3}));
+    EXPECT_EQ(getGroup(shapeBA, str::light_group), sorted({node1, node2, node3}));
+    EXPECT_EQ(getGroup(shapeNone, str::light_group), std::vector<AtNode*>{node3});
+    EXPECT_TRUE(AiNodeGetBool(shapeA, str::use_shadow_group));
+    EXPECT_EQ(getGroup(shapeA, str::shadow_group), std::vector<AtNode*>{node1});
+    EXPECT_EQ(getGroup(shapeAB, str::shadow_group), std::vector<AtNode*>{node1});
+    // No lights cast shadows on the shape, but the shadow group is still used.
+    EXPECT_TRUE(AiNodeGetBool(shapeB, str::use_shadow_group));
+    EXPECT_TRUE(getGroup(shapeB, str::shadow_group).empty());
+
+    // Changing the light link of a light registers it again, which invalidates the cached groups.
+    sceneDelegate.SetLightParam(id2, lightLinkToken, VtValue(TfToken("a")));
+    syncLight(light2.get());
+    applyAll();
+    EXPECT_EQ(getGroup(shapeA, str::light_group), sorted({node1, node2, node3}));
+    EXPECT_EQ(getGroup(shapeAUnrelated, str::light_group), sorted({node1, node2, node3}));
+    EXPECT_EQ(getGroup(shapeB, str::light_group), std::vector<AtNode*>{node3});
+
+    // Registering and deregistering directly also invalidates the cached groups.
+    renderDelegate.RegisterLightLinking(TfToken("b"), light1.get());
+    applyAll();
+    EXPECT_EQ(getGroup(shapeB, str::light_group), sorted({node1, node3}));
+    EXPECT_EQ(getGroup(shapeA, str::light_group), sorted({node1, node2, node3}));
+    renderDelegate.DeregisterLightLinking(TfToken("b"), light1.get());
+    renderDelegate.DeregisterLightLinking(TfToken("a"), light2.get());
+    applyAll();
+    EXPECT_EQ(getGroup(shapeB, str::light_group), std::vector<AtNode*>{node3});
+    EXPECT_EQ(getGroup(shapeA, str::light_group), sorted({node1, node3}));
+    renderDelegate.RegisterLightLinking(TfToken("a"), light2.get());
+    applyAll();
+    EXPECT_EQ(getGroup(shapeA, str::light_group), sorted({node1, node2, node3}));
+
+    // Changing the type of a light recreates its node, so the groups have to point to the new node.
+    sceneDelegate.SetLightParam(id1, coneAngleToken, VtValue(45.0f));
+    syncLight(light1.get());
+    auto* spotNode1 = lookUpLight(id1);
+    ASSERT_NE(spotNode1, nullptr);
+    EXPECT_TRUE(AiNodeIs(spotNode1, str::spot_light));
+    applyAll();
+    EXPECT_EQ(getGroup(shapeA, str::light_group), sorted({spotNode1, node2, node3}));
+    EXPECT_EQ(getGroup(shapeAB, str::light_group), sorted({spotNode1, node2, node3}));
+    EXPECT_EQ(getGroup(shapeA, str::shadow_group), std::vector<AtNode*>{spotNode1});
+    EXPECT_EQ(getGroup(shapeB, str::light_group), std::vector<AtNode*>{node3});
+
+    // Removing the light links resets the groups on the shapes.
+    light1.reset();
+    light2.reset();
+    light3.reset();
+    applyAll();
+    EXPECT_FALSE(AiNodeGetBool(shapeA, str::use_light_group));
+    EXPECT_FALSE(AiNodeGetBool(shapeA, str::use_shadow_group));
+    EXPECT_TRUE(getGroup(shapeA, str::light_group).empty());
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    // The Render Delegate starts and ends the Arnold session.
+    return RUN_ALL_TESTS();
+}
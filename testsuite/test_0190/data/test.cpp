@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <pxr/imaging/hd/renderIndex.h>
+#include <pxr/imaging/hd/sceneDelegate.h>
+#include <pxr/imaging/hd/tokens.h>
+#include <pxr/usd/sdf/assetPath.h>
+
+#include "render_delegate/openvdb_asset.h"
+#include "render_delegate/render_delegate.h"
+#include "render_delegate/volume.h"
+
+#include <ai.h>
+
+#include <map>
+#include <memory>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+
+const TfToken filePathToken("filePath");
+const TfToken fieldNameToken("fieldName");
+
+// Scene delegate only returning the values set by the test.
+class FieldDelegate : public HdSceneDelegate {
+public:
+    FieldDelegate(HdRenderIndex* renderIndex) : HdSceneDelegate(renderIndex, SdfPath::AbsoluteRootPath()) {}
+
+    void SetValue(const SdfPath& id, const TfToken& name, const VtValue& value) { _values[id][name] = value; }
+
+    VtValue Get(const SdfPath& id, const TfToken& name) override
+    {
+        const auto primIt = _values.find(id);
+        if (primIt == _values.end()) {
+            return {};
+        }
+        const auto valueIt = primIt->second.find(name);
+        return valueIt == primIt->second.end() ? VtValue{} : valueIt->second;
+    }
+
+private:
+    std::map<SdfPath, std::map<TfToken, VtValue>> _values;
+};
+
+} // namespace
+
+TEST(HdArnoldOpenvdbAsset, DirtiesVolumes)
+{
+    HdArnoldRenderDelegate renderDelegate;
+    AiMsgSetConsoleFlags(AI_LOG_NONE);
+#if PXR_VERSION >= 2005
+    std::unique_ptr<HdRenderIndex> renderIndex(HdRenderIndex::New(&renderDelegate, HdDriverVector{}));
+#else
+    std::unique_ptr<HdRenderIndex> renderIndex(HdRenderIndex::New(&renderDelegate));
+#endif
+    ASSERT_NE(renderIndex, nullptr);
+    FieldDelegate sceneDelegate(renderIndex.get());
+    const SdfPath volumeId("/volume");
+    const SdfPath fieldId("/volume/density");
+    renderIndex->InsertRprim(HdPrimTypeTokens->volume, &sceneDelegate, volumeId);
+    auto& changeTracker = renderIndex->GetChangeTracker();
+
+    HdArnoldOpenvdbAsset asset(&renderDelegate, fieldId);
+    asset.TrackVolumePrimitive(volumeId);
+    // Syncs the asset, and returns if the volume was dirtied
+    auto syncAsset = [&]() -> bool {
+        changeTracker.MarkRprimClean(volumeId);
+        HdDirtyBits dirtyBits = HdField::DirtyParams;
+        asset.Sync(&sceneDelegate, renderDelegate.GetRenderParam(), &dirtyBits);
+        return (changeTracker.GetRprimDirtyBits(volumeId) & HdArnoldVolume::DirtyFields) != 0;
+    };
+
+    sceneDelegate.SetValue(fieldId, filePathToken, VtValue(SdfAssetPath("density.vdb")));
+    sceneDelegate.SetValue(fieldId, fieldNameToken, VtValue(TfToken("density")));
+    EXPECT_TRUE(syncAsset());
+    // Nothing changed on the file.
+    EXPECT_FALSE(syncAsset());
+    sceneDelegate.SetValue(fieldId, fieldNameToken, VtValue(TfToken("temperature")));
+    EXPECT_TRUE(syncAsset());
+    sceneDelegate.SetValue(fieldId, filePathToken, VtValue(SdfAssetPath("other.vdb")));
+    EXPECT_TRUE(syncAsset());
+    EXPECT_FALSE(syncAsset());
+
+    // The grids of Houdini in-memory volumes can change without changing the path.
+    sceneDelegate.SetValue(fieldId, filePathToken, VtValue(SdfAssetPath("op:/obj/geo1/volume")));
+    EXPECT_TRUE(syncAsset());
+    EXPECT_TRUE(syncAsset());
+    EXPECT_TRUE(syncAsset());
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    // The Render Delegate starts and ends the Arnold session.
+    return RUN_ALL_TESTS();
+}
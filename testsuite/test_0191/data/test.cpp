@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <pxr/base/arch/fileSystem.h>
+#include <pxr/base/plug/registry.h>
+#include <pxr/imaging/hd/changeTracker.h>
+#include <pxr/imaging/hd/renderIndex.h>
+#include <pxr/imaging/hd/tokens.h>
+
+#include "render_delegate/render_delegate.h"
+#include "scene_delegate/delegate.h"
+
+#include <ai.h>
+
+#include <fstream>
+#include <memory>
+#include <string>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+
+// The adapters are looked up through the plugin registry, so the adapter types of the linked scene delegate library
+// are declared by a resource plugin when the scene delegate plugin is not on the plugin path.
+void registerAdapters()
+{
+    if (PlugRegistry::GetInstance().GetPluginForType(TfType::FindByName("ImagingArnoldPolymeshAdapter")) != nullptr) {
+        return;
+    }
+    const auto pluginDir = ArchMakeTmpSubdir(ArchGetTmpDir(), "test_0191");
+    std::ofstream plugInfo(pluginDir + "/plugInfo.json");
+    plugInfo << R"({"Plugins": [{"Info": {"Types": {"ImagingArnoldPolymeshAdapter": )"
+             << R"({"bases": ["ImagingArnoldRprimAdapter"], "arnoldTypeName": "polymesh"}}}, )"
+             << R"("Name": "imagingArnoldTest", "ResourcePath": ".", "Root": ".", "Type": "resource"}]})";
+    plugInfo.close();
+    PlugRegistry::GetInstance().RegisterPlugins(pluginDir);
+}
+
+void setPoints(AtNode* node, float offset)
+{
+    const AtVector points[] = {{offset, 0.0f, 0.0f},
+                               {offset + 1.0f, 0.0f, 0.0f},
+                               {offset + 1.0f, 1.0f, 0.0f},
+                               {offset, 1.0f, 0.0f}};
+    AiNodeSetArray(node, AtString("vlist"), AiArrayConvert(4, 1, AI_TYPE_VECTOR, points));
+}
+
+} // namespace
+
+TEST(ImagingArnoldDelegate, RefreshesEditedNodes)
+{
+    HdArnoldRenderDelegate renderDelegate;
+    AiMsgSetConsoleFlags(AI_LOG_NONE);
+    registerAdapters();
+#if PXR_VERSION >= 2005
+    std::unique_ptr<HdRenderIndex> renderIndex(HdRenderIndex::New(&renderDelegate, HdDriverVector{}));
+#else
+    std::unique_ptr<HdRenderIndex> renderIndex(HdRenderIndex::New(&renderDelegate));
+#endif
+    auto* universe = AiUniverse();
+    auto* node = AiNode(universe, "polymesh", "mesh");
+    const uint32_t nsides[] = {4};
+    const uint32_t vidxs[] = {0, 1, 2, 3};
+    AiNodeSetArray(node, AtString("nsides"), AiArrayConvert(1, 1, AI_TYPE_UINT, nsides));
+    AiNodeSetArray(node, AtString("vidxs"), AiArrayConvert(4, 1, AI_TYPE_UINT, vidxs));
+    setPoints(node, 0.0f);
+
+    {
+        ImagingArnoldDelegate sceneDelegate(renderIndex.get(), SdfPath::AbsoluteRootPath());
+        sceneDelegate.Populate(universe);
+        const auto id = sceneDelegate.GetIdFromNode(node);
+        ASSERT_NE(renderIndex->GetRprim(id), nullptr);
+        EXPECT_EQ(sceneDelegate.GetMeshTopology(id).GetFaceVertexCounts(), VtIntArray({4}));
+        EXPECT_EQ(sceneDelegate.GetExtent(id).GetMin(), GfVec3d(0.0, 0.0, 0.0));
+        auto points = sceneDelegate.Get(id, HdTokens->points);
+        ASSERT_TRUE(points.IsHolding<VtVec3fArray>());
+        EXPECT_EQ(points.UncheckedGet<VtVec3fArray>()[0], GfVec3f(0.0f, 0.0f, 0.0f));
+
+        // Replacing the arrays after populating.
+        setPoints(node, 2.0f);
+        const uint32_t triangleNsides[] = {3, 3};
+        const uint32_t triangleVidxs[] = {0, 1, 2, 0, 2, 3};
+        AiNodeSetArray(node, AtString("nsides"), AiArrayConvert(2, 1, AI_TYPE_UINT, triangleNsides));
+        AiNodeSetArray(node, AtString("vidxs"), AiArrayConvert(6, 1, AI_TYPE_UINT, triangleVidxs));
+        EXPECT_EQ(sceneDelegate.GetMeshTopology(id).GetFaceVertexCounts(), VtIntArray({3, 3}));
+        EXPECT_EQ(sceneDelegate.GetExtent(id).GetMin(), GfVec3d(2.0, 0.0, 0.0));
+        points = sceneDelegate.Get(id, HdTokens->points);
+        ASSERT_TRUE(points.IsHolding<VtVec3fArray>());
+        EXPECT_EQ(points.UncheckedGet<VtVec3fArray>()[0], GfVec3f(2.0f, 0.0f, 0.0f));
+
+        // Writing to the existing array in place.
+        AiArraySetVec(AiNodeGetArray(node, AtString("vlist")), 0, AtVector(-1.0f, 0.0f, 0.0f));
+        EXPECT_EQ(sceneDelegate.GetExtent(id).GetMin(), GfVec3d(-1.0, 0.0, 0.0));
+        points = sceneDelegate.Get(id, HdTokens->points);
+        ASSERT_TRUE(points.IsHolding<VtVec3fArray>());
+        EXPECT_EQ(points.UncheckedGet<VtVec3fArray>()[0], GfVec3f(-1.0f, 0.0f, 0.0f));
+
+        // Marking the prim dirty notifies Hydra.
+        auto& changeTracker = renderIndex->GetChangeTracker();
+        changeTracker.MarkRprimClean(id);
+        sceneDelegate.MarkPrimDirty(id, HdChangeTracker::DirtyPoints);
+        EXPECT_TRUE(HdChangeTracker::IsPrimvarDirty(changeTracker.GetRprimDirtyBits(id), id, HdTokens->points));
+        renderIndex->RemoveSubtree(SdfPath::AbsoluteRootPath(), &sceneDelegate);
+    }
+    AiUniverseDestroy(universe);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    // The Render Delegate starts and ends the Arnold session.
+    return RUN_ALL_TESTS();
+}
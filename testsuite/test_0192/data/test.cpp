@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <pxr/base/arch/fileSystem.h>
+#include <pxr/base/plug/registry.h>
+#include <pxr/imaging/hd/renderIndex.h>
+
+#include "render_delegate/render_delegate.h"
+#include "scene_delegate/delegate.h"
+
+#include <ai.h>
+
+#include <fstream>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+
+// The adapters are looked up through the plugin registry, so the adapter types of the linked scene delegate library
+// are declared by a resource plugin when the scene delegate plugin is not on the plugin path.
+void registerAdapters()
+{
+    if (PlugRegistry::GetInstance().GetPluginForType(TfType::FindByName("ImagingArnoldPolymeshAdapter")) != nullptr) {
+        return;
+    }
+    const auto pluginDir = ArchMakeTmpSubdir(ArchGetTmpDir(), "test_0192");
+    std::ofstream plugInfo(pluginDir + "/plugInfo.json");
+    plugInfo << R"({"Plugins": [{"Info": {"Types": {"ImagingArnoldPolymeshAdapter": )"
+             << R"({"bases": ["ImagingArnoldRprimAdapter"], "arnoldTypeName": "polymesh"}}}, )"
+             << R"("Name": "imagingArnoldTest", "ResourcePath": ".", "Root": ".", "Type": "resource"}]})";
+    plugInfo.close();
+    PlugRegistry::GetInstance().RegisterPlugins(pluginDir);
+}
+
+} // namespace
+
+TEST(ImagingArnoldDelegate, ParallelPopulateIds)
+{
+    HdArnoldRenderDelegate renderDelegate;
+    AiMsgSetConsoleFlags(AI_LOG_NONE);
+    registerAdapters();
+#if PXR_VERSION >= 2005
+    std::unique_ptr<HdRenderIndex> renderIndex(HdRenderIndex::New(&renderDelegate, HdDriverVector{}));
+#else
+    std::unique_ptr<HdRenderIndex> renderIndex(HdRenderIndex::New(&renderDelegate));
+#endif
+    auto* universe = AiUniverse();
+    // Deep hierarchies sharing parents, components starting with digits, and names that only differ in characters
+    // that are replaced when sanitizing, so several nodes map to the same id.
+    std::vector<std::string> names;
+    for (auto group = 0; group < 20; group += 1) {
+        for (auto mesh = 0; mesh < 50; mesh += 1) {
+            const auto groupName = "/root|group" + std::to_string(group);
+            names.push_back(groupName + "|sub|mesh" + std::to_string(mesh));
+            names.push_back(groupName + "|" + std::to_string(mesh) + "|mesh");
+            names.push_back(groupName + "|mesh.a" + std::to_string(mesh));
+            names.push_back(groupName + "|mesh_a" + std::to_string(mesh));
+            names.push_back(groupName + "/sub/mesh" + std::to_string(mesh) + ":b");
+            names.push_back(groupName + "|sub|mesh" + std::to_string(mesh) + "_b");
+        }
+    }
+    for (const auto& name : names) {
+        AiNode(universe, "polymesh", name.c_str());
+    }
+
+    {
+        ImagingArnoldDelegate sceneDelegate(renderIndex.get(), SdfPath::AbsoluteRootPath());
+        sceneDelegate.Populate(universe);
+
+        // Converting the names one by one, without any other thread sharing the parent cache.
+        ImagingArnoldDelegate serialDelegate(renderIndex.get(), SdfPath("/serial"));
+        std::set<SdfPath> expectedIds;
+        for (const auto& name : names) {
+            const auto id = serialDelegate.GetIdFromNodeName(name);
+            EXPECT_FALSE(id.IsEmpty());
+            expectedIds.insert(id);
+        }
+        EXPECT_LT(expectedIds.size(), names.size());
+
+        const auto& rprimIds = renderIndex->GetRprimIds();
+        const std::set<SdfPath> populatedIds(rprimIds.begin(), rprimIds.end());
+        EXPECT_EQ(populatedIds, expectedIds);
+        // The ids are also the same when looked up after populating.
+        for (const auto& name : names) {
+            EXPECT_EQ(sceneDelegate.GetIdFromNodeName(name), serialDelegate.GetIdFromNodeName(name));
+        }
+        renderIndex->RemoveSubtree(SdfPath::AbsoluteRootPath(), &sceneDelegate);
+    }
+    AiUniverseDestroy(universe);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    // The Render Delegate starts and ends the Arnold session.
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+
+#include <pxr/base/gf/vec3f.h>
+#include <pxr/imaging/hd/basisCurvesTopology.h>
+#include <pxr/imaging/hd/renderIndex.h>
+#include <pxr/imaging/hd/sceneDelegate.h>
+#include <pxr/imaging/hd/tokens.h>
+
+#include "render_delegate/basis_curves.h"
+#include "render_delegate/render_delegate.h"
+
+#include <ai.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+
+const TfToken periodicToken("periodic");
+const TfToken pinnedToken("pinned");
+const TfToken vertexFloatToken("vertexFloat");
+const TfToken varyingFloatToken("varyingFloat");
+
+// Scene delegate only returning the topology and the primvars set by the test.
+class CurvesDelegate : public HdSceneDelegate {
+public:
+    CurvesDelegate(HdRenderIndex* renderIndex) : HdSceneDelegate(renderIndex, SdfPath::AbsoluteRootPath()) {}
+
+    void SetTopology(const HdBasisCurvesTopology& topology) { _topology = topology; }
+
+    void SetPrimvar(const TfToken& name, HdInterpolation interpolation, const TfToken& role, const VtValue& value)
+    {
+        if (_values.count(name) == 0) {
+            _descriptors[interpolation].push_back({name, interpolation, role});
+        }
+        _values[name] = value;
+    }
+
+    HdBasisCurvesTopology GetBasisCurvesTopology(const SdfPath& id) override { return _topology; }
+
+    HdPrimvarDescriptorVector GetPrimvarDescriptors(const SdfPath& id, HdInterpolation interpolation) override
+    {
+        const auto it = _descriptors.find(interpolation);
+        return it == _descriptors.end() ? HdPrimvarDescriptorVector{} : it->second;
+    }
+
+    VtValue Get(const SdfPath& id, const TfToken& key) override
+    {
+        const auto it = _values.find(key);
+        return it == _values.end() ? VtValue{} : it->second;
+    }
+
+private:
+    HdBasisCurvesTopology _topology;
+    std::map<HdInterpolation, HdPrimvarDescriptorVector> _descriptors;
+    std::map<TfToken, VtValue> _values;
+};
+
+template <typename T>
+std::vector<T> getArray(const AtNode* node, const char* name)
+{
+    std::vector<T> ret;
+    auto* array = AiNodeGetArray(node, AtString(name));
+    if (array != nullptr) {
+        const auto* data = static_cast<const T*>(AiArrayMap(array));
+        ret.assign(data, data + AiArrayGetNumElements(array));
+        AiArrayUnmap(array);
+    }
+    return ret;
+}
+
+class HdArnoldBasisCurvesWrap : public testing::Test {
+protected:
+    void SetUp() override
+    {
+        _renderDelegate.reset(new HdArnoldRenderDelegate());
+        AiMsgSetConsoleFlags(AI_LOG_NONE);
+#if PXR_VERSION >= 2005
+        _renderIndex.reset(HdRenderIndex::New(_renderDelegate.get(), HdDriverVector{}));
+#else
+        _renderIndex.reset(HdRenderIndex::New(_renderDelegate.get()));
+#endif
+        _sceneDelegate.reset(new CurvesDelegate(_renderIndex.get()));
+    }
+
+    void TearDown() override
+    {
+        _curves.reset();
+        _sceneDelegate.reset();
+        _renderIndex.reset();
+        _renderDelegate.reset();
+    }
+
+    // Syncs a single cubic curve with four vertices and returns the Arnold curves node.
+    const AtNode* syncCurves(const TfToken& basis, const TfToken& wrap, const VtVec3fArray& points)
+    {
+        _sceneDelegate->SetTopology(
+            HdBasisCurvesTopology(HdTokens->cubic, basis, wrap, VtIntArray{static_cast<int>(points.size())}, {}));
+        _sceneDelegate->SetPrimvar(
+            HdTokens->points, HdInterpolationVertex, HdPrimvarRoleTokens->point, VtValue{points});
+        _curves.reset(new HdArnoldBasisCurves(_renderDelegate.get(), SdfPath("/curves")));
+        auto dirtyBits = _curves->GetInitialDirtyBitsMask();
+        _curves->Sync(_sceneDelegate.get(), _renderDelegate->GetRenderParam(), &dirtyBits, HdReprTokens->hull);
+        return _curves->GetArnoldNode();
+    }
+
+    std::unique_ptr<HdArnoldRenderDelegate> _renderDelegate;
+    std::unique_ptr<HdRenderIndex> _renderIndex;
+    std::unique_ptr<CurvesDelegate> _sceneDelegate;
+    std::unique_ptr<HdArnoldBasisCurves> _curves;
+};
+
+const VtVec3fArray curvePoints{{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {2.0f, 0.0f, 0.0f}, {3.0f, 0.0f, 0.0f}};
+
+} // namespace
+
+TEST_F(HdArnoldBasisCurvesWrap, PeriodicVertexPrimvars)
+{
+    const VtVec3fArray normals{{0.0f, 1.0f, 0.0f}, {0.0f, 2.0f, 0.0f}, {0.0f, 3.0f, 0.0f}, {0.0f, 4.0f, 0.0f}};
+    _sceneDelegate->SetPrimvar(HdTokens->normals, HdInterpolationVertex, HdPrimvarRoleTokens->normal, VtValue{normals});
+    const auto* node = syncCurves(HdTokens->bSpline, periodicToken, curvePoints);
+    // Periodic b-splines repeat the last vertex before the curve and the first two after it.
+    EXPECT_EQ(getArray<uint32_t>(node, "num_points"), std::vector<uint32_t>({7}));
+    EXPECT_EQ(
+        getArray<GfVec3f>(node, "points"),
+        std::vector<GfVec3f>({curvePoints[3], curvePoints[0], curvePoints[1], curvePoints[2], curvePoints[3],
+                              curvePoints[0], curvePoints[1]}));
+    // Vertex normals are converted to orientations, which are wrapped the same way as the points.
+    EXPECT_EQ(
+        getArray<GfVec3f>(node, "orientations"),
+        std::vector<GfVec3f>({normals[3], normals[0], normals[1], normals[2], normals[3], normals[0], normals[1]}));
+    EXPECT_EQ(AiNodeGetStr(node, AtString("mode")), AtString("oriented"));
+}
+
+TEST_F(HdArnoldBasisCurvesWrap, PinnedVertexPrimvars)
+{
+    const VtVec3fArray normals{{0.0f, 1.0f, 0.0f}, {0.0f, 2.0f, 0.0f}, {0.0f, 3.0f, 0.0f}, {0.0f, 4.0f, 0.0f}};
+    _sceneDelegate->SetPrimvar(HdTokens->normals, HdInterpolationVertex, HdPrimvarRoleTokens->normal, VtValue{normals});
+    _sceneDelegate->SetPrimvar(
+        vertexFloatToken, HdInterpolationVertex, HdPrimvarRoleTokens->none,
+        VtValue{VtFloatArray{1.0f, 2.0f, 3.0f, 4.0f}});
+    const auto* node = syncCurves(HdTokens->catmullRom, pinnedToken, curvePoints);
+    EXPECT_EQ(getArray<uint32_t>(node, "num_points"), std::vector<uint32_t>({6}));
+    // Phantom points are extrapolated so the curve reaches its end points.
+    EXPECT_EQ(
+        getArray<GfVec3f>(node, "points"),
+        std::vector<GfVec3f>({{-1.0f, 0.0f, 0.0f}, curvePoints[0], curvePoints[1], curvePoints[2], curvePoints[3],
+                              {4.0f, 0.0f, 0.0f}}));
+    // Other primvars are clamped to the end values.
+    EXPECT_EQ(
+        getArray<GfVec3f>(node, "orientations"),
+        std::vector<GfVec3f>({normals[0], normals[0], normals[1], normals[2], normals[3], normals[3]}));
+    // Vertex primvars of cubic curves are remapped to the segment ends, keeping the values at the end points.
+    const auto vertexFloat = getArray<float>(node, "vertexFloat");
+    ASSERT_EQ(vertexFloat.size(), size_t{4});
+    EXPECT_EQ(vertexFloat.front(), 1.0f);
+    EXPECT_EQ(vertexFloat.back(), 4.0f);
+}
+
+TEST_F(HdArnoldBasisCurvesWrap, VaryingPrimvars)
+{
+    // Periodic curves get an extra segment end, closing the curve with the value of the first segment.
+    _sceneDelegate->SetPrimvar(
+        varyingFloatToken, HdInterpolationVarying, HdPrimvarRoleTokens->none,
+        VtValue{VtFloatArray{1.0f, 2.0f, 3.0f, 4.0f}});
+    auto* node = syncCurves(HdTokens->bSpline, periodicToken, curvePoints);
+    EXPECT_EQ(getArray<float>(node, "varyingFloat"), std::vector<float>({1.0f, 2.0f, 3.0f, 4.0f, 1.0f}));
+    // The segments added by pinning are already accounted for by USD, so the values are unchanged.
+    node = syncCurves(HdTokens->bSpline, pinnedToken, curvePoints);
+    EXPECT_EQ(getArray<float>(node, "varyingFloat"), std::vector<float>({1.0f, 2.0f, 3.0f, 4.0f}));
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    // The Render Delegate starts and ends the Arnold session.
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,121 @@
+#!/usr/bin/env python
+# Copyright 2021 Autodesk, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Times the conversion of Arnold arrays to USD in the writer, for each array type supported by the writer.
+
+For each type, a scene with a single shape holding a large user data array of that type is generated and converted
+with arnold_to_usd. The time of converting the same shape without the array is subtracted, so the reported time is
+mostly the conversion of the array and the authoring of its values. The types that have motion keys in the writer
+are written with several keys.
+
+Example:
+    python benchmark_array_conversion.py --elements 1000000
+    python benchmark_array_conversion.py --types FLOAT VECTOR MATRIX --executable ../../build/cmd/arnold_to_usd
+"""
+
+import argparse
+import os
+import subprocess
+import tempfile
+import time
+
+NODE_NAME = 'array_benchmark'
+
+# Values of the element i of each type, as written in an ass file, and if the writer converts the motion keys
+ARRAY_TYPES = [
+    ('BYTE', lambda i: str(i % 256), True),
+    ('INT', lambda i: str(i - 1000), True),
+    ('UINT', lambda i: str(i), True),
+    ('BOOL', lambda i: 'on' if i % 2 else 'off', True),
+    ('FLOAT', lambda i: str(i * 0.5), True),
+    ('RGB', lambda i: '{0} 0.5 {0}'.format(i % 7), True),
+    ('RGBA', lambda i: '{0} 0.5 {0} 1'.format(i % 7), True),
+    ('VECTOR', lambda i: '{} 1 2'.format(i * 0.5), True),
+    ('VECTOR2', lambda i: '{} 1'.format(i * 0.5), True),
+    ('MATRIX', lambda i: '1 0 0 0 0 1 0 0 0 0 1 0 {} 1 2 1'.format(i), True),
+    ('STRING', lambda i: '"value_{}"'.format(i % 100), False),
+    ('NODE', lambda i: NODE_NAME, False),
+]
+
+
+def _write_scene(path, array_type, num_elements, num_keys):
+    with open(path, 'w') as out:
+        out.write('sphere\n{\n')
+        out.write(' name {}\n'.format(NODE_NAME))
+        if array_type is not None:
+            name, value, has_keys = array_type
+            keys = num_keys if has_keys else 1
+            out.write(' declare data constant ARRAY {}\n'.format(name))
+            out.write(' data {} {} {}\n'.format(num_elements, keys, name))
+            for index in range(num_elements * keys):
+                out.write('  {}\n'.format(value(index)))
+        out.write('}\n')
+
+
+def _convert(executable, input_path, output_path, repeats):
+    # The fastest run is kept, as it's the least disturbed by the rest of the system
+    best = None
+    for _ in range(repeats):
+        start = time.time()
+        with open(os.devnull, 'w') as devnull:
+            result = subprocess.call(
+                [executable, input_path, output_path, '--threads', '1'], stdout=devnull, stderr=devnull)
+        elapsed = time.time() - start
+        if result != 0 or not os.path.exists(output_path):
+            return None
+        os.remove(output_path)
+        best = elapsed if best is None else min(best, elapsed)
+    return best
+
+
+def benchmark(executable, type_names, num_elements, num_keys, repeats, extension):
+    array_types = [array_type for array_type in ARRAY_TYPES if not type_names or array_type[0] in type_names]
+    output_dir = tempfile.mkdtemp(prefix='benchmark_array_conversion_')
+    input_path = os.path.join(output_dir, 'scene.ass')
+    output_path = os.path.join(output_dir, 'scene.{}'.format(extension))
+    _write_scene(input_path, None, num_elements, num_keys)
+    baseline = _convert(executable, input_path, output_path, repeats)
+    if baseline is None:
+        print('Cannot convert the baseline scene with {}'.format(executable))
+    else:
+        print('{:<10} {:>6} {:>12} {:>14}'.format('type', 'keys', 'time ms', 'ns / element'))
+        for array_type in array_types:
+            keys = num_keys if array_type[2] else 1
+            _write_scene(input_path, array_type, num_elements, num_keys)
+            elapsed = _convert(executable, input_path, output_path, repeats)
+            if elapsed is None:
+                print('{:<10} failed'.format(array_type[0]))
+                continue
+            elapsed = max(0.0, elapsed - baseline)
+            print('{:<10} {:>6} {:>12.3f} {:>14.3f}'.format(
+                array_type[0], keys, elapsed * 1e3, elapsed * 1e9 / (num_elements * keys)))
+    os.remove(input_path)
+    os.rmdir(output_dir)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Time the conversion of Arnold arrays in the USD writer.')
+    parser.add_argument('--executable', default='arnold_to_usd', help='Path to the arnold_to_usd executable.')
+    parser.add_argument('--elements', type=int, default=100000, help='Number of elements in each array key.')
+    parser.add_argument('--keys', type=int, default=2, help='Number of keys of the arrays supporting motion.')
+    parser.add_argument('--repeats', type=int, default=3, help='Number of conversions of each scene.')
+    parser.add_argument('--types', nargs='*', help='Array types to time, all of them by default.')
+    parser.add_argument('--extension', default='usdc', help='Extension of the written files, usd, usda or usdc.')
+    args = parser.parse_args()
+    benchmark(
+        args.executable, args.types, max(1, args.elements), max(1, args.keys), max(1, args.repeats), args.extension)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,90 @@
+#!/usr/bin/env python
+# Copyright 2021 Autodesk, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Compares the file size and write time of the default and the compact profile of the USD writer.
+
+Each ass file is converted twice with arnold_to_usd, once with the default profile and once with --compact, and the
+size of the written files and the time taken by the conversion are reported for both.
+
+Example:
+    python generate_ass_scene.py --shapes 100000 shapes.ass
+    python compare_writer_profiles.py --extension usdc shapes.ass ../../testsuite/test_*/data/scene.ass
+"""
+
+import argparse
+import os
+import subprocess
+import tempfile
+import time
+
+
+def _convert(executable, input_path, output_path, compact):
+    command = [executable, input_path, output_path]
+    if compact:
+        command.append('--compact')
+    start = time.time()
+    with open(os.devnull, 'w') as devnull:
+        result = subprocess.call(command, stdout=devnull, stderr=devnull)
+    elapsed = time.time() - start
+    if result != 0 or not os.path.exists(output_path):
+        return None
+    return os.path.getsize(output_path), elapsed
+
+
+def _format_ratio(default_value, compact_value):
+    if default_value == 0:
+        return '-'
+    return '{:.1f}%'.format(100.0 * compact_value / default_value)
+
+
+def compare(executable, inputs, extension):
+    print('{:<50} {:>12} {:>12} {:>8} {:>10} {:>10}'.format(
+        'input', 'default', 'compact', 'size', 'default s', 'compact s'))
+    total_default = [0, 0.0]
+    total_compact = [0, 0.0]
+    output_dir = tempfile.mkdtemp(prefix='compare_writer_profiles_')
+    for index, input_path in enumerate(inputs):
+        default_path = os.path.join(output_dir, 'default_{}.{}'.format(index, extension))
+        compact_path = os.path.join(output_dir, 'compact_{}.{}'.format(index, extension))
+        default_result = _convert(executable, input_path, default_path, False)
+        compact_result = _convert(executable, input_path, compact_path, True)
+        for path in (default_path, compact_path):
+            if os.path.exists(path):
+                os.remove(path)
+        if default_result is None or compact_result is None:
+            print('{:<50} failed'.format(input_path[-50:]))
+            continue
+        for total, result in ((total_default, default_result), (total_compact, compact_result)):
+            total[0] += result[0]
+            total[1] += result[1]
+        print('{:<50} {:>12} {:>12} {:>8} {:>10.3f} {:>10.3f}'.format(
+            input_path[-50:], default_result[0], compact_result[0],
+            _format_ratio(default_result[0], compact_result[0]), default_result[1], compact_result[1]))
+    os.rmdir(output_dir)
+    print('{:<50} {:>12} {:>12} {:>8} {:>10.3f} {:>10.3f}'.format(
+        'total', total_default[0], total_compact[0],
+        _format_ratio(total_default[0], total_compact[0]), total_default[1], total_compact[1]))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compare the default and the compact profile of the USD writer.')
+    parser.add_argument('inputs', nargs='+', help='Ass files to convert.')
+    parser.add_argument('--executable', default='arnold_to_usd', help='Path to the arnold_to_usd executable.')
+    parser.add_argument('--extension', default='usd', help='Extension of the written files, usd, usda or usdc.')
+    args = parser.parse_args()
+    compare(args.executable, args.inputs, args.extension)
+
+
+if __name__ == '__main__':
+    main()
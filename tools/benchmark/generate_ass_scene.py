@@ -0,0 +1,74 @@
+#!/usr/bin/env python
+# Copyright 2021 Autodesk, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Generates an Arnold scene with many shapes for benchmarking the USD writer.
+
+Shapes are small polymeshes organized in a hierarchy of groups, so the writer has to create the parent Xforms, and
+each shape is assigned one of a few shader networks, so shared shaders are written once and connected many times.
+
+Example:
+    python generate_ass_scene.py --shapes 500000 shapes.ass
+    time arnold_to_usd shapes.ass shapes.usdc
+"""
+
+import argparse
+
+
+def _write_shaders(out, num_shaders):
+    for index in range(num_shaders):
+        out.write('image\n{\n')
+        out.write(' name /looks/texture_{}\n'.format(index))
+        out.write(' filename "texture_{}.tx"\n'.format(index))
+        out.write('}\n\n')
+        out.write('standard_surface\n{\n')
+        out.write(' name /looks/surface_{}\n'.format(index))
+        out.write(' base_color /looks/texture_{}\n'.format(index))
+        out.write(' specular_roughness {}\n'.format(0.1 + 0.8 * index / float(max(1, num_shaders))))
+        out.write('}\n\n')
+
+
+def _write_shape(out, index, group_size, num_shaders):
+    x = float(index % group_size) * 2.0
+    z = float(index // group_size) * 2.0
+    out.write('polymesh\n{\n')
+    out.write(' name /world/group_{}/shape_{}\n'.format(index // group_size, index))
+    out.write(' nsides 1 UINT 4\n')
+    out.write(' vidxs 4 UINT 0 1 2 3\n')
+    out.write(' vlist 4 VECTOR -0.5 0 -0.5 -0.5 0 0.5 0.5 0 0.5 0.5 0 -0.5\n')
+    out.write(' matrix 1 0 0 0 0 1 0 0 0 0 1 0 {} 0 {} 1\n'.format(x, z))
+    out.write(' shader /looks/surface_{}\n'.format(index % num_shaders))
+    out.write('}\n\n')
+
+
+def generate(path, num_shapes, group_size, num_shaders):
+    group_size = max(1, group_size)
+    num_shaders = max(1, num_shaders)
+    with open(path, 'w') as out:
+        _write_shaders(out, num_shaders)
+        for index in range(num_shapes):
+            _write_shape(out, index, group_size, num_shaders)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate a USD writer benchmark scene.')
+    parser.add_argument('output', help='Path to the output ass file.')
+    parser.add_argument('--shapes', type=int, default=10000, help='Number of shapes.')
+    parser.add_argument('--group-size', type=int, default=1000, help='Number of shapes in each group.')
+    parser.add_argument('--shaders', type=int, default=16, help='Number of unique shader networks.')
+    args = parser.parse_args()
+    generate(args.output, args.shapes, args.group_size, args.shaders)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,125 @@
+#!/usr/bin/env python
+# Copyright 2021 Autodesk, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Generates a USD scene with an instanced groom for benchmarking basis curves instancing in the Render Delegate.
+
+A single groom of oriented ribbons is instanced by a point instancer, with a per-instance color. The Render Delegate
+converts the groom to a single Arnold curves node shared by all the instances, so the curves memory does not depend
+on the number of instances. With --baked every instance is written as a separate groom instead, which is what had to
+be done before, and the curves memory grows with the number of instances.
+
+Example:
+    python generate_groom_scene.py --instances 1000 --strands 10000 groom.usda
+    python generate_groom_scene.py --instances 1000 --strands 10000 --baked groom_baked.usda
+    HDARNOLD_log_verbosity=3 usdrecord --renderer Arnold groom.usda groom.png
+"""
+
+import argparse
+import math
+
+WRAPS = ['nonperiodic', 'periodic', 'pinned']
+
+
+def _strand_points(index, grid_size, num_vertices, offset):
+    x = (index % grid_size) / float(grid_size) - 0.5 + offset[0]
+    z = (index // grid_size) / float(grid_size) - 0.5 + offset[2]
+    # Slightly curled strands, so the ribbons are not all facing the same direction.
+    return [
+        (x + 0.02 * math.sin(vertex + index), offset[1] + vertex * 0.1, z + 0.02 * math.cos(vertex + index))
+        for vertex in range(num_vertices)]
+
+
+def _write_groom(out, name, num_strands, num_vertices, wrap, offset, indent):
+    grid_size = max(1, int(math.ceil(math.sqrt(num_strands))))
+    points = []
+    for index in range(num_strands):
+        points.extend(_strand_points(index, grid_size, num_vertices, offset))
+    out.write('{}def BasisCurves "{}"\n'.format(indent, name))
+    out.write('{}{{\n'.format(indent))
+    out.write('{}    uniform token type = "cubic"\n'.format(indent))
+    out.write('{}    uniform token basis = "bspline"\n'.format(indent))
+    out.write('{}    uniform token wrap = "{}"\n'.format(indent, wrap))
+    out.write('{}    int[] curveVertexCounts = [{}]\n'.format(indent, ', '.join([str(num_vertices)] * num_strands)))
+    out.write('{}    point3f[] points = [{}]\n'.format(indent, ', '.join('({}, {}, {})'.format(*p) for p in points)))
+    # Vertex normals are converted to orientations, facing the ribbons towards the camera.
+    out.write('{}    normal3f[] normals = [{}] (\n'.format(indent, ', '.join(['(0, 0, 1)'] * len(points))))
+    out.write('{}        interpolation = "vertex"\n'.format(indent))
+    out.write('{}    )\n'.format(indent))
+    out.write('{}    float[] widths = [0.005] (\n'.format(indent))
+    out.write('{}        interpolation = "constant"\n'.format(indent))
+    out.write('{}    )\n'.format(indent))
+    out.write('{}}}\n'.format(indent))
+
+
+def _instance_position(index, grid_size):
+    return ((index % grid_size) * 1.5, 0.0, (index // grid_size) * 1.5)
+
+
+def _instance_color(index, num_instances):
+    hue = index / float(max(1, num_instances))
+    return (0.5 + 0.5 * math.cos(6.2832 * hue), 0.5 + 0.5 * math.cos(6.2832 * (hue + 0.33)), 0.5)
+
+
+def generate(path, num_instances, num_strands, num_vertices, wrap, baked):
+    grid_size = max(1, int(math.ceil(math.sqrt(num_instances))))
+    with open(path, 'w') as out:
+        out.write('#usda 1.0\n')
+        out.write('(\n')
+        out.write('    defaultPrim = "World"\n')
+        out.write('    upAxis = "Y"\n')
+        out.write(')\n\n')
+        out.write('def Xform "World"\n')
+        out.write('{\n')
+        if baked:
+            for index in range(num_instances):
+                _write_groom(
+                    out, 'groom_{}'.format(index), num_strands, num_vertices, wrap,
+                    _instance_position(index, grid_size), '    ')
+        else:
+            positions = [_instance_position(index, grid_size) for index in range(num_instances)]
+            colors = [_instance_color(index, num_instances) for index in range(num_instances)]
+            out.write('    def PointInstancer "grooms"\n')
+            out.write('    {\n')
+            out.write('        point3f[] positions = [{}]\n'.format(
+                ', '.join('({}, {}, {})'.format(*p) for p in positions)))
+            out.write('        int[] protoIndices = [{}]\n'.format(', '.join(['0'] * num_instances)))
+            # Per-instance primvars of point instancers use vertex interpolation.
+            out.write('        color3f[] primvars:instanceColor = [{}] (\n'.format(
+                ', '.join('({}, {}, {})'.format(*c) for c in colors)))
+            out.write('            interpolation = "vertex"\n')
+            out.write('        )\n')
+            out.write('        rel prototypes = [</World/grooms/prototypes/groom>]\n\n')
+            out.write('        def Scope "prototypes"\n')
+            out.write('        {\n')
+            _write_groom(out, 'groom', num_strands, num_vertices, wrap, (0.0, 0.0, 0.0), '            ')
+            out.write('        }\n')
+            out.write('    }\n')
+        out.write('}\n')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate an instanced groom benchmark scene.')
+    parser.add_argument('output', help='Path to the output usda file.')
+    parser.add_argument('--instances', type=int, default=100, help='Number of instances of the groom.')
+    parser.add_argument('--strands', type=int, default=1000, help='Number of strands in the groom.')
+    parser.add_argument('--vertices', type=int, default=6, help='Number of vertices of each strand.')
+    parser.add_argument('--wrap', choices=WRAPS, default='pinned', help='Wrap mode of the strands.')
+    parser.add_argument('--baked', action='store_true', help='Write every instance as a separate groom.')
+    args = parser.parse_args()
+    generate(
+        args.output, max(1, args.instances), max(1, args.strands), max(4, args.vertices), args.wrap, args.baked)
+
+
+if __name__ == '__main__':
+    main()
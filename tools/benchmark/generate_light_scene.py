@@ -0,0 +1,98 @@
+#!/usr/bin/env python
+# Copyright 2021 Autodesk, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Generates a USD scene with many lights and shapes for benchmarking light syncing in the Render Delegate.
+
+Lights are spot lights with barndoors, split into a number of light linking sets. Every light in a set links the same
+shapes, and lights in the same set share the same barndoor settings, so the number of unique light filters and light
+groups only depends on the number of sets, not on the number of lights.
+
+Example:
+    python generate_light_scene.py --lights 50000 --shapes 10000 --link-sets 16 lights.usda
+    usdview --renderer Arnold lights.usda
+"""
+
+import argparse
+import math
+
+
+def _write_shape(out, index, grid_size):
+    x = (index % grid_size) * 2.0
+    z = (index // grid_size) * 2.0
+    out.write('    def Mesh "shape_{}"\n'.format(index))
+    out.write('    {\n')
+    out.write('        int[] faceVertexCounts = [4]\n')
+    out.write('        int[] faceVertexIndices = [0, 1, 2, 3]\n')
+    out.write('        point3f[] points = [(-0.5, 0, -0.5), (-0.5, 0, 0.5), (0.5, 0, 0.5), (0.5, 0, -0.5)]\n')
+    out.write('        double3 xformOp:translate = ({}, 0, {})\n'.format(x, z))
+    out.write('        uniform token[] xformOpOrder = ["xformOp:translate"]\n')
+    out.write('    }\n')
+
+
+def _write_light(out, index, link_set, num_link_sets, shapes_per_set, grid_size):
+    x = (index % grid_size) * 2.0
+    z = (index // grid_size) * 2.0
+    # Every light in a set has the same barndoor settings, so the filters can be shared.
+    barndoor = 0.05 + 0.4 * link_set / float(max(1, num_link_sets))
+    out.write('    def SphereLight "light_{}" (\n'.format(index))
+    out.write('        prepend apiSchemas = ["ShapingAPI", "CollectionAPI:lightLink"]\n')
+    out.write('    )\n')
+    out.write('    {\n')
+    out.write('        float inputs:intensity = 10\n')
+    out.write('        float inputs:radius = 0.1\n')
+    out.write('        float inputs:shaping:cone:angle = 45\n')
+    out.write('        float inputs:shaping:cone:softness = 0.1\n')
+    for side in ('bottom', 'left', 'right', 'top'):
+        out.write('        float barndoor{} = {}\n'.format(side, barndoor))
+    out.write('        uniform bool collection:lightLink:includeRoot = 0\n')
+    first_shape = link_set * shapes_per_set
+    targets = ', '.join('</World/shape_{}>'.format(first_shape + i) for i in range(shapes_per_set))
+    out.write('        rel collection:lightLink:includes = [{}]\n'.format(targets))
+    out.write('        double3 xformOp:translate = ({}, 5, {})\n'.format(x, z))
+    out.write('        float3 xformOp:rotateXYZ = (-90, 0, 0)\n')
+    out.write('        uniform token[] xformOpOrder = ["xformOp:translate", "xformOp:rotateXYZ"]\n')
+    out.write('    }\n')
+
+
+def generate(path, num_lights, num_shapes, num_link_sets):
+    num_link_sets = max(1, min(num_link_sets, num_shapes))
+    shapes_per_set = max(1, num_shapes // num_link_sets)
+    grid_size = max(1, int(math.ceil(math.sqrt(max(num_lights, num_shapes)))))
+    with open(path, 'w') as out:
+        out.write('#usda 1.0\n')
+        out.write('(\n')
+        out.write('    defaultPrim = "World"\n')
+        out.write('    upAxis = "Y"\n')
+        out.write(')\n\n')
+        out.write('def Xform "World"\n')
+        out.write('{\n')
+        for index in range(num_shapes):
+            _write_shape(out, index, grid_size)
+        for index in range(num_lights):
+            _write_light(out, index, index % num_link_sets, num_link_sets, shapes_per_set, grid_size)
+        out.write('}\n')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate a light scaling benchmark scene.')
+    parser.add_argument('output', help='Path to the output usda file.')
+    parser.add_argument('--lights', type=int, default=1000, help='Number of lights.')
+    parser.add_argument('--shapes', type=int, default=1000, help='Number of shapes.')
+    parser.add_argument('--link-sets', type=int, default=8, help='Number of unique light linking sets.')
+    args = parser.parse_args()
+    generate(args.output, args.lights, args.shapes, args.link_sets)
+
+
+if __name__ == '__main__':
+    main()
@@ -51,6 +51,7 @@ def render_delegate(env, sources):
         'arch',
         'plug',
         'tf',
+        'trace',
         'vt',
         'gf',
         'work',
@@ -15,8 +15,12 @@
 
 #include <ai.h>
 
+#include <pxr/base/gf/matrix3d.h>
 #include <pxr/base/gf/matrix4d.h>
 #include <pxr/base/gf/matrix4f.h>
+#include <pxr/base/gf/quatd.h>
+#include <pxr/base/gf/quatf.h>
+#include <pxr/base/gf/rotation.h>
 #include <pxr/base/tf/token.h>
 #include <pxr/usd/usd/prim.h>
 #include <pxr/usd/usdGeom/primvarsAPI.h>
@@ -24,6 +28,8 @@
 #include <pxr/usd/usdShade/materialBindingAPI.h>
 #include <pxr/usd/usdShade/shader.h>
 
+#include <algorithm>
+#include <cmath>
 #include <cstdio>
 #include <cstring>
 #include <string>
@@ -42,6 +48,109 @@ inline GfMatrix4d _NodeGetGfMatrix(const AtNode* node, const char* param)
     return GfMatrix4d(matFlt);
 };
 
+// Relative tolerance of the matrices recomposed from single precision translate, orient and
+// scale ops. The rotation of a single precision quaternion practically never reproduces the
+// Arnold matrix bit for bit, so the compact encoding isn't lossless, but the difference stays
+// within about a hundred single precision ulps of each element
+static const double s_compactXformTolerance = 1e-5;
+
+// Decompose an affine matrix into a translation, rotation and scale in single precision.
+// Returns false if the matrix has shear or projection, ie. if the components don't
+// reproduce the matrix within s_compactXformTolerance
+inline bool _DecomposeMatrix(const GfMatrix4d& matrix, GfVec3f& translate, GfQuatf& orient, GfVec3f& scale)
+{
+    if (matrix[0][3] != 0.0 || matrix[1][3] != 0.0 || matrix[2][3] != 0.0 || matrix[3][3] != 1.0)
+        return false;
+    GfVec3d axes[3];
+    GfVec3d axesScale;
+    for (int i = 0; i < 3; ++i) {
+        axes[i] = GfVec3d(matrix[i][0], matrix[i][1], matrix[i][2]);
+        axesScale[i] = axes[i].Normalize();
+        if (axesScale[i] == 0.0)
+            return false;
+    }
+    // Mirroring is stored as a negative scale
+    if (GfDot(GfCross(axes[0], axes[1]), axes[2]) < 0.0) {
+        axes[0] = -axes[0];
+        axesScale[0] = -axesScale[0];
+    }
+    const GfMatrix3d rotation(
+        axes[0][0], axes[0][1], axes[0][2], axes[1][0], axes[1][1], axes[1][2], axes[2][0], axes[2][1], axes[2][2]);
+    translate = GfVec3f(matrix[3][0], matrix[3][1], matrix[3][2]);
+    orient = GfQuatf(rotation.ExtractRotation().GetQuat());
+    scale = GfVec3f(axesScale);
+
+    // Ops are applied in the order scale, orient, translate
+    const GfMatrix4d recomposed = GfMatrix4d(1.0).SetScale(GfVec3d(scale)) *
+                                  GfMatrix4d(1.0).SetRotate(GfQuatd(orient)) *
+                                  GfMatrix4d(1.0).SetTranslate(GfVec3d(translate));
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            if (fabs(recomposed[i][j] - matrix[i][j]) > s_compactXformTolerance * (1.0 + fabs(matrix[i][j])))
+                return false;
+        }
+    }
+    return true;
+}
+
+// Compact xform ops are single precision translate, orient and scale ops without suffix
+inline bool _IsCompactXformOp(const UsdGeomXformOp& op)
+{
+    const UsdGeomXformOp::Type opType = op.GetOpType();
+    return (opType == UsdGeomXformOp::TypeTranslate || opType == UsdGeomXformOp::TypeOrient ||
+            opType == UsdGeomXformOp::TypeScale) &&
+           op.GetPrecision() == UsdGeomXformOp::PrecisionFloat && !op.IsInverseOp() &&
+           op.GetOpName() == UsdGeomXformOp::GetOpName(opType);
+}
+
+// Replace the xform ops of a prim by a matrix op, reproducing the values of the ops
+// at each of their time samples
+inline void _BakeXformOps(UsdGeomXformable& xformable, const std::vector<UsdGeomXformOp>& ops)
+{
+    std::vector<double> times;
+    xformable.GetTimeSamples(&times);
+    std::vector<GfMatrix4d> matrices(std::max(times.size(), size_t(1)));
+    bool resetsXformStack = false;
+    if (times.empty()) {
+        xformable.GetLocalTransformation(&matrices[0], &resetsXformStack);
+    } else {
+        for (size_t i = 0; i < times.size(); ++i)
+            xformable.GetLocalTransformation(&matrices[i], &resetsXformStack, UsdTimeCode(times[i]));
+    }
+    const UsdAttribute matrixAttr = xformable.MakeMatrixXform().GetAttr();
+    if (times.empty()) {
+        matrixAttr.Set(matrices[0]);
+    } else {
+        for (size_t i = 0; i < times.size(); ++i)
+            matrixAttr.Set(matrices[i], UsdTimeCode(times[i]));
+    }
+    UsdPrim prim = xformable.GetPrim();
+    for (const auto& op : ops)
+        prim.RemoveProperty(op.GetName());
+}
+
+// Arrays are compared with the default value of their parameter by their contents
+inline bool _ArrayEqualsDefault(const AtArray* array, const AtArray* defaultArray)
+{
+    if (defaultArray == nullptr || AiArrayGetType(array) != AiArrayGetType(defaultArray) ||
+        AiArrayGetNumElements(array) != AiArrayGetNumElements(defaultArray) ||
+        AiArrayGetNumKeys(array) != AiArrayGetNumKeys(defaultArray))
+        return false;
+    // Strings and nodes can't be compared byte by byte
+    const uint8_t type = AiArrayGetType(array);
+    if (type == AI_TYPE_STRING || type == AI_TYPE_NODE || type == AI_TYPE_ARRAY || type == AI_TYPE_POINTER)
+        return false;
+    const size_t dataSize = (size_t)AiArrayGetKeySize(array) * (size_t)AiArrayGetNumKeys(array);
+    if (dataSize == 0)
+        return true;
+    AtArray* arrayA = const_cast<AtArray*>(array);
+    AtArray* arrayB = const_cast<AtArray*>(defaultArray);
+    const bool equal = memcmp(AiArrayMap(arrayA), AiArrayMap(arrayB), dataSize) == 0;
+    AiArrayUnmap(arrayA);
+    AiArrayUnmap(arrayB);
+    return equal;
+}
+
 inline const char* _GetEnum(AtEnum en, int32_t id)
 {
     if (en == nullptr) {
@@ -212,6 +321,7 @@ public:
 
     uint8_t GetParamType() const { return AiParamGetType(_paramEntry); }
     bool SkipDefaultValue(const UsdArnoldPrimWriter::ParamConversion* paramConversion) const { return false; }
+    bool SkipDefaultArray(const AtArray* array) const { return false; }
     AtString GetParamName() const { return AiParamGetName(_paramEntry); }
 
     template <typename T>
@@ -224,23 +334,7 @@ public:
     void ProcessAttributeKeys(const UsdArnoldWriter &writer, 
         const SdfValueTypeName& typeName, const std::vector<T>& values, float motionStart, float motionEnd)
     {
-        if (values.empty())
-            return;
-
-        if (values.size() == 1) 
-            writer.SetAttribute(_attr, values[0]);
-        else {
-            if (motionStart >= motionEnd) {
-                // invalid motion start / end points, let's just write a single value
-                writer.SetAttribute(_attr, values[0]);
-            } else {
-                float motionDelta = (motionEnd - motionStart) / ((int)values.size() - 1);
-                float time = motionStart;
-                for (size_t i = 0; i < values.size(); ++i, time += motionDelta) {
-                    writer.SetAttribute(_attr, values[i], &time);
-                }
-            }
-        }
+        writer.SetAttributeKeys(_attr, values, motionStart, motionEnd);
     }
     void AddConnection(const SdfPath& path) { _attr.AddConnection(path); }
     const UsdAttribute& GetAttr() { return _attr; }
@@ -271,6 +365,10 @@ public:
         return paramConversion && paramConversion->d &&
                paramConversion->d(_node, paramNameStr.c_str(), AiParamGetDefault(_paramEntry));
     }
+    bool SkipDefaultArray(const AtArray* array) const
+    {
+        return _ArrayEqualsDefault(array, AiParamGetDefault(_paramEntry)->ARRAY());
+    }
     AtString GetParamName() const { return AiParamGetName(_paramEntry); }
 
     template <typename T>
@@ -299,17 +397,7 @@ public:
         std::string paramName(paramNameStr.c_str());
         std::string usdParamName = (_scope.empty()) ? paramName : _scope + std::string(":") + paramName;
         _attr = _prim.CreateAttribute(TfToken(usdParamName), typeName, false);
-
-        if (motionStart >= motionEnd) {
-            // invalid motion start / end points, let's just write a single value
-            writer.SetAttribute(_attr, values[0]);
-        } else {
-            float motionDelta = (motionEnd - motionStart) / ((int)values.size() - 1);
-            float time = motionStart;
-            for (size_t i = 0; i < values.size(); ++i, time += motionDelta) {
-                writer.SetAttribute(_attr, values[i], &time);
-            }
-        }
+        writer.SetAttributeKeys(_attr, values, motionStart, motionEnd);
     }
     void AddConnection(const SdfPath& path) { _attr.AddConnection(path); }
     const UsdAttribute& GetAttr() { return _attr; }
@@ -335,6 +423,7 @@ public:
     }
 
     bool SkipDefaultValue(const UsdArnoldPrimWriter::ParamConversion* paramConversion) const { return false; }
+    bool SkipDefaultArray(const AtArray* array) const { return false; }
     uint8_t GetParamType() const
     {
         // The definition of user data in arnold is a bit different from primvars in USD :
@@ -430,7 +519,7 @@ public:
             AtNode* target = (AtNode*)AiNodeGetPtr(_node, paramNameStr);
             if (target) {
                 _writer.WritePrimitive(target); // ensure the target is written first
-                std::string targetName = UsdArnoldPrimWriter::GetArnoldNodeName(target, writer);
+                const std::string &targetName = UsdArnoldPrimWriter::GetArnoldNodeName(target, writer);
                 _primVar.GetAttr().AddConnection(SdfPath(targetName));
             }
         }
@@ -463,15 +552,17 @@ private:
 
 } // namespace
 
-// Get the conversion item for this node type (see above)
+// Get the conversion item for this node type (see above). This is called for every
+// parameter of every node, so the map is flattened to a table indexed by type
 const UsdArnoldPrimWriter::ParamConversion* UsdArnoldPrimWriter::GetParamConversion(uint8_t type)
 {
-    const auto it = _ParamConversionMap().find(type);
-    if (it != _ParamConversionMap().end()) {
-        return &it->second;
-    } else {
-        return nullptr;
-    }
+    static const std::vector<const ParamConversion*> conversions = []() {
+        std::vector<const ParamConversion*> ret(256, nullptr);
+        for (const auto& it : _ParamConversionMap())
+            ret[it.first] = &it.second;
+        return ret;
+    }();
+    return conversions[type];
 }
 /**
  *    Function invoked from the UsdArnoldWriter that exports an input arnold node to USD
@@ -500,9 +591,19 @@ void UsdArnoldPrimWriter::WriteNode(const AtNode* node, UsdArnoldWriter& writer)
  *forbidden characters from the names. Also, we must ensure that the first
  *character is a slash
  **/
-std::string UsdArnoldPrimWriter::GetArnoldNodeName(const AtNode* node, const UsdArnoldWriter &writer)
+const std::string& UsdArnoldPrimWriter::GetArnoldNodeName(const AtNode* node, const UsdArnoldWriter &writer)
 {
-    std::string name = AiNodeGetName(node);
+    // When writing a prototype, its shape is written inside the prototype
+    if (node == writer.GetPrototypeNode())
+        return writer.GetPrototypePath().GetString();
+
+    // The name of a node is needed every time it's connected or bound, so we
+    // only compute it once and cache it in the writer
+    std::string &name = writer.GetNodeNameCache(node);
+    if (!name.empty())
+        return name;
+
+    name = AiNodeGetName(node);
     if (name.empty()) {
         // Arnold can have nodes with empty names, but this is forbidden in USD.
         // We're going to generate an arbitrary name for this node, with its node type
@@ -536,7 +637,7 @@ std::string UsdArnoldPrimWriter::GetArnoldNodeName(const AtNode* node, const Usd
         }
     }
 
-    name = writer.GetScope() + name;
+    name.insert(0, writer.GetScope());
     
     return name;
 }
@@ -545,6 +646,8 @@ std::string UsdArnoldPrimWriter::GetArnoldNodeName(const AtNode* node, const Usd
 // and return its name
 static inline std::string GetConnectedNode(UsdArnoldWriter& writer, AtNode* target, int outComp = -1)
 {
+    // Connections to a shader identical to another one are redirected to the shared shader
+    target = (AtNode*)writer.GetSharedShader(target);
     // First, ensure the primitive was written to usd
     writer.WritePrimitive(target);
 
@@ -618,10 +721,11 @@ static inline bool convertArnoldAttribute(
         }
         int arrayType = AiArrayGetType(array);
         unsigned int numElements = AiArrayGetNumElements(array);
-        if (numElements == 0 && !writer.GetWriteAllAttributes()) {
+        // Arrays matching the parameter default are only skipped by the compact encoding profile
+        if (!writer.GetWriteAllAttributes() &&
+            (numElements == 0 || (writer.GetCompactEncoding() && attrWriter.SkipDefaultArray(array)))) {
             return false;
         }
-        unsigned int numKeys = AiArrayGetNumKeys(array);
         float motionStart = primWriter.GetMotionStart();
         float motionEnd = primWriter.GetMotionEnd();
 
@@ -629,121 +733,66 @@ static inline bool convertArnoldAttribute(
         int index = 0;
         switch (arrayType) {
             case AI_TYPE_BYTE: {
-                std::vector<VtArray<unsigned char> > vtMotionArray(numKeys);
-                unsigned char* arrayMap = (unsigned char*)AiArrayMap(array);
-                for (unsigned int j = 0; j < numKeys; ++j) {
-                    VtArray<unsigned char>& vtArr = vtMotionArray[j];
-                    vtArr.resize(numElements);
-                    memcpy(&vtArr[0], &arrayMap[j * numElements], numElements * sizeof(unsigned char));
-                }
+                std::vector<VtArray<unsigned char> > vtMotionArray;
+                ConvertArnoldArrayKeys(array, vtMotionArray);
                 typeName = SdfValueTypeNames->UCharArray;
                 attrWriter.ProcessAttributeKeys(writer, typeName, vtMotionArray, motionStart, motionEnd);
-                AiArrayUnmap(array);
                 break;
             }
             case AI_TYPE_INT: {
-                std::vector<VtArray<int> > vtMotionArray(numKeys);
-                int* arrayMap = (int*)AiArrayMap(array);
-                for (unsigned int j = 0; j < numKeys; ++j) {
-                    VtArray<int>& vtArr = vtMotionArray[j];
-                    vtArr.resize(numElements);
-                    memcpy(&vtArr[0], &arrayMap[j * numElements], numElements * sizeof(int));
-                }
+                std::vector<VtArray<int> > vtMotionArray;
+                ConvertArnoldArrayKeys(array, vtMotionArray);
                 typeName = SdfValueTypeNames->IntArray;
                 attrWriter.ProcessAttributeKeys(writer, typeName, vtMotionArray, motionStart, motionEnd);
-                AiArrayUnmap(array);
                 break;
             }
             case AI_TYPE_UINT: {
-                std::vector<VtArray<unsigned int> > vtMotionArray(numKeys);
-                unsigned int* arrayMap = (unsigned int*)AiArrayMap(array);
-                for (unsigned int j = 0; j < numKeys; ++j) {
-                    VtArray<unsigned int>& vtArr = vtMotionArray[j];
-                    vtArr.resize(numElements);
-                    memcpy(&vtArr[0], &arrayMap[j * numElements], numElements * sizeof(unsigned int));
-                }
+                std::vector<VtArray<unsigned int> > vtMotionArray;
+                ConvertArnoldArrayKeys(array, vtMotionArray);
                 typeName = SdfValueTypeNames->UIntArray;
                 attrWriter.ProcessAttributeKeys(writer, typeName, vtMotionArray, motionStart, motionEnd);
-                AiArrayUnmap(array);
                 break;
             }
             case AI_TYPE_BOOLEAN: {
-                std::vector<VtArray<bool> > vtMotionArray(numKeys);
-                bool* arrayMap = (bool*)AiArrayMap(array);
-                int index = 0;
-                for (unsigned int j = 0; j < numKeys; ++j) {
-                    VtArray<bool>& vtArr = vtMotionArray[j];
-                    vtArr.resize(numElements);
-                    memcpy(&vtArr[0], &arrayMap[j * numElements], numElements * sizeof(bool));
-                }
+                std::vector<VtArray<bool> > vtMotionArray;
+                ConvertArnoldArrayKeys(array, vtMotionArray);
                 typeName = SdfValueTypeNames->BoolArray;
                 attrWriter.ProcessAttributeKeys(writer, typeName, vtMotionArray, motionStart, motionEnd);
-                AiArrayUnmap(array);
                 break;
             }
             case AI_TYPE_FLOAT: {
-                std::vector<VtArray<float> > vtMotionArray(numKeys);
-                float* arrayMap = (float*)AiArrayMap(array);
-                for (unsigned int j = 0; j < numKeys; ++j) {
-                    VtArray<float>& vtArr = vtMotionArray[j];
-                    vtArr.resize(numElements);
-                    memcpy(&vtArr[0], &arrayMap[j * numElements], numElements * sizeof(float));
-                }
+                std::vector<VtArray<float> > vtMotionArray;
+                ConvertArnoldArrayKeys(array, vtMotionArray);
                 typeName = SdfValueTypeNames->FloatArray;
                 attrWriter.ProcessAttributeKeys(writer, typeName, vtMotionArray, motionStart, motionEnd);
-                AiArrayUnmap(array);
                 break;
             }
             case AI_TYPE_RGB: {
-                std::vector<VtArray<GfVec3f> > vtMotionArray(numKeys);
-                GfVec3f* arrayMap = (GfVec3f*)AiArrayMap(array);
-                for (unsigned int j = 0; j < numKeys; ++j) {
-                    VtArray<GfVec3f>& vtArr = vtMotionArray[j];
-                    vtArr.resize(numElements);
-                    memcpy(&vtArr[0], &arrayMap[j * numElements], numElements * sizeof(GfVec3f));
-                }
+                std::vector<VtArray<GfVec3f> > vtMotionArray;
+                ConvertArnoldArrayKeys(array, vtMotionArray);
                 typeName = SdfValueTypeNames->Color3fArray;
                 attrWriter.ProcessAttributeKeys(writer, typeName, vtMotionArray, motionStart, motionEnd);
-                AiArrayUnmap(array);
                 break;
             }
             case AI_TYPE_VECTOR: {
-                std::vector<VtArray<GfVec3f> > vtMotionArray(numKeys);
-                GfVec3f* arrayMap = (GfVec3f*)AiArrayMap(array);
-                for (unsigned int j = 0; j < numKeys; ++j) {
-                    VtArray<GfVec3f>& vtArr = vtMotionArray[j];
-                    vtArr.resize(numElements);
-                    memcpy(&vtArr[0], &arrayMap[j * numElements], numElements * sizeof(GfVec3f));
-                }
+                std::vector<VtArray<GfVec3f> > vtMotionArray;
+                ConvertArnoldArrayKeys(array, vtMotionArray);
                 typeName = SdfValueTypeNames->Vector3fArray;
                 attrWriter.ProcessAttributeKeys(writer, typeName, vtMotionArray, motionStart, motionEnd);
-                AiArrayUnmap(array);
                 break;
             }
             case AI_TYPE_RGBA: {
-                std::vector<VtArray<GfVec4f> > vtMotionArray(numKeys);
-                GfVec4f* arrayMap = (GfVec4f*)AiArrayMap(array);
-                for (unsigned int j = 0; j < numKeys; ++j) {
-                    VtArray<GfVec4f>& vtArr = vtMotionArray[j];
-                    vtArr.resize(numElements);
-                    memcpy(&vtArr[0], &arrayMap[j * numElements], numElements * sizeof(GfVec4f));
-                }
+                std::vector<VtArray<GfVec4f> > vtMotionArray;
+                ConvertArnoldArrayKeys(array, vtMotionArray);
                 typeName = SdfValueTypeNames->Color4fArray;
                 attrWriter.ProcessAttributeKeys(writer, typeName, vtMotionArray, motionStart, motionEnd);
-                AiArrayUnmap(array);
                 break;
             }
             case AI_TYPE_VECTOR2: {
-                std::vector<VtArray<GfVec2f> > vtMotionArray(numKeys);
-                GfVec2f* arrayMap = (GfVec2f*)AiArrayMap(array);
-                for (unsigned int j = 0; j < numKeys; ++j) {
-                    VtArray<GfVec2f>& vtArr = vtMotionArray[j];
-                    vtArr.resize(numElements);
-                    memcpy(&vtArr[0], &arrayMap[j * numElements], numElements * sizeof(GfVec2f));
-                }
+                std::vector<VtArray<GfVec2f> > vtMotionArray;
+                ConvertArnoldArrayKeys(array, vtMotionArray);
                 typeName = SdfValueTypeNames->Float2Array;
                 attrWriter.ProcessAttributeKeys(writer, typeName, vtMotionArray, motionStart, motionEnd);
-                AiArrayUnmap(array);
                 break;
             }
             case AI_TYPE_STRING: {
@@ -758,23 +807,10 @@ static inline bool convertArnoldAttribute(
                 break;
             }
             case AI_TYPE_MATRIX: {
-                std::vector<VtArray<GfMatrix4d> > vtMotionArray(numKeys);
-                AtMatrix* arrayMap = (AtMatrix*)AiArrayMap(array);
-                if (arrayMap) {
-                    int index = 0;
-                    for (unsigned int j = 0; j < numKeys; ++j) {
-                        VtArray<GfMatrix4d>& vtArr = vtMotionArray[j];
-                        vtArr.resize(numElements);
-                        for (unsigned int i = 0; i < numElements; ++i, ++index) {
-                            const AtMatrix mat = arrayMap[index];
-                            GfMatrix4f matFlt(mat.data);
-                            vtArr[i] = GfMatrix4d(matFlt);
-                        }
-                    }
-                    typeName = SdfValueTypeNames->Matrix4dArray;
-                    attrWriter.ProcessAttributeKeys(writer, typeName, vtMotionArray, motionStart, motionEnd);
-                }
-                AiArrayUnmap(array);
+                std::vector<VtArray<GfMatrix4d> > vtMotionArray;
+                ConvertArnoldArrayKeys(array, vtMotionArray);
+                typeName = SdfValueTypeNames->Matrix4dArray;
+                attrWriter.ProcessAttributeKeys(writer, typeName, vtMotionArray, motionStart, motionEnd);
                 break;
             }
 
@@ -956,8 +992,7 @@ void UsdArnoldPrimWriter::_WriteArnoldParameters(
             
         }
         // This parameter was already exported, let's skip it
-        if (!_exportedAttrs.empty() &&
-            std::find(_exportedAttrs.begin(), _exportedAttrs.end(), std::string(paramName)) != _exportedAttrs.end())
+        if (!_exportedAttrs.empty() && _exportedAttrs.count(paramName) != 0)
             continue;
 
         attrs.insert(paramName);
@@ -1013,6 +1048,9 @@ bool UsdArnoldPrimWriter::WriteAttribute(
 void UsdArnoldPrimWriter::_WriteMatrix(UsdGeomXformable& xformable, const AtNode* node, UsdArnoldWriter& writer)
 {
     _exportedAttrs.insert("matrix");
+    // The transform of a prototype shape is set on each of its instances
+    if (node == writer.GetPrototypeNode())
+        return;
     AtArray* array = AiNodeGetArray(node, "matrix");
     if (array == nullptr)
         return;
@@ -1031,35 +1069,110 @@ void UsdArnoldPrimWriter::_WriteMatrix(UsdGeomXformable& xformable, const AtNode
         }
     }
     // Identity matrix, nothing to write
-    if (!hasMatrix)
+    if (!hasMatrix) {
+        AiArrayUnmap(array);
         return;
+    }
 
-    UsdGeomXformOp xformOp = xformable.MakeMatrixXform();
-    UsdAttribute attr = xformOp.GetAttr();
-    std::vector<double> xform;
-    xform.reserve(16);
-    // Get array of times based on motion_start / motion_end
-    
-    double m[4][4];
-    bool hasMotion = (numKeys > 1);
-    float timeDelta =  hasMotion ? (_motionEnd - _motionStart) / (int)(numKeys - 1) : 0.f;
-    float time = _motionStart;
-
+    std::vector<GfMatrix4d> xforms(numKeys);
     for (unsigned int k = 0; k < numKeys; ++k) {
-        AtMatrix& mtx = matrices[k];
-        for (int i = 0; i < 4; ++i) {
-            for (int j = 0; j < 4; ++j) {
-                m[i][j] = mtx[i][j];
-            }
-        }
-        writer.SetAttribute(attr, GfMatrix4d(m), (hasMotion) ? &time : nullptr);
-        time += timeDelta;
+        const float* in = &matrices[k].data[0][0];
+        double* out = xforms[k].data();
+        for (int i = 0; i < 16; ++i)
+            out[i] = static_cast<double>(in[i]);
     }
     AiArrayUnmap(array);
+
+    if (writer.GetCompactEncoding() && _WriteCompactXform(xformable, xforms, writer))
+        return;
+    writer.SetAttributeKeys(xformable.MakeMatrixXform().GetAttr(), xforms, _motionStart, _motionEnd);
+}
+
+bool UsdArnoldPrimWriter::_WriteCompactXform(
+    UsdGeomXformable& xformable, const std::vector<GfMatrix4d>& xforms, UsdArnoldWriter& writer)
+{
+    // When several frames are written to the same prim, the ops written for the previous
+    // frames are reused. If they were a matrix op, we keep writing the matrix
+    bool resetsXformStack = false;
+    std::vector<UsdGeomXformOp> ops = xformable.GetOrderedXformOps(&resetsXformStack);
+    for (const auto& op : ops) {
+        if (!_IsCompactXformOp(op))
+            return false;
+    }
+
+    // Arnold matrices are single precision, but matrix xform ops can only be double.
+    // Transforms without shear or projection are written as float translate, orient
+    // and scale ops, as long as they reproduce the Arnold matrices
+    std::vector<GfVec3f> translates(xforms.size());
+    std::vector<GfQuatf> orients(xforms.size());
+    std::vector<GfVec3f> scales(xforms.size());
+    bool hasTranslate = false;
+    bool hasOrient = false;
+    bool hasScale = false;
+    bool decomposed = true;
+    for (size_t k = 0; k < xforms.size(); ++k) {
+        decomposed = _DecomposeMatrix(xforms[k], translates[k], orients[k], scales[k]);
+        if (!decomposed)
+            break;
+        // Keep the rotations on the same hemisphere, so they're interpolated on the shortest path
+        if (k > 0 && GfDot(orients[k], orients[k - 1]) < 0.f)
+            orients[k] = orients[k] * -1.f;
+        hasTranslate = hasTranslate || translates[k] != GfVec3f(0.f);
+        hasOrient = hasOrient || orients[k] != GfQuatf::GetIdentity();
+        hasScale = hasScale || scales[k] != GfVec3f(1.f);
+    }
+
+    if (ops.empty()) {
+        if (!decomposed)
+            return false;
+        // The ops can't be added or reordered once a frame was written, so when writing a
+        // specific time all of them are added, in case the following frames need them
+        const bool allOps = !writer.GetTime().IsDefault();
+        if (hasTranslate || allOps)
+            ops.push_back(xformable.AddTranslateOp(UsdGeomXformOp::PrecisionFloat));
+        if (hasOrient || allOps)
+            ops.push_back(xformable.AddOrientOp(UsdGeomXformOp::PrecisionFloat));
+        if (hasScale || allOps)
+            ops.push_back(xformable.AddScaleOp(UsdGeomXformOp::PrecisionFloat));
+    } else {
+        bool hasTranslateOp = false;
+        bool hasOrientOp = false;
+        bool hasScaleOp = false;
+        for (const auto& op : ops) {
+            hasTranslateOp = hasTranslateOp || op.GetOpType() == UsdGeomXformOp::TypeTranslate;
+            hasOrientOp = hasOrientOp || op.GetOpType() == UsdGeomXformOp::TypeOrient;
+            hasScaleOp = hasScaleOp || op.GetOpType() == UsdGeomXformOp::TypeScale;
+        }
+        // If the previous ops can't represent this frame, they're converted to a matrix op
+        // that will store the matrices of this frame
+        if (!decomposed || (hasTranslate && !hasTranslateOp) || (hasOrient && !hasOrientOp) ||
+            (hasScale && !hasScaleOp)) {
+            _BakeXformOps(xformable, ops);
+            return false;
+        }
+    }
+    for (const auto& op : ops) {
+        UsdAttribute attr = op.GetAttr();
+        switch (op.GetOpType()) {
+            case UsdGeomXformOp::TypeTranslate:
+                writer.SetAttributeKeys(attr, translates, _motionStart, _motionEnd);
+                break;
+            case UsdGeomXformOp::TypeOrient:
+                writer.SetAttributeKeys(attr, orients, _motionStart, _motionEnd);
+                break;
+            default:
+                writer.SetAttributeKeys(attr, scales, _motionStart, _motionEnd);
+                break;
+        }
+    }
+    return true;
 }
 
 static void processMaterialBinding(AtNode* shader, AtNode* displacement, UsdPrim& prim, UsdArnoldWriter& writer)
 {
+    // Shapes using identical shading networks bind to the same material
+    shader = (AtNode*)writer.GetSharedShader(shader);
+    displacement = (AtNode*)writer.GetSharedShader(displacement);
     std::string shaderName = (shader) ? UsdArnoldPrimWriter::GetArnoldNodeName(shader, writer) : "";
     std::string dispName = (displacement) ? UsdArnoldPrimWriter::GetArnoldNodeName(displacement, writer) : "";
 
@@ -13,11 +13,14 @@
 // limitations under the License.
 #pragma once
 
+#include <ai_array.h>
 #include <ai_msg.h>
 #include <ai_node_entry.h>
 #include <ai_nodes.h>
 #include <ai_params.h>
 
+#include <pxr/base/gf/matrix4d.h>
+#include <pxr/base/vt/array.h>
 #include <pxr/usd/usd/prim.h>
 #include <pxr/usd/usdGeom/xformable.h>
 #include <string>
@@ -28,6 +31,72 @@
 
 PXR_NAMESPACE_USING_DIRECTIVE
 
+/**
+ *   Converts all the motion keys of an Arnold array to VtArrays, mapping the Arnold array a single time.
+ *   ArnoldT is the type of the elements stored in the Arnold array. When it's the same as the USD type, each
+ *   key is copied with a single memcpy, otherwise the elements are converted in a tight loop that the compiler
+ *   can vectorize (ie. unsigned int to int).
+ **/
+template <typename UsdT, typename ArnoldT = UsdT>
+inline void ConvertArnoldArrayKeys(AtArray *array, std::vector<VtArray<UsdT> > &keys)
+{
+    const unsigned int numElements = AiArrayGetNumElements(array);
+    const unsigned int numKeys = AiArrayGetNumKeys(array);
+    keys.resize(numKeys);
+    const ArnoldT *arrayMap = static_cast<const ArnoldT *>(AiArrayMap(array));
+    if (arrayMap != nullptr) {
+        for (unsigned int j = 0; j < numKeys; ++j, arrayMap += numElements) {
+            keys[j].assign(arrayMap, arrayMap + numElements);
+        }
+    }
+    AiArrayUnmap(array);
+}
+
+/**
+ *   Arnold matrices are stored as floats and USD matrix arrays as doubles. Both are contiguous blocks of 16 values
+ *   per element, so each key is converted with a single loop over all the components.
+ **/
+inline void ConvertArnoldArrayKeys(AtArray *array, std::vector<VtArray<GfMatrix4d> > &keys)
+{
+    static_assert(sizeof(AtMatrix) == 16 * sizeof(float), "AtMatrix must be 16 contiguous floats");
+    static_assert(sizeof(GfMatrix4d) == 16 * sizeof(double), "GfMatrix4d must be 16 contiguous doubles");
+    const unsigned int numElements = AiArrayGetNumElements(array);
+    const unsigned int numKeys = AiArrayGetNumKeys(array);
+    keys.resize(numKeys);
+    const AtMatrix *arrayMap = static_cast<const AtMatrix *>(AiArrayMap(array));
+    if (arrayMap != nullptr) {
+        for (unsigned int j = 0; j < numKeys; ++j, arrayMap += numElements) {
+            VtArray<GfMatrix4d> &vtArr = keys[j];
+            vtArr.resize(numElements);
+            if (numElements == 0) {
+                continue;
+            }
+            const float *in = &arrayMap->data[0][0];
+            double *out = vtArr.data()->data();
+            for (size_t i = 0, numValues = size_t{16} * numElements; i < numValues; ++i) {
+                out[i] = static_cast<double>(in[i]);
+            }
+        }
+    }
+    AiArrayUnmap(array);
+}
+
+/**
+ *   Converts the first motion key of an Arnold array to a VtArray, see ConvertArnoldArrayKeys.
+ **/
+template <typename UsdT, typename ArnoldT = UsdT>
+inline void ConvertArnoldArray(AtArray *array, VtArray<UsdT> &values)
+{
+    const unsigned int numElements = AiArrayGetNumElements(array);
+    const ArnoldT *arrayMap = static_cast<const ArnoldT *>(AiArrayMap(array));
+    if (arrayMap != nullptr) {
+        values.assign(arrayMap, arrayMap + numElements);
+    } else {
+        values.clear();
+    }
+    AiArrayUnmap(array);
+}
+
 /**
  *   Base Class for a UsdPrim writer. This class is in charge of converting
  *Arnold primitives to USD
@@ -58,7 +127,7 @@ public:
     static const ParamConversion *GetParamConversion(uint8_t type);
     // This function returns the name we want to give to this AtNode when it's
     // converted to USD
-    static std::string GetArnoldNodeName(const AtNode *node, const UsdArnoldWriter &writer);
+    static const std::string &GetArnoldNodeName(const AtNode *node, const UsdArnoldWriter &writer);
     bool WriteAttribute(
         const AtNode *node, const char *paramName, UsdPrim &prim, const UsdAttribute &attr, UsdArnoldWriter &writer);
 
@@ -70,6 +139,10 @@ protected:
     void _WriteArnoldParameters(
         const AtNode *node, UsdArnoldWriter &writer, UsdPrim &prim, const std::string &scope = "arnold");
     void _WriteMatrix(UsdGeomXformable &xform, const AtNode *node, UsdArnoldWriter &writer);
+    // Write the transform as single precision translate / orient / scale ops, returns false if
+    // the matrices can't be decomposed
+    bool _WriteCompactXform(
+        UsdGeomXformable &xformable, const std::vector<GfMatrix4d> &xforms, UsdArnoldWriter &writer);
     void _WriteMaterialBinding(
         const AtNode *node, UsdPrim &prim, UsdArnoldWriter &writer, AtArray *shidxsArray = nullptr);
     std::unordered_set<std::string> _exportedAttrs; // list of arnold attributes that were exported
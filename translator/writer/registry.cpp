@@ -34,6 +34,7 @@ PXR_NAMESPACE_USING_DIRECTIVE
 
 // For now we're not registering any writer
 UsdArnoldWriterRegistry::UsdArnoldWriterRegistry(bool writeBuiltin)
+    : _writeBuiltin(writeBuiltin), _customWriters(false)
 {
     // TODO: write to builtin USD types. For now we're creating these nodes as
     // Arnold-Typed primitives at the end of this function
@@ -78,7 +79,7 @@ UsdArnoldWriterRegistry::UsdArnoldWriterRegistry(bool writeBuiltin)
         // if a primWriter is already registed for this AtNodeEntry (i.e. from
         // the above list), then we should skip it. We want these nodes to be
         // exported as USD native primitive
-        if (GetPrimWriter(entryName)) {
+        if (GetPrimWriter(nodeEntry)) {
             continue;
         }
 
@@ -111,12 +112,14 @@ UsdArnoldWriterRegistry::UsdArnoldWriterRegistry(bool writeBuiltin)
     if (universeCreated) {
         AiEnd();
     }
+    // Only the writers registered from now on are custom
+    _customWriters = false;
 }
 UsdArnoldWriterRegistry::~UsdArnoldWriterRegistry()
 {
     // Delete all the prim readers that were registed here
-    std::unordered_map<std::string, UsdArnoldPrimWriter *>::iterator it = _writersMap.begin();
-    std::unordered_map<std::string, UsdArnoldPrimWriter *>::iterator itEnd = _writersMap.end();
+    WritersMap::iterator it = _writersMap.begin();
+    WritersMap::iterator itEnd = _writersMap.end();
 
     for (; it != itEnd; ++it) {
         delete it->second;
@@ -130,11 +133,13 @@ UsdArnoldWriterRegistry::~UsdArnoldWriterRegistry()
  **/
 void UsdArnoldWriterRegistry::RegisterWriter(const std::string &primName, UsdArnoldPrimWriter *primWriter)
 {
-    std::unordered_map<std::string, UsdArnoldPrimWriter *>::iterator it = _writersMap.find(primName);
+    const AtString primNameStr(primName.c_str());
+    WritersMap::iterator it = _writersMap.find(primNameStr);
     if (it != _writersMap.end()) {
         // we have already registered a reader for this node type, let's delete
         // the existing one and override it
         delete it->second;
     }
-    _writersMap[primName] = primWriter;
+    _writersMap[primNameStr] = primWriter;
+    _customWriters = true;
 }
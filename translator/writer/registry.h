@@ -13,7 +13,9 @@
 // limitations under the License.
 #pragma once
 
+#include <ai_node_entry.h>
 #include <ai_nodes.h>
+#include <ai_string.h>
 
 #include <pxr/usd/usd/prim.h>
 
@@ -41,9 +43,26 @@ public:
     // deleted and overridden
     void RegisterWriter(const std::string &primName, UsdArnoldPrimWriter *primWriter);
 
+    // Returns true if writers were registered after the construction of the registry. Otherwise
+    // an identical registry can be created for each thread writing a universe
+    bool HasCustomWriters() const { return _customWriters; }
+    bool GetWriteBuiltin() const { return _writeBuiltin; }
+
     UsdArnoldPrimWriter *GetPrimWriter(const std::string &primName)
     {
-        std::unordered_map<std::string, UsdArnoldPrimWriter *>::iterator it = _writersMap.find(primName);
+        return _GetPrimWriter(AtString(primName.c_str()));
+    }
+    // Faster lookup for the writer of a node entry, whose name is already stored
+    // as an AtString, and doesn't need to be hashed again
+    UsdArnoldPrimWriter *GetPrimWriter(const AtNodeEntry *nodeEntry)
+    {
+        return _GetPrimWriter(AiNodeEntryGetNameAtString(nodeEntry));
+    }
+
+private:
+    UsdArnoldPrimWriter *_GetPrimWriter(const AtString &primName)
+    {
+        WritersMap::iterator it = _writersMap.find(primName);
         if (it == _writersMap.end())
             return nullptr; // return NULL if no writer was registered for this
                             // node type, it will be skipped
@@ -51,6 +70,8 @@ public:
         return it->second;
     }
 
-private:
-    std::unordered_map<std::string, UsdArnoldPrimWriter *> _writersMap;
+    using WritersMap = std::unordered_map<AtString, UsdArnoldPrimWriter *, AtStringHash>;
+    WritersMap _writersMap;
+    bool _writeBuiltin;
+    bool _customWriters;
 };
@@ -48,7 +48,7 @@ TF_DEFINE_PRIVATE_TOKENS(
 void UsdArnoldWriteArnoldType::Write(const AtNode *node, UsdArnoldWriter &writer)
 {
      // get the output name of this USD primitive 
-    std::string nodeName = GetArnoldNodeName(node, writer);
+    const std::string &nodeName = GetArnoldNodeName(node, writer);
     UsdStageRefPtr stage = writer.GetUsdStage();    // get the current stage defined in the writer
     SdfPath objPath(nodeName);
 
@@ -157,7 +157,7 @@ void UsdArnoldWriteGinstance::_ProcessInstanceAttribute(
 void UsdArnoldWriteGinstance::Write(const AtNode *node, UsdArnoldWriter &writer)
 {
     // get the output name of this USD primitive
-    std::string nodeName = GetArnoldNodeName(node, writer);
+    const std::string &nodeName = GetArnoldNodeName(node, writer);
     UsdStageRefPtr stage = writer.GetUsdStage();    // get the current stage defined in the writer
     SdfPath objPath(nodeName);
 
@@ -174,7 +174,7 @@ void UsdArnoldWriteGinstance::Write(const AtNode *node, UsdArnoldWriter &writer)
         _ProcessInstanceAttribute(prim, node, target, "self_shadows", AI_TYPE_BOOLEAN, writer);
 
         writer.WritePrimitive(target);
-        std::string targetName = GetArnoldNodeName(target, writer);
+        const std::string &targetName = GetArnoldNodeName(target, writer);
         SdfPath targetPath(targetName);
         UsdPrim targetPrim = stage->GetPrimAtPath(targetPath);
         UsdGeomBoundable targetBoundable(targetPrim);
@@ -32,7 +32,7 @@ PXR_NAMESPACE_USING_DIRECTIVE
 
 void UsdArnoldWriteCamera::Write(const AtNode *node, UsdArnoldWriter &writer)
 {
-    std::string nodeName = GetArnoldNodeName(node, writer); // what is the USD name for this primitive
+    const std::string &nodeName = GetArnoldNodeName(node, writer); // what is the USD name for this primitive
     UsdStageRefPtr stage = writer.GetUsdStage();    // Get the USD stage defined in the writer
     SdfPath objPath(nodeName);
     writer.CreateHierarchy(objPath);
@@ -31,7 +31,7 @@ PXR_NAMESPACE_USING_DIRECTIVE
 
 void UsdArnoldWriteMesh::Write(const AtNode *node, UsdArnoldWriter &writer)
 {
-    std::string nodeName = GetArnoldNodeName(node, writer); // what is the USD name for this primitive
+    const std::string &nodeName = GetArnoldNodeName(node, writer); // what is the USD name for this primitive
     UsdStageRefPtr stage = writer.GetUsdStage();    // Get the USD stage defined in the writer
     SdfPath objPath(nodeName);    
     writer.CreateHierarchy(objPath);
@@ -45,23 +45,15 @@ void UsdArnoldWriteMesh::Write(const AtNode *node, UsdArnoldWriter &writer)
     AtArray *vidxs = AiNodeGetArray(node, "vidxs");
     VtArray<int> vtArrIdxs;
     if (vidxs) {
-        unsigned int nelems = AiArrayGetNumElements(vidxs);
-        vtArrIdxs.resize(nelems);
-        for (unsigned int i = 0; i < nelems; ++i) {
-            vtArrIdxs[i] = (int)AiArrayGetUInt(vidxs, i);
-        }
+        // vidxs and nsides are unsigned int arrays in Arnold, but int arrays in USD
+        ConvertArnoldArray<int, unsigned int>(vidxs, vtArrIdxs);
         writer.SetAttribute(mesh.GetFaceVertexIndicesAttr(), vtArrIdxs);
     }
     _exportedAttrs.insert("vidxs");
     AtArray *nsides = AiNodeGetArray(node, "nsides");
     VtArray<int> vtArrNsides;
     if (nsides) {
-        unsigned int nelems = AiArrayGetNumElements(nsides);
-        if (nelems > 0) {
-            vtArrNsides.resize(nelems);
-            for (unsigned int i = 0; i < nelems; ++i)
-                vtArrNsides[i] = (unsigned char)AiArrayGetUInt(nsides, i);
-        }
+        ConvertArnoldArray<int, unsigned int>(nsides, vtArrNsides);
     }
     if (vtArrNsides.empty()) {
         // For arnold, empty nsides means that all the polygons are triangles.
@@ -81,26 +73,17 @@ void UsdArnoldWriteMesh::Write(const AtNode *node, UsdArnoldWriter &writer)
         UsdGeomPrimvar uvPrimVar =
             mesh.CreatePrimvar(uvToken, SdfValueTypeNames->Float2Array, UsdGeomTokens->faceVarying, uvlistNumElems);
 
-        VtArray<GfVec2f> uvValues(uvlistNumElems);
-        AtVector2 *uvArrayValues = static_cast<AtVector2 *>(AiArrayMap(uvlist));
-        for (unsigned int i = 0; i < uvlistNumElems; ++i) {
-            uvValues[i] = GfVec2f(uvArrayValues[i].x, uvArrayValues[i].y);
-        }
+        VtArray<GfVec2f> uvValues;
+        ConvertArnoldArray(uvlist, uvValues);
         writer.SetPrimVar(uvPrimVar, uvValues);
-        AiArrayUnmap(uvlist);
 
         // check if the indices are present
         AtArray *uvidxsArray = AiNodeGetArray(node, "uvidxs");
         unsigned int uvidxsSize = (uvidxsArray) ? AiArrayGetNumElements(uvidxsArray) : 0;
         if (uvidxsSize > 0) {
-            uint32_t *uvidxs = static_cast<uint32_t *>(AiArrayMap(uvidxsArray));
-
-            VtIntArray vtIndices(uvidxsSize);
-            for (unsigned int i = 0; i < uvidxsSize; ++i) {
-                vtIndices[i] = uvidxs[i];
-            }
+            VtIntArray vtIndices;
+            ConvertArnoldArray<int, uint32_t>(uvidxsArray, vtIndices);
             writer.SetPrimVarIndices(uvPrimVar, vtIndices);
-            AiArrayUnmap(uvidxsArray);
         }
     }
     AtArray *nlist = AiNodeGetArray(node, "nlist");
@@ -111,38 +94,17 @@ void UsdArnoldWriteMesh::Write(const AtNode *node, UsdArnoldWriter &writer)
         UsdGeomPrimvar normalsPrimVar = mesh.CreatePrimvar(
             normalsToken, SdfValueTypeNames->Vector3fArray, UsdGeomTokens->faceVarying, nlistNumElems);
 
-        VtArray<GfVec3f> normalsValues(nlistNumElems);
-        unsigned int nlistNumKeys = AiArrayGetNumKeys(nlist);
-        AtVector *nlistArrayValues = static_cast<AtVector *>(AiArrayMap(nlist));
-
-        if (nlistNumKeys > 1 && _motionStart < _motionEnd) {
-            float timeDelta = (_motionEnd - _motionStart) / (int)(nlistNumKeys - 1);
-            float time = _motionStart;
-
-            for (unsigned int j = 0; j < nlistNumKeys; ++j, time += timeDelta) {
-                memcpy(normalsValues.data(), nlistArrayValues, nlistNumElems * sizeof(GfVec3f));
-                nlistArrayValues += nlistNumElems;
-                writer.SetPrimVar(normalsPrimVar, normalsValues, &time);
-            }
-
-        } else {
-            memcpy(normalsValues.data(), nlistArrayValues, nlistNumElems * sizeof(GfVec3f));
-            writer.SetPrimVar(normalsPrimVar, normalsValues);
-        }
-        
-        AiArrayUnmap(nlist);
+        std::vector<VtArray<GfVec3f>> normalsValues;
+        ConvertArnoldArrayKeys(nlist, normalsValues);
+        writer.SetAttributeKeys(normalsPrimVar.GetAttr(), normalsValues, _motionStart, _motionEnd);
 
         // check if the indices are present
         AtArray *nidxsArray = AiNodeGetArray(node, "nidxs");
         unsigned int nidxsSize = (nidxsArray) ? AiArrayGetNumElements(nidxsArray) : 0;
         if (nidxsSize > 0) {
-            uint32_t *nidxs = static_cast<uint32_t *>(AiArrayMap(nidxsArray));
-            VtIntArray vtIndices(nidxsSize);
-            for (unsigned int i = 0; i < nidxsSize; ++i) {
-                vtIndices[i] = nidxs[i];
-            }
+            VtIntArray vtIndices;
+            ConvertArnoldArray<int, uint32_t>(nidxsArray, vtIndices);
             writer.SetPrimVarIndices(normalsPrimVar, vtIndices);
-            AiArrayUnmap(nidxsArray);
         }
     }
     AtString subdivType = AiNodeGetStr(node, "subdiv_type");
@@ -184,7 +146,7 @@ void UsdArnoldWriteMesh::Write(const AtNode *node, UsdArnoldWriter &writer)
 
 void UsdArnoldWriteCurves::Write(const AtNode *node, UsdArnoldWriter &writer)
 {
-    std::string nodeName = GetArnoldNodeName(node, writer); // what is the USD name for this primitive
+    const std::string &nodeName = GetArnoldNodeName(node, writer); // what is the USD name for this primitive
     UsdStageRefPtr stage = writer.GetUsdStage();    // Get the USD stage defined in the writer
     SdfPath objPath(nodeName);    
     writer.CreateHierarchy(objPath);
@@ -218,13 +180,9 @@ void UsdArnoldWriteCurves::Write(const AtNode *node, UsdArnoldWriter &writer)
     AtArray *numPointsArray = AiNodeGetArray(node, "num_points");
     unsigned int numPointsCount = (numPointsArray) ? AiArrayGetNumElements(numPointsArray) : 0;
     if (numPointsCount > 0) {
-        VtArray<int> vertexCountArray(numPointsCount);
-        unsigned int *in = static_cast<unsigned int *>(AiArrayMap(numPointsArray));
-        for (unsigned int i = 0; i < numPointsCount; ++i) {
-            vertexCountArray[i] = (int)in[i];
-        }
+        VtArray<int> vertexCountArray;
+        ConvertArnoldArray<int, unsigned int>(numPointsArray, vertexCountArray);
         writer.SetAttribute(curves.GetCurveVertexCountsAttr(), vertexCountArray);
-        AiArrayUnmap(numPointsArray);
     }
     _exportedAttrs.insert("num_points");
 
@@ -257,7 +215,7 @@ void UsdArnoldWriteCurves::Write(const AtNode *node, UsdArnoldWriter &writer)
 
 void UsdArnoldWritePoints::Write(const AtNode *node, UsdArnoldWriter &writer)
 {
-    std::string nodeName = GetArnoldNodeName(node, writer); // what is the USD name for this primitive
+    const std::string &nodeName = GetArnoldNodeName(node, writer); // what is the USD name for this primitive
     UsdStageRefPtr stage = writer.GetUsdStage();    // Get the USD stage defined in the writer
     SdfPath objPath(nodeName);    
     writer.CreateHierarchy(objPath);
@@ -290,7 +248,7 @@ void UsdArnoldWritePoints::Write(const AtNode *node, UsdArnoldWriter &writer)
 }
 void UsdArnoldWriteProceduralCustom::Write(const AtNode *node, UsdArnoldWriter &writer)
 {
-    std::string nodeName = GetArnoldNodeName(node, writer); // what should be the name of this USD primitive
+    const std::string &nodeName = GetArnoldNodeName(node, writer); // what should be the name of this USD primitive
     UsdStageRefPtr stage = writer.GetUsdStage();    // get the current stage defined in the writer
     SdfPath objPath(nodeName);
     _exportedAttrs.insert("name");
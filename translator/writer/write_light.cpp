@@ -48,7 +48,7 @@ void writeLightCommon(const AtNode *node, UsdLuxLight &light, UsdArnoldPrimWrite
 
 void UsdArnoldWriteDistantLight::Write(const AtNode *node, UsdArnoldWriter &writer)
 {
-    std::string nodeName = GetArnoldNodeName(node, writer);
+    const std::string &nodeName = GetArnoldNodeName(node, writer);
     UsdStageRefPtr stage = writer.GetUsdStage();    // Get the USD stage defined in the writer
     SdfPath objPath(nodeName);        
     writer.CreateHierarchy(objPath);
@@ -63,7 +63,7 @@ void UsdArnoldWriteDistantLight::Write(const AtNode *node, UsdArnoldWriter &writ
 
 void UsdArnoldWriteDomeLight::Write(const AtNode *node, UsdArnoldWriter &writer)
 {
-    std::string nodeName = GetArnoldNodeName(node, writer);
+    const std::string &nodeName = GetArnoldNodeName(node, writer);
     UsdStageRefPtr stage = writer.GetUsdStage();    // Get the USD stage defined in the writer
     SdfPath objPath(nodeName);
     writer.CreateHierarchy(objPath);
@@ -103,7 +103,7 @@ void UsdArnoldWriteDomeLight::Write(const AtNode *node, UsdArnoldWriter &writer)
 
 void UsdArnoldWriteDiskLight::Write(const AtNode *node, UsdArnoldWriter &writer)
 {
-    std::string nodeName = GetArnoldNodeName(node, writer);
+    const std::string &nodeName = GetArnoldNodeName(node, writer);
     UsdStageRefPtr stage = writer.GetUsdStage();    // Get the USD stage defined in the writer
     SdfPath objPath(nodeName);    
     writer.CreateHierarchy(objPath);
@@ -119,7 +119,7 @@ void UsdArnoldWriteDiskLight::Write(const AtNode *node, UsdArnoldWriter &writer)
 
 void UsdArnoldWriteSphereLight::Write(const AtNode *node, UsdArnoldWriter &writer)
 {
-    std::string nodeName = GetArnoldNodeName(node, writer);
+    const std::string &nodeName = GetArnoldNodeName(node, writer);
     UsdStageRefPtr stage = writer.GetUsdStage();    // Get the USD stage defined in the writer
     SdfPath objPath(nodeName);    
     writer.CreateHierarchy(objPath);
@@ -144,7 +144,7 @@ void UsdArnoldWriteSphereLight::Write(const AtNode *node, UsdArnoldWriter &write
 
 void UsdArnoldWriteRectLight::Write(const AtNode *node, UsdArnoldWriter &writer)
 {
-    std::string nodeName = GetArnoldNodeName(node, writer);
+    const std::string &nodeName = GetArnoldNodeName(node, writer);
     UsdStageRefPtr stage = writer.GetUsdStage();    // Get the USD stage defined in the writer
     SdfPath objPath(nodeName);    
     writer.CreateHierarchy(objPath);
@@ -203,7 +203,7 @@ void UsdArnoldWriteRectLight::Write(const AtNode *node, UsdArnoldWriter &writer)
 
 void UsdArnoldWriteGeometryLight::Write(const AtNode *node, UsdArnoldWriter &writer)
 {
-    std::string nodeName = GetArnoldNodeName(node, writer);
+    const std::string &nodeName = GetArnoldNodeName(node, writer);
     UsdStageRefPtr stage = writer.GetUsdStage();    // Get the USD stage defined in the writer
     SdfPath objPath(nodeName);    
     writer.CreateHierarchy(objPath);
@@ -217,7 +217,7 @@ void UsdArnoldWriteGeometryLight::Write(const AtNode *node, UsdArnoldWriter &wri
     AtNode *mesh = (AtNode *)AiNodeGetPtr(node, "mesh");
     if (mesh) {
         writer.WritePrimitive(mesh);
-        std::string meshName = GetArnoldNodeName(mesh, writer);
+        const std::string &meshName = GetArnoldNodeName(mesh, writer);
         light.CreateGeometryRel().AddTarget(SdfPath(meshName));
     }
     _WriteArnoldParameters(node, writer, prim, "primvars:arnold");
@@ -15,15 +15,32 @@
 
 #include <ai.h>
 
+#include <pxr/base/arch/hash.h>
+#include <pxr/base/gf/matrix4d.h>
+#include <pxr/base/work/loops.h>
+#include <pxr/base/work/threadLimits.h>
 #include <pxr/usd/ar/resolver.h>
+#include <pxr/usd/sdf/attributeSpec.h>
+#include <pxr/usd/sdf/changeBlock.h>
+#include <pxr/usd/sdf/copyUtils.h>
+#include <pxr/usd/sdf/layer.h>
+#include <pxr/usd/sdf/primSpec.h>
+#include <pxr/usd/sdf/propertySpec.h>
+#include <pxr/usd/sdf/schema.h>
 #include <pxr/usd/usd/prim.h>
 #include <pxr/usd/usd/primRange.h>
 #include <pxr/usd/usd/stage.h>
+#include <pxr/usd/usdGeom/subset.h>
 #include <pxr/usd/usdGeom/xform.h>
+#include <pxr/usd/usdShade/materialBindingAPI.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cstdio>
 #include <cstring>
+#include <functional>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "prim_writer.h"
@@ -43,6 +60,292 @@ TF_DEFINE_PRIVATE_TOKENS(_tokens,
 // global writer registry, will be used in the default case
 static UsdArnoldWriterRegistry *s_writerRegistry = nullptr;
 
+// Amount of chunks the nodes are split in when writing from multiple threads. It doesn't
+// depend on the amount of threads, so that the output is the same for any thread count
+static const size_t s_writerChunkCount = 256;
+
+namespace {
+
+// Contiguous range of nodes written to its own layer by one of the threads
+struct UsdArnoldWriterChunk {
+    size_t begin = 0;
+    size_t end = 0;
+    UsdStageRefPtr stage;
+    std::unordered_set<AtString, AtStringHash> exportedNodes; // nodes exported while writing the chunk
+};
+
+struct UsdArnoldWriterThreadData {
+    UsdArnoldWriter *writer = nullptr;
+    const std::vector<const AtNode *> *nodes = nullptr;
+    std::vector<UsdArnoldWriterChunk> *chunks = nullptr;
+    std::atomic<size_t> *nextChunk = nullptr;
+};
+
+// Merge a primitive authored in a thread layer to the destination layer.
+// If the primitive doesn't exist yet we can copy it as a whole, otherwise we
+// copy its fields and properties, and merge its children recursively
+void _MergePrimSpec(const SdfLayerHandle &srcLayer, const SdfPrimSpecHandle &srcPrim, const SdfLayerHandle &dstLayer)
+{
+    const SdfPath &path = srcPrim->GetPath();
+    SdfPrimSpecHandle dstPrim = dstLayer->GetPrimAtPath(path);
+    if (!dstPrim) {
+        SdfCopySpec(srcLayer, path, dstLayer, path);
+        return;
+    }
+    for (const TfToken &field : srcLayer->ListFields(path)) {
+        // children are merged below, and we don't want to turn a "def" into an "over"
+        if (field == SdfChildrenKeys->PrimChildren || field == SdfChildrenKeys->PropertyChildren ||
+            (field == SdfFieldKeys->Specifier && srcPrim->GetSpecifier() == SdfSpecifierOver))
+            continue;
+        dstLayer->SetField(path, field, srcLayer->GetField(path, field));
+    }
+    for (const SdfPropertySpecHandle &srcProperty : srcPrim->GetProperties()) {
+        SdfCopySpec(srcLayer, srcProperty->GetPath(), dstLayer, srcProperty->GetPath());
+    }
+    for (const SdfPrimSpecHandle &srcChild : srcPrim->GetNameChildren()) {
+        _MergePrimSpec(srcLayer, srcChild, dstLayer);
+    }
+}
+
+// Parameters of a node that must be identical for it to be shared with other nodes, ie. a shape
+// sharing a prototype or a shader sharing its network. Scalar values are packed in a byte buffer,
+// while arrays are compared by their contents
+struct NodeSignature {
+    std::string scalars;
+    std::vector<const AtArray *> arrays;
+    uint64_t hash = 0;
+    bool valid = false;
+};
+
+// Returns the node written in place of a node referenced by the node being compared
+using NodeResolver = std::function<const AtNode *(const AtNode *)>;
+
+template <typename T>
+inline void _AppendBytes(std::string &buffer, const T &value)
+{
+    buffer.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+inline size_t _GetArrayDataSize(const AtArray *array)
+{
+    return (size_t)AiArrayGetKeySize(array) * (size_t)AiArrayGetNumKeys(array);
+}
+
+bool _AppendParameter(
+    NodeSignature &signature, const AtNode *node, const AtString &name, int type, const NodeResolver *resolver)
+{
+    std::string &scalars = signature.scalars;
+    switch (type) {
+        case AI_TYPE_BYTE:
+            _AppendBytes(scalars, AiNodeGetByte(node, name));
+            return true;
+        case AI_TYPE_INT:
+        case AI_TYPE_ENUM:
+            _AppendBytes(scalars, AiNodeGetInt(node, name));
+            return true;
+        case AI_TYPE_UINT:
+            _AppendBytes(scalars, AiNodeGetUInt(node, name));
+            return true;
+        case AI_TYPE_BOOLEAN:
+            _AppendBytes(scalars, AiNodeGetBool(node, name));
+            return true;
+        case AI_TYPE_FLOAT:
+            _AppendBytes(scalars, AiNodeGetFlt(node, name));
+            return true;
+        case AI_TYPE_RGB:
+            _AppendBytes(scalars, AiNodeGetRGB(node, name));
+            return true;
+        case AI_TYPE_RGBA:
+            _AppendBytes(scalars, AiNodeGetRGBA(node, name));
+            return true;
+        case AI_TYPE_VECTOR:
+            _AppendBytes(scalars, AiNodeGetVec(node, name));
+            return true;
+        case AI_TYPE_VECTOR2:
+            _AppendBytes(scalars, AiNodeGetVec2(node, name));
+            return true;
+        case AI_TYPE_MATRIX:
+            _AppendBytes(scalars, AiNodeGetMatrix(node, name));
+            return true;
+        case AI_TYPE_STRING:
+            // AtStrings are unique, so we can compare their pointers
+            _AppendBytes(scalars, AiNodeGetStr(node, name).c_str());
+            return true;
+        case AI_TYPE_POINTER:
+            _AppendBytes(scalars, AiNodeGetPtr(node, name));
+            return true;
+        case AI_TYPE_NODE: {
+            const AtNode *target = static_cast<const AtNode *>(AiNodeGetPtr(node, name));
+            _AppendBytes(scalars, (resolver && target) ? (*resolver)(target) : target);
+            return true;
+        }
+        case AI_TYPE_ARRAY: {
+            const AtArray *array = AiNodeGetArray(node, name);
+            // arrays of arrays aren't supported
+            if (array && AiArrayGetType(array) == AI_TYPE_ARRAY)
+                return false;
+            signature.arrays.push_back(array);
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+// Links are compared by their resolved target and output component
+bool _AppendLink(NodeSignature &signature, const AtNode *node, const AtString &name, const NodeResolver &resolver)
+{
+    const bool linked = AiNodeIsLinked(node, name);
+    _AppendBytes(signature.scalars, linked);
+    if (!linked)
+        return true;
+    int outComp = -1;
+    const AtNode *target = AiNodeGetLink(node, name, &outComp);
+    // Links on components or array elements aren't compared
+    if (target == nullptr)
+        return false;
+    _AppendBytes(signature.scalars, resolver(target));
+    _AppendBytes(signature.scalars, outComp);
+    return true;
+}
+
+// Build the signature of a node from all its parameters and user data, apart from its name
+// and an eventual parameter that can be different for each shared node. When a resolver is
+// provided, links and node parameters are compared by their resolved targets
+NodeSignature _GetNodeSignature(const AtNode *node, const AtString &ignoredParam, const NodeResolver *resolver)
+{
+    static const AtString nameStr("name");
+
+    NodeSignature signature;
+    const AtNodeEntry *nodeEntry = AiNodeGetNodeEntry(node);
+    _AppendBytes(signature.scalars, nodeEntry);
+    AtParamIterator *paramIter = AiNodeEntryGetParamIterator(nodeEntry);
+    while (!AiParamIteratorFinished(paramIter)) {
+        const AtParamEntry *paramEntry = AiParamIteratorGetNext(paramIter);
+        const AtString paramName = AiParamGetName(paramEntry);
+        if (paramName == nameStr || paramName == ignoredParam)
+            continue;
+        if (!_AppendParameter(signature, node, paramName, AiParamGetType(paramEntry), resolver) ||
+            (resolver && !_AppendLink(signature, node, paramName, *resolver))) {
+            AiParamIteratorDestroy(paramIter);
+            return signature;
+        }
+    }
+    AiParamIteratorDestroy(paramIter);
+
+    AtUserParamIterator *userParamIter = AiNodeGetUserParamIterator(node);
+    while (!AiUserParamIteratorFinished(userParamIter)) {
+        const AtUserParamEntry *userParam = AiUserParamIteratorGetNext(userParamIter);
+        const AtString paramName(AiUserParamGetName(userParam));
+        _AppendBytes(signature.scalars, paramName.c_str());
+        _AppendBytes(signature.scalars, AiUserParamGetCategory(userParam));
+        if (!_AppendParameter(signature, node, paramName, AiUserParamGetType(userParam), resolver) ||
+            (resolver && !_AppendLink(signature, node, paramName, *resolver))) {
+            AiUserParamIteratorDestroy(userParamIter);
+            return signature;
+        }
+    }
+    AiUserParamIteratorDestroy(userParamIter);
+
+    signature.hash = ArchHash64(signature.scalars.data(), signature.scalars.size());
+    for (const AtArray *array : signature.arrays) {
+        const size_t dataSize = array ? _GetArrayDataSize(array) : 0;
+        if (dataSize == 0)
+            continue;
+        signature.hash = ArchHash64(
+            static_cast<const char *>(AiArrayMap(const_cast<AtArray *>(array))), dataSize, signature.hash);
+        AiArrayUnmap(const_cast<AtArray *>(array));
+    }
+    signature.valid = true;
+    return signature;
+}
+
+// The transform of a shape can be different for each instance of a prototype
+NodeSignature _GetShapeSignature(const AtNode *node)
+{
+    static const AtString matrixStr("matrix");
+    return _GetNodeSignature(node, matrixStr, nullptr);
+}
+
+// Add the nodes stored in a node parameter, or in an array of nodes
+void _AddReferencedNodes(
+    const AtNode *node, const AtString &name, int type, std::unordered_set<const AtNode *> &referencedNodes)
+{
+    if (type == AI_TYPE_NODE) {
+        referencedNodes.insert(static_cast<const AtNode *>(AiNodeGetPtr(node, name)));
+    } else if (type == AI_TYPE_ARRAY) {
+        AtArray *array = AiNodeGetArray(node, name);
+        if (array == nullptr || AiArrayGetType(array) != AI_TYPE_NODE)
+            return;
+        for (unsigned int i = 0, numElements = AiArrayGetNumElements(array); i < numElements; ++i)
+            referencedNodes.insert(static_cast<const AtNode *>(AiArrayGetPtr(array, i)));
+    }
+}
+
+bool _ArraysEqual(const AtArray *a, const AtArray *b)
+{
+    if (a == b)
+        return true;
+    if (a == nullptr || b == nullptr || AiArrayGetType(a) != AiArrayGetType(b) ||
+        AiArrayGetNumElements(a) != AiArrayGetNumElements(b) || AiArrayGetNumKeys(a) != AiArrayGetNumKeys(b))
+        return false;
+    const size_t dataSize = _GetArrayDataSize(a);
+    if (dataSize == 0)
+        return true;
+    AtArray *arrayA = const_cast<AtArray *>(a);
+    AtArray *arrayB = const_cast<AtArray *>(b);
+    const bool equal = memcmp(AiArrayMap(arrayA), AiArrayMap(arrayB), dataSize) == 0;
+    AiArrayUnmap(arrayA);
+    AiArrayUnmap(arrayB);
+    return equal;
+}
+
+// The hashes are only used to find candidates, shared nodes must be identical
+bool _SignaturesEqual(const NodeSignature &a, const NodeSignature &b)
+{
+    if (a.hash != b.hash || a.scalars != b.scalars || a.arrays.size() != b.arrays.size())
+        return false;
+    for (size_t i = 0; i < a.arrays.size(); ++i) {
+        if (!_ArraysEqual(a.arrays[i], b.arrays[i]))
+            return false;
+    }
+    return true;
+}
+
+using NodePathSet = std::unordered_set<SdfPath, SdfPath::Hash>;
+
+// Remove the metadata and the properties authored on a prim. The specifier and the type name
+// are kept, since they're authored again when the prim is defined
+void _ClearPrimFields(const SdfPrimSpecHandle &primSpec)
+{
+    for (const TfToken &key : primSpec->ListInfoKeys()) {
+        if (key != SdfFieldKeys->Specifier && key != SdfFieldKeys->TypeName)
+            primSpec->ClearInfo(key);
+    }
+    const std::vector<SdfPropertySpecHandle> properties(
+        primSpec->GetProperties().begin(), primSpec->GetProperties().end());
+    for (const SdfPropertySpecHandle &property : properties)
+        primSpec->RemoveProperty(property);
+}
+
+// Remove what was authored on a prim, as well as its children that weren't written for
+// other nodes (ie. geom subsets), so that its node can be written again from scratch
+void _ClearPrimSpec(const SdfLayerHandle &layer, const SdfPath &path, const NodePathSet &nodePaths)
+{
+    SdfPrimSpecHandle primSpec = layer->GetPrimAtPath(path);
+    if (!primSpec)
+        return;
+    _ClearPrimFields(primSpec);
+    const std::vector<SdfPrimSpecHandle> children(
+        primSpec->GetNameChildren().begin(), primSpec->GetNameChildren().end());
+    for (const SdfPrimSpecHandle &child : children) {
+        if (nodePaths.count(child->GetPath()) == 0)
+            primSpec->RemoveNameChild(child);
+    }
+}
+
+} // namespace
+
 /**
  *  Write out a given Arnold universe to a USD stage.
  **/
@@ -59,6 +362,10 @@ void UsdArnoldWriter::Write(const AtUniverse *universe)
     }
     // clear the list of nodes that were exported to usd
     _exportedNodes.clear();
+    // the stage could have been modified since the last write
+    _hierarchyPaths.clear();
+    // nodes could have been renamed, or destroyed and replaced by other nodes
+    _nodeNames.clear();
 
     AtNode *camera = AiUniverseGetCamera(universe);
     if (camera) {
@@ -69,7 +376,18 @@ void UsdArnoldWriter::Write(const AtUniverse *universe)
     // If a specific time was requested, we want to check if some data was already written 
     // to this USD stage for other frames. We do this by checking the options node, as its attribute
     // "frame" will contain the list of frames
-    if (!_time.IsDefault()) {
+    if (_streaming && !_time.IsDefault()) {
+        // In streaming mode, we already know which frames were written, and the
+        // attribute values are tracked in memory, so there's nothing to read back
+        _mask |= AI_NODE_OPTIONS;
+        _authoredFrames.clear();
+        _nearestFrames.clear();
+        float currentFrame = (float) _time.GetValue();
+        _startFrame = (_streamedFrames == 0) ? currentFrame : std::min(_startFrame, currentFrame);
+        _endFrame = (_streamedFrames == 0) ? currentFrame : std::max(_endFrame, currentFrame);
+        _stage->SetMetadata(_tokens->startFrame, (double)_startFrame);
+        _stage->SetMetadata(_tokens->endFrame, (double)_endFrame);
+    } else if (!_time.IsDefault()) {
         _mask |= AI_NODE_OPTIONS; // we always need the options written out if a time was provided, to store the frame
         _authoredFrames.clear();
         _nearestFrames.clear();
@@ -128,14 +446,184 @@ void UsdArnoldWriter::Write(const AtUniverse *universe)
     }
 
     // Loop over the universe nodes, and write each of them
+    std::vector<const AtNode *> nodes;
     AtNodeIterator *iter = AiUniverseGetNodeIterator(_universe, _mask);
     while (!AiNodeIteratorFinished(iter)) {
-        WritePrimitive(AiNodeIteratorGetNext(iter));
+        nodes.push_back(AiNodeIteratorGetNext(iter));
     }
     AiNodeIteratorDestroy(iter);
+
+    const bool incremental = _incremental && _time.IsDefault();
+    if (incremental)
+        _UpdateIncrementalNodes(nodes);
+
+    _sharedShaders.clear();
+    if (_shaderDeduplication && _time.IsDefault() && !incremental && (_mask & AI_NODE_SHADER))
+        _FindSharedShaders(nodes);
+    _instances.clear();
+    _prototypes.clear();
+    if (_instancing && _time.IsDefault() && !incremental)
+        _FindInstances(nodes);
+
+    size_t threadCount = (_threadCount == 0) ? WorkGetConcurrencyLimit() : _threadCount;
+    threadCount = std::min(threadCount, nodes.size());
+    // Prim writers store data for the node being written, so each thread needs its own registry,
+    // which we can only create if no custom writers were registered. When appending frames, we need
+    // to compare the new values with the ones previously written, so we also write serially.
+    if (threadCount > 1 && !_registry->HasCustomWriters() && _authoredFrames.empty() && !_streaming) {
+        _WriteParallel(nodes, threadCount);
+    } else {
+        for (const AtNode *node : nodes) {
+            WritePrimitive(node);
+        }
+    }
+    if (incremental)
+        _UpdateIncrementalMaterials(nodes);
+    if (_streaming && !_time.IsDefault()) {
+        _previousFrame = (float)_time.GetValue();
+        _streamedFrames++;
+    }
     _universe = nullptr;
 }
 
+void UsdArnoldWriter::_SetStreamedAttribute(
+    const UsdAttribute &attr, const VtValue &value, const float *subFrame) const
+{
+    // Motion keys are always written as time samples
+    if (subFrame) {
+        attr.Set(value, GetTime(*subFrame));
+        return;
+    }
+    if (_streamedFrames == 0) {
+        // First frame, we just want to set the plain value and remember it
+        if (!_SetDefaultValue(attr, value))
+            attr.Set(value);
+        _streamedAttributes[attr.GetPath()] = {value, false};
+        return;
+    }
+    auto it = _streamedAttributes.find(attr.GetPath());
+    if (it == _streamedAttributes.end()) {
+        // This attribute wasn't written through the writer in the previous frames. If a prim writer
+        // authored a default value for it directly, it's held for the previous frames
+        VtValue previousValue;
+        if (!attr.HasAuthoredValue() || attr.ValueMightBeTimeVarying() || !attr.Get(&previousValue)) {
+            attr.Set(value, GetTime());
+            _streamedAttributes[attr.GetPath()] = {VtValue(), true};
+            return;
+        }
+        it = _streamedAttributes.emplace(attr.GetPath(), StreamedAttribute{previousValue, false}).first;
+    }
+    StreamedAttribute &streamed = it->second;
+    if (!streamed.timeVarying) {
+        // The attribute is constant so far, nothing to do if the value didn't change
+        if (streamed.value == value)
+            return;
+        // The value changed since the previous frame. We clear the default value,
+        // and set the previous constant value as a time sample on the previous frame.
+        // Since frames are written in increasing order, it will be held for
+        // all the frames written before
+        attr.ClearDefault();
+        attr.Set(streamed.value, UsdTimeCode(_previousFrame));
+        streamed.value = VtValue();
+        streamed.timeVarying = true;
+    }
+    attr.Set(value, GetTime());
+}
+
+unsigned int UsdArnoldWriter::_WriterThread(void *data)
+{
+    UsdArnoldWriterThreadData *threadData = static_cast<UsdArnoldWriterThreadData *>(data);
+    UsdArnoldWriter &writer = *threadData->writer;
+    const std::vector<const AtNode *> &nodes = *threadData->nodes;
+    std::vector<UsdArnoldWriterChunk> &chunks = *threadData->chunks;
+    // Each chunk is a contiguous range of nodes, written as if it was the only one, so the
+    // layer of a chunk doesn't depend on the thread writing it or on the previous chunks.
+    // Nodes connected to them (shaders, materials, etc...) are written by every chunk
+    // needing them, so a shared shader can end up in several layers. Identical specs
+    // are merged at the end, which is much cheaper than synchronizing the threads.
+    for (size_t c = threadData->nextChunk->fetch_add(1); c < chunks.size(); c = threadData->nextChunk->fetch_add(1)) {
+        UsdArnoldWriterChunk &chunk = chunks[c];
+        writer.SetUsdStage(chunk.stage);
+        // The nodes exported before the parallel write (ie. the unchanged nodes of an incremental
+        // write) are still seen as exported through the parent writer
+        writer._exportedNodes.clear();
+        for (auto &prototype : writer._prototypes)
+            prototype.written = false;
+        for (size_t i = chunk.begin; i < chunk.end; ++i) {
+            writer.WritePrimitive(nodes[i]);
+        }
+        chunk.exportedNodes.swap(writer._exportedNodes);
+    }
+    return 0;
+}
+
+void UsdArnoldWriter::_WriteParallel(const std::vector<const AtNode *> &nodes, size_t threadCount)
+{
+    const size_t chunkCount = std::min(nodes.size(), s_writerChunkCount);
+    std::vector<UsdArnoldWriterChunk> chunks(chunkCount);
+    for (size_t c = 0; c < chunkCount; ++c) {
+        chunks[c].begin = c * nodes.size() / chunkCount;
+        chunks[c].end = (c + 1) * nodes.size() / chunkCount;
+        chunks[c].stage = UsdStage::CreateInMemory();
+    }
+    std::atomic<size_t> nextChunk(0);
+    threadCount = std::min(threadCount, chunkCount);
+    // Each thread has its own writer, authoring to an anonymous layer per chunk
+    // that isn't shared with any other thread. The incremental state and the cached
+    // node names are only needed by this writer, so we don't copy them to the
+    // thread writers, and the exported nodes are only read through this writer
+    std::unordered_map<AtString, WrittenNode, AtStringHash> writtenNodes;
+    std::unordered_map<const AtNode *, std::string> nodeNames;
+    std::unordered_set<AtString, AtStringHash> exportedNodes;
+    NodePathSet boundMaterials;
+    writtenNodes.swap(_writtenNodes);
+    nodeNames.swap(_nodeNames);
+    exportedNodes.swap(_exportedNodes);
+    boundMaterials.swap(_boundMaterials);
+    std::vector<UsdArnoldWriter> threadWriters(threadCount, *this);
+    writtenNodes.swap(_writtenNodes);
+    nodeNames.swap(_nodeNames);
+    exportedNodes.swap(_exportedNodes);
+    boundMaterials.swap(_boundMaterials);
+    std::vector<UsdArnoldWriterRegistry *> threadRegistries(threadCount, nullptr);
+    std::vector<UsdArnoldWriterThreadData> threadData(threadCount);
+    std::vector<void *> threads(threadCount, nullptr);
+    for (size_t i = 0; i < threadCount; ++i) {
+        threadRegistries[i] = new UsdArnoldWriterRegistry(_registry->GetWriteBuiltin());
+        threadWriters[i].SetRegistry(threadRegistries[i]);
+        threadWriters[i]._parentExportedNodes = &_exportedNodes;
+        threadData[i].writer = &threadWriters[i];
+        threadData[i].nodes = &nodes;
+        threadData[i].chunks = &chunks;
+        threadData[i].nextChunk = &nextChunk;
+        threads[i] = AiThreadCreate(_WriterThread, &threadData[i], AI_PRIORITY_HIGH);
+    }
+    for (size_t i = 0; i < threadCount; ++i) {
+        AiThreadWait(threads[i]);
+        AiThreadClose(threads[i]);
+        threads[i] = nullptr;
+    }
+
+    // Merge all the chunk layers to the output layer in the order of the nodes, in a single
+    // change block so that the output stage only recomposes once. Since the prims are
+    // added in the order they were first written, the output is the same as when
+    // writing the nodes serially
+    SdfLayerHandle dstLayer = _stage->GetEditTarget().GetLayer();
+    {
+        SdfChangeBlock changeBlock;
+        for (UsdArnoldWriterChunk &chunk : chunks) {
+            const SdfLayerHandle srcLayer = chunk.stage->GetRootLayer();
+            for (const SdfPrimSpecHandle &rootPrim : srcLayer->GetRootPrims()) {
+                _MergePrimSpec(srcLayer, rootPrim, dstLayer);
+            }
+            _exportedNodes.insert(chunk.exportedNodes.begin(), chunk.exportedNodes.end());
+        }
+    }
+    for (size_t i = 0; i < threadCount; ++i) {
+        delete threadRegistries[i];
+    }
+}
+
 /**
  *  Write out the primitive, by using the registered primitive writer.
  *
@@ -160,20 +648,444 @@ void UsdArnoldWriter::WritePrimitive(const AtNode *node)
     // Note that we're storing the name of the arnold node, which might be slightly
     // different from the USD prim name, since UsdArnoldPrimWriter::GetArnoldNodeName
     // replaces some forbidden characters by underscores.
-    if (!nodeName.empty() && IsNodeExported(nodeName))
+    if (!nodeName.empty() && IsNodeExported(nodeName)) {
+        // Nodes exported before a parallel write don't have a prim in the layer of the thread writer.
+        // The first time they're referenced, an empty override lets the connections to them be
+        // authored, and it's merged with their existing prim
+        if (_parentExportedNodes != nullptr && _exportedNodes.count(nodeName) == 0) {
+            _exportedNodes.insert(nodeName);
+            if (_registry->GetPrimWriter(AiNodeGetNodeEntry(node)) != nullptr)
+                _stage->OverridePrim(SdfPath(UsdArnoldPrimWriter::GetArnoldNodeName(node, *this)));
+        }
+        return;
+    }
+
+    // Shaders identical to another shader are replaced by it in connections and material bindings
+    if (!_sharedShaders.empty() && _sharedShaders.count(node))
         return;
 
     if (!nodeName.empty())
         _exportedNodes.insert(nodeName); // remember that we already exported this node
 
-    std::string objType = AiNodeEntryGetName(AiNodeGetNodeEntry(node));
-    UsdArnoldPrimWriter *primWriter = _registry->GetPrimWriter(objType);
-    if (primWriter)
-        primWriter->WriteNode(node, *this);
+    UsdArnoldPrimWriter *primWriter = _registry->GetPrimWriter(AiNodeGetNodeEntry(node));
+    if (primWriter == nullptr)
+        return;
+
+    if (!_instances.empty()) {
+        const auto instanceIt = _instances.find(node);
+        if (instanceIt != _instances.end()) {
+            _WriteInstance(node, instanceIt->second, primWriter);
+            return;
+        }
+    }
+    primWriter->WriteNode(node, *this);
+}
+
+void UsdArnoldWriter::_FindInstances(const std::vector<const AtNode *> &nodes)
+{
+    static const AtString polymeshStr("polymesh");
+    static const AtString curvesStr("curves");
+    static const AtString pointsStr("points");
+    static const AtString ginstanceStr("ginstance");
+    static const AtString mesh_lightStr("mesh_light");
+    static const AtString nodeStr("node");
+    static const AtString meshStr("mesh");
+    static const AtString matrixStr("matrix");
+
+    // Only the builtin USD geometries can be written inside prototypes
+    if (!_writeBuiltin)
+        return;
+
+    // Shapes referenced by other nodes are expected to be geometries in USD, not instances
+    std::unordered_set<const AtNode *> referencedShapes;
+    AtNodeIterator *iter = AiUniverseGetNodeIterator(_universe, AI_NODE_SHAPE | AI_NODE_LIGHT);
+    while (!AiNodeIteratorFinished(iter)) {
+        AtNode *node = AiNodeIteratorGetNext(iter);
+        if (AiNodeIs(node, ginstanceStr))
+            referencedShapes.insert(static_cast<const AtNode *>(AiNodeGetPtr(node, nodeStr)));
+        else if (AiNodeIs(node, mesh_lightStr))
+            referencedShapes.insert(static_cast<const AtNode *>(AiNodeGetPtr(node, meshStr)));
+    }
+    AiNodeIteratorDestroy(iter);
+
+    std::vector<const AtNode *> candidates;
+    for (const AtNode *node : nodes) {
+        if (!AiNodeIs(node, polymeshStr) && !AiNodeIs(node, curvesStr) && !AiNodeIs(node, pointsStr))
+            continue;
+        if (referencedShapes.count(node))
+            continue;
+        // Instances can't have transform motion blur, as it couldn't be applied
+        // on the prototype
+        AtArray *matrices = AiNodeGetArray(node, matrixStr);
+        if (matrices && AiArrayGetNumKeys(matrices) > 1)
+            continue;
+        candidates.push_back(node);
+    }
+
+    // Hashing the shape arrays is the expensive part, so we do it in parallel
+    std::vector<NodeSignature> signatures(candidates.size());
+    WorkParallelForN(candidates.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            signatures[i] = _GetShapeSignature(candidates[i]);
+    });
+
+    // Group the shapes by signature. Shapes with the same hash are compared with
+    // the first shape of each group, in case of hash collisions
+    std::unordered_map<uint64_t, std::vector<std::vector<size_t>>> groups;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        if (!signatures[i].valid)
+            continue;
+        std::vector<std::vector<size_t>> &hashGroups = groups[signatures[i].hash];
+        bool found = false;
+        for (std::vector<size_t> &group : hashGroups) {
+            if (_SignaturesEqual(signatures[group.front()], signatures[i])) {
+                group.push_back(i);
+                found = true;
+                break;
+            }
+        }
+        if (!found)
+            hashGroups.push_back(std::vector<size_t>(1, i));
+    }
+
+    // Only shapes sharing their parameters with other shapes are written as instances
+    const std::string prototypesRoot = _scope + std::string("/__arnold_prototypes/proto_");
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        if (!signatures[i].valid)
+            continue;
+        for (const std::vector<size_t> &group : groups[signatures[i].hash]) {
+            // Create the prototype when we find the first shape of the group, so that
+            // prototypes are numbered in the order of the universe nodes
+            if (group.size() < 2 || group.front() != i)
+                continue;
+            const size_t prototypeIndex = _prototypes.size();
+            Prototype prototype;
+            prototype.node = candidates[i];
+            prototype.path = SdfPath(prototypesRoot + std::to_string(prototypeIndex));
+            prototype.written = false;
+            _prototypes.push_back(prototype);
+            for (size_t instance : group)
+                _instances[candidates[instance]] = prototypeIndex;
+        }
+    }
+}
+
+void UsdArnoldWriter::_FindSharedShaders(const std::vector<const AtNode *> &nodes)
+{
+    static const AtString shaderStr("shader");
+    static const AtString disp_mapStr("disp_map");
+    static const AtString ai_default_reflection_shaderStr("ai_default_reflection_shader");
+
+    // Shaders referenced by node parameters are written as the name of the node, so they
+    // need to keep their own primitive. The shaders assigned to shapes are not considered, as
+    // material bindings are redirected to the shared shaders
+    std::unordered_set<const AtNode *> referencedShaders;
+    AtNodeIterator *iter = AiUniverseGetNodeIterator(_universe, AI_NODE_ALL);
+    while (!AiNodeIteratorFinished(iter)) {
+        AtNode *node = AiNodeIteratorGetNext(iter);
+        const AtNodeEntry *nodeEntry = AiNodeGetNodeEntry(node);
+        const bool isShape = AiNodeEntryGetType(nodeEntry) == AI_NODE_SHAPE;
+        AtParamIterator *paramIter = AiNodeEntryGetParamIterator(nodeEntry);
+        while (!AiParamIteratorFinished(paramIter)) {
+            const AtParamEntry *paramEntry = AiParamIteratorGetNext(paramIter);
+            const AtString paramName = AiParamGetName(paramEntry);
+            if (isShape && (paramName == shaderStr || paramName == disp_mapStr))
+                continue;
+            _AddReferencedNodes(node, paramName, AiParamGetType(paramEntry), referencedShaders);
+        }
+        AiParamIteratorDestroy(paramIter);
+        AtUserParamIterator *userParamIter = AiNodeGetUserParamIterator(node);
+        while (!AiUserParamIteratorFinished(userParamIter)) {
+            const AtUserParamEntry *userParam = AiUserParamIteratorGetNext(userParamIter);
+            _AddReferencedNodes(
+                node, AtString(AiUserParamGetName(userParam)), AiUserParamGetType(userParam), referencedShaders);
+        }
+        AiUserParamIteratorDestroy(userParamIter);
+    }
+    AiNodeIteratorDestroy(iter);
+
+    // Shaders are resolved recursively, starting from the inputs of a network. Two shaders
+    // are identical if they have the same parameters and their inputs resolve to the same
+    // shaders. The first shader found for a given signature is the one written to USD
+    std::unordered_map<const AtNode *, const AtNode *> resolvedShaders;
+    std::unordered_map<uint64_t, std::vector<std::pair<const AtNode *, NodeSignature>>> sharedShaders;
+    NodeResolver resolveShader = [&](const AtNode *shader) -> const AtNode * {
+        const auto resolvedIt = resolvedShaders.find(shader);
+        if (resolvedIt != resolvedShaders.end())
+            return resolvedIt->second;
+        // Shaders that aren't shared are compared by their pointer. This is also the case while
+        // a shader is being resolved, in case the network has cycles
+        resolvedShaders[shader] = shader;
+        if (AiNodeEntryGetType(AiNodeGetNodeEntry(shader)) != AI_NODE_SHADER ||
+            AtString(AiNodeGetName(shader)) == ai_default_reflection_shaderStr)
+            return shader;
+        NodeSignature signature = _GetNodeSignature(shader, AtString(), &resolveShader);
+        if (!signature.valid)
+            return shader;
+
+        std::vector<std::pair<const AtNode *, NodeSignature>> &hashShaders = sharedShaders[signature.hash];
+        for (const auto &sharedShader : hashShaders) {
+            if (_SignaturesEqual(sharedShader.second, signature)) {
+                if (referencedShaders.count(shader))
+                    return shader;
+                resolvedShaders[shader] = sharedShader.first;
+                _sharedShaders[shader] = sharedShader.first;
+                return sharedShader.first;
+            }
+        }
+        hashShaders.emplace_back(shader, std::move(signature));
+        return shader;
+    };
+    for (const AtNode *node : nodes) {
+        if (AiNodeEntryGetType(AiNodeGetNodeEntry(node)) == AI_NODE_SHADER)
+            resolveShader(node);
+    }
+}
+
+void UsdArnoldWriter::_UpdateIncrementalNodes(std::vector<const AtNode *> &nodes)
+{
+    // Links are compared by their target, so that a node is written again when it's connected
+    // to a different shader
+    const NodeResolver resolver = [](const AtNode *target) { return target; };
+
+    std::unordered_map<AtString, WrittenNode, AtStringHash> writtenNodes;
+    std::vector<const AtNode *> changedNodes;
+    std::vector<SdfPath> clearedPaths;
+    std::vector<SdfPath> removedPaths;
+    for (const AtNode *node : nodes) {
+        const AtString nodeName(AiNodeGetName(node));
+        // Nodes without a name can't be tracked from one write to the next
+        if (nodeName.empty()) {
+            changedNodes.push_back(node);
+            continue;
+        }
+        const NodeSignature signature = _GetNodeSignature(node, AtString(), &resolver);
+        WrittenNode &writtenNode = writtenNodes[nodeName];
+        writtenNode.hash = signature.hash;
+        writtenNode.valid = signature.valid;
+        writtenNode.path = SdfPath(UsdArnoldPrimWriter::GetArnoldNodeName(node, *this));
+
+        const auto previousIt = _writtenNodes.find(nodeName);
+        if (previousIt == _writtenNodes.end()) {
+            changedNodes.push_back(node);
+            continue;
+        }
+        const WrittenNode &previousNode = previousIt->second;
+        if (signature.valid && previousNode.valid && previousNode.hash == signature.hash &&
+            previousNode.path == writtenNode.path) {
+            // Unchanged nodes are considered as exported, so that they're not written again
+            // when they're connected to a node that changed. They still bind the same materials
+            _exportedNodes.insert(nodeName);
+            writtenNode.materials = previousNode.materials;
+        } else {
+            // If the node path changed, its previous prim is removed
+            if (previousNode.path == writtenNode.path)
+                clearedPaths.push_back(previousNode.path);
+            else
+                removedPaths.push_back(previousNode.path);
+            changedNodes.push_back(node);
+        }
+        _writtenNodes.erase(previousIt);
+    }
+    // The remaining nodes were deleted since the previous write
+    for (const auto &it : _writtenNodes)
+        removedPaths.push_back(it.second.path);
+    _writtenNodes.swap(writtenNodes);
+    nodes.swap(changedNodes);
+    if (clearedPaths.empty() && removedPaths.empty())
+        return;
+
+    // Prims can be nested, so we need the paths of all the nodes and their ancestors
+    // to know which prims must be kept
+    NodePathSet writtenPaths;
+    NodePathSet nodePaths;
+    _GetWrittenNodePaths(writtenPaths, nodePaths);
+    SdfLayerHandle layer = _stage->GetEditTarget().GetLayer();
+    SdfChangeBlock changeBlock;
+    for (const SdfPath &path : clearedPaths)
+        _ClearPrimSpec(layer, path, nodePaths);
+    for (const SdfPath &path : removedPaths) {
+        // Another node might now be written at the same path
+        if (writtenPaths.count(path))
+            continue;
+        _ClearPrimSpec(layer, path, nodePaths);
+        // The prim is kept if other nodes are written below it
+        SdfPrimSpecHandle primSpec = layer->GetPrimAtPath(path);
+        if (primSpec && primSpec->GetNameChildren().empty())
+            primSpec->GetRealNameParent()->RemoveNameChild(primSpec);
+    }
+}
+
+void UsdArnoldWriter::_UpdateIncrementalMaterials(const std::vector<const AtNode *> &nodes)
+{
+    auto getBoundMaterials = [&](const SdfPath &path, std::vector<SdfPath> &materials) {
+        UsdPrim prim = _stage->GetPrimAtPath(path);
+        if (!prim)
+            return;
+        auto appendBinding = [&](const UsdPrim &boundPrim) {
+            UsdRelationship bindingRel = UsdShadeMaterialBindingAPI(boundPrim).GetDirectBindingRel();
+            SdfPathVector targets;
+            if (bindingRel && bindingRel.GetTargets(&targets))
+                materials.insert(materials.end(), targets.begin(), targets.end());
+        };
+        appendBinding(prim);
+        // Per-face shader assignments are bound to the geom subsets of the shape
+        for (const UsdPrim &child : prim.GetChildren()) {
+            if (child.IsA<UsdGeomSubset>())
+                appendBinding(child);
+        }
+    };
+
+    // The nodes that were written again replace the materials they previously bound. Nodes
+    // without a name aren't tracked, but they're written every time so we still need their materials
+    NodePathSet boundMaterials;
+    for (const AtNode *node : nodes) {
+        if (AiNodeEntryGetType(AiNodeGetNodeEntry(node)) != AI_NODE_SHAPE)
+            continue;
+        const AtString nodeName(AiNodeGetName(node));
+        const auto writtenIt = nodeName.empty() ? _writtenNodes.end() : _writtenNodes.find(nodeName);
+        if (writtenIt != _writtenNodes.end()) {
+            writtenIt->second.materials.clear();
+            getBoundMaterials(writtenIt->second.path, writtenIt->second.materials);
+        } else {
+            std::vector<SdfPath> materials;
+            getBoundMaterials(SdfPath(UsdArnoldPrimWriter::GetArnoldNodeName(node, *this)), materials);
+            boundMaterials.insert(materials.begin(), materials.end());
+        }
+    }
+    for (const auto &it : _writtenNodes)
+        boundMaterials.insert(it.second.materials.begin(), it.second.materials.end());
+
+    std::vector<SdfPath> unboundMaterials;
+    for (const SdfPath &material : _boundMaterials) {
+        if (boundMaterials.count(material) == 0)
+            unboundMaterials.push_back(material);
+    }
+    _boundMaterials.swap(boundMaterials);
+    if (unboundMaterials.empty())
+        return;
+    // Material paths are built from the shader names, so they can be nested in each other
+    std::sort(unboundMaterials.begin(), unboundMaterials.end());
+
+    NodePathSet writtenPaths;
+    NodePathSet nodePaths;
+    _GetWrittenNodePaths(writtenPaths, nodePaths);
+    SdfLayerHandle layer = _stage->GetEditTarget().GetLayer();
+    SdfChangeBlock changeBlock;
+    for (auto materialIt = unboundMaterials.rbegin(); materialIt != unboundMaterials.rend(); ++materialIt) {
+        if (nodePaths.count(*materialIt))
+            continue;
+        SdfPrimSpecHandle primSpec = layer->GetPrimAtPath(*materialIt);
+        if (!primSpec)
+            continue;
+        // A material still bound below this one keeps it as a plain parent prim
+        if (!primSpec->GetNameChildren().empty()) {
+            _ClearPrimFields(primSpec);
+            primSpec->SetTypeName(std::string());
+            continue;
+        }
+        // The empty scopes created above the material are removed with it
+        SdfPath path = *materialIt;
+        while (primSpec && primSpec->GetNameChildren().empty() && nodePaths.count(path) == 0 &&
+               _boundMaterials.count(path) == 0 && (path == *materialIt || primSpec->GetProperties().empty())) {
+            SdfPrimSpecHandle parentSpec = primSpec->GetRealNameParent();
+            parentSpec->RemoveNameChild(primSpec);
+            path = path.GetParentPath();
+            primSpec = (path == SdfPath::AbsoluteRootPath()) ? SdfPrimSpecHandle() : parentSpec;
+        }
+    }
+}
+
+void UsdArnoldWriter::_GetWrittenNodePaths(NodePathSet &writtenPaths, NodePathSet &nodePaths) const
+{
+    for (const auto &it : _writtenNodes) {
+        writtenPaths.insert(it.second.path);
+        for (SdfPath path = it.second.path; !path.IsEmpty() && path != SdfPath::AbsoluteRootPath();
+             path = path.GetParentPath()) {
+            if (!nodePaths.insert(path).second)
+                break;
+        }
+    }
+}
+
+void UsdArnoldWriter::_WriteInstance(const AtNode *node, size_t prototypeIndex, UsdArnoldPrimWriter *primWriter)
+{
+    static const AtString matrixStr("matrix");
+    Prototype &prototype = _prototypes[prototypeIndex];
+    if (!prototype.written) {
+        prototype.written = true;
+        // Prototypes are created under a class primitive, so that they're not rendered
+        // on their own
+        const SdfPath prototypesRoot = prototype.path.GetParentPath();
+        if (!_stage->GetPrimAtPath(prototypesRoot)) {
+            CreateHierarchy(prototypesRoot);
+            _stage->CreateClassPrim(prototypesRoot);
+        }
+        // The shape is written without its transform, inside the prototype
+        _prototypeNode = prototype.node;
+        _prototypePath = prototype.path.AppendChild(TfToken("shape"));
+        primWriter->WriteNode(prototype.node, *this);
+        _prototypeNode = nullptr;
+        _prototypePath = SdfPath();
+    }
+
+    SdfPath objPath(UsdArnoldPrimWriter::GetArnoldNodeName(node, *this));
+    CreateHierarchy(objPath);
+    UsdGeomXform xform = UsdGeomXform::Define(_stage, objPath);
+    UsdPrim prim = xform.GetPrim();
+    prim.GetReferences().AddInternalReference(prototype.path);
+    prim.SetInstanceable(true);
+
+    AtArray *matrices = AiNodeGetArray(node, matrixStr);
+    if (matrices && AiArrayGetNumElements(matrices) > 0) {
+        const AtMatrix matrix = AiArrayGetMtx(matrices, 0);
+        if (!AiM4IsIdentity(matrix)) {
+            GfMatrix4d m;
+            for (int i = 0; i < 4; ++i) {
+                for (int j = 0; j < 4; ++j)
+                    m[i][j] = matrix[i][j];
+            }
+            SetAttribute(xform.MakeMatrixXform().GetAttr(), m);
+        }
+    }
 }
 
 void UsdArnoldWriter::SetRegistry(UsdArnoldWriterRegistry *registry) { _registry = registry; }
 
+bool UsdArnoldWriter::_SetDefaultValue(const UsdAttribute &attr, const VtValue &value) const
+{
+    // The attributes were just created by the prim writers in the edit target,
+    // so we can author the value on the spec directly
+    const UsdEditTarget &editTarget = _stage->GetEditTarget();
+    const SdfLayerHandle &layer = editTarget.GetLayer();
+    if (!layer)
+        return false;
+    SdfAttributeSpecHandle attrSpec = layer->GetAttributeAtPath(editTarget.MapToSpecPath(attr.GetPath()));
+    // The spec reports a coding error for values of another type, these are cast by the attribute instead
+    if (!attrSpec || value.GetType() != attrSpec->GetValueType())
+        return false;
+    return attrSpec->SetDefaultValue(value);
+}
+
+bool UsdArnoldWriter::_SetTimeSamples(const UsdAttribute &attr, const SdfTimeSampleMap &timeSamples) const
+{
+    const UsdEditTarget &editTarget = _stage->GetEditTarget();
+    const SdfLayerHandle &layer = editTarget.GetLayer();
+    if (!layer)
+        return false;
+    SdfAttributeSpecHandle attrSpec = layer->GetAttributeAtPath(editTarget.MapToSpecPath(attr.GetPath()));
+    if (!attrSpec || attrSpec->HasInfo(SdfFieldKeys->TimeSamples))
+        return false;
+    // The values aren't cast when setting the field, so they must have the attribute type
+    const TfType valueType = attrSpec->GetValueType();
+    for (const auto &timeSample : timeSamples) {
+        if (timeSample.second.GetType() != valueType)
+            return false;
+    }
+    attrSpec->SetInfo(SdfFieldKeys->TimeSamples, VtValue(timeSamples));
+    return true;
+}
+
 void UsdArnoldWriter::CreateHierarchy(const SdfPath &path, bool leaf) const
 {
     if (path == SdfPath::AbsoluteRootPath())
@@ -182,7 +1094,11 @@ void UsdArnoldWriter::CreateHierarchy(const SdfPath &path, bool leaf) const
     if (!leaf) {
         // If this primitive was already written, let's early out.
         // No need to test this for the leaf node that is about 
-        // to be created
+        // to be created. We remember the ancestors that were already
+        // processed, so that siblings don't need to query the stage
+        // for each of their parents
+        if (!_hierarchyPaths.insert(path).second)
+            return;
         if (_stage->GetPrimAtPath(path))
             return;
     }
@@ -15,14 +15,18 @@
 
 #include <ai_nodes.h>
 
+#include <pxr/usd/sdf/types.h>
 #include <pxr/usd/usd/prim.h>
 #include <pxr/usd/usdGeom/primvar.h>
 
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 PXR_NAMESPACE_USING_DIRECTIVE
 
+class UsdArnoldPrimWriter;
 class UsdArnoldWriterRegistry;
 
 /**
@@ -41,7 +45,19 @@ public:
           _shutterStart(0.f),
           _shutterEnd(0.f),
           _allAttributes(false),
-          _time(UsdTimeCode::Default())
+          _time(UsdTimeCode::Default()),
+          _threadCount(1),
+          _streaming(false),
+          _streamedFrames(0),
+          _previousFrame(0.f),
+          _startFrame(0.f),
+          _endFrame(0.f),
+          _instancing(false),
+          _prototypeNode(nullptr),
+          _shaderDeduplication(false),
+          _compactEncoding(false),
+          _incremental(false),
+          _parentExportedNodes(nullptr)
     {
     }
     ~UsdArnoldWriter() {}
@@ -51,10 +67,20 @@ public:
 
     void SetRegistry(UsdArnoldWriterRegistry *registry);
 
-    void SetUsdStage(UsdStageRefPtr stage) { _stage = stage; }
+    void SetUsdStage(UsdStageRefPtr stage)
+    {
+        _stage = stage;
+        _hierarchyPaths.clear();
+        _writtenNodes.clear();
+        _ResetStreaming();
+    }
     const UsdStageRefPtr &GetUsdStage() { return _stage; }
 
-    void SetUniverse(const AtUniverse *universe) { _universe = universe; }
+    void SetUniverse(const AtUniverse *universe)
+    {
+        _universe = universe;
+        _nodeNames.clear();
+    }
     const AtUniverse *GetUniverse() const { return _universe; }
 
     void SetWriteBuiltin(bool b) { _writeBuiltin = b; }
@@ -69,15 +95,86 @@ public:
     void SetWriteAllAttributes(bool b) {_allAttributes = b;}
     bool GetWriteAllAttributes() const {return _allAttributes;}
 
+    // Streaming mode, for writing consecutive frames with the same writer. The values written
+    // for each attribute are tracked in memory across calls to Write, instead of being read back
+    // from the stage, so that appending a frame doesn't get slower as more frames are written.
+    // Frames are expected to be written in increasing order.
+    void SetStreaming(bool b)
+    {
+        _streaming = b;
+        _ResetStreaming();
+    }
+    bool GetStreaming() const { return _streaming; }
+
+    // Detect shapes having identical parameters, and write them once as a prototype that
+    // is referenced by instanceable primitives. Only done when writing a default time
+    void SetInstancing(bool b) { _instancing = b; }
+    bool GetInstancing() const { return _instancing; }
+
+    // While a prototype is being written, returns its shape node and the path where it's written
+    const AtNode *GetPrototypeNode() const { return _prototypeNode; }
+    const SdfPath &GetPrototypePath() const { return _prototypePath; }
+
+    // Detect shaders having identical parameters and inputs, and write each of these networks
+    // once so that all the shapes using them bind to the same material. Only done when writing
+    // a default time
+    void SetShaderDeduplication(bool b) { _shaderDeduplication = b; }
+    bool GetShaderDeduplication() const { return _shaderDeduplication; }
+
+    // Returns the shader written in place of a given shader, which is the shader itself unless
+    // it was found identical to another one
+    const AtNode *GetSharedShader(const AtNode *shader) const
+    {
+        if (_sharedShaders.empty())
+            return shader;
+        const auto it = _sharedShaders.find(shader);
+        return (it == _sharedShaders.end()) ? shader : it->second;
+    }
+
+    // Compact encoding profile, writing transforms as single precision translate, orient and
+    // scale ops instead of double precision matrices, when they reproduce the matrix within a
+    // relative tolerance of 1e-5, and skipping the arrays equal to their parameter default
+    void SetCompactEncoding(bool b) { _compactEncoding = b; }
+    bool GetCompactEncoding() const { return _compactEncoding; }
+
+    // Incremental mode, for writing the same universe several times to the same stage. A hash of
+    // the parameters of each node is kept across calls to Write, and only the nodes that changed
+    // since the previous call are written again, after clearing what they previously authored.
+    // The prims of nodes that were deleted from the universe are removed, as well as the materials
+    // that aren't bound by any shape anymore. Only done when writing a default time, the mask and
+    // the scope are expected to be the same for every call, and instances and shared shaders
+    // aren't detected
+    void SetIncremental(bool b)
+    {
+        _incremental = b;
+        _writtenNodes.clear();
+        _boundMaterials.clear();
+    }
+    bool GetIncremental() const { return _incremental; }
+
+    // Amount of threads used to write the universe, 0 meaning all the available cores
+    void SetThreadCount(unsigned int t) { _threadCount = t; }
+    unsigned int GetThreadCount() const { return _threadCount; }
+
     UsdTimeCode GetTime() const { return _time;}
     UsdTimeCode GetTime(float delta) const { return _time.IsDefault() ? UsdTimeCode(delta) : UsdTimeCode(_time.GetValue() + delta);}
     void SetFrame(float frame) {_time = UsdTimeCode(frame);}
     
-    bool IsNodeExported(const AtString &name) { return _exportedNodes.count(name) == 1; }
+    bool IsNodeExported(const AtString &name)
+    {
+        return _exportedNodes.count(name) == 1 ||
+               (_parentExportedNodes != nullptr && _parentExportedNodes->count(name) == 1);
+    }
+
+    // USD names of the nodes, computed by UsdArnoldPrimWriter::GetArnoldNodeName. An empty string
+    // means the name wasn't computed yet. Names are cached until the next call to Write, or until
+    // the scope changes
+    std::string &GetNodeNameCache(const AtNode *node) const { return _nodeNames[node]; }
 
     const std::string &GetScope() const {return _scope;}
     void SetScope(const std::string &scope) {
         _scope = scope;
+        _nodeNames.clear();
         if (!_scope.empty()) { 
             // First character needs to be a slash
             if (_scope[0] != '/')
@@ -99,10 +196,15 @@ public:
     template <typename T>
     void SetAttribute(const UsdAttribute &attr, const T& value, float *subFrame = nullptr) const
     {
-        if (_time.IsDefault()) {
+        if (_streaming && !_time.IsDefault()) {
+            _SetStreamedAttribute(attr, VtValue(value), subFrame);
+        } else if (_time.IsDefault()) {
             // no time was provided, we just want to set a constant value, unless we were
             // provided a subframe for motion blurred data
-            attr.Set(value, subFrame ? UsdTimeCode(*subFrame) : UsdTimeCode::Default());            
+            if (subFrame)
+                attr.Set(value, UsdTimeCode(*subFrame));
+            else if (!_SetDefaultValue(attr, VtValue(value)))
+                attr.Set(value);
         } else {
             // A specific time was provided, let's check if there were previously authored frames
             if (!_authoredFrames.empty()) {
@@ -137,11 +239,43 @@ public:
             } else {
                 // if a time is provided, but we're not in append mode, we want to just set the plain value.
                 // Otherwise, all parameters will always have time samples
-                attr.Set(value, subFrame ? GetTime(*subFrame) : UsdTimeCode::Default());
+                if (subFrame)
+                    attr.Set(value, GetTime(*subFrame));
+                else if (!_SetDefaultValue(attr, VtValue(value)))
+                    attr.Set(value);
             }            
         }
     }
 
+    /** Set the motion keys of an attribute, evenly distributed between motionStart and motionEnd.
+     *  When writing a default time, all the keys are authored at once on the attribute spec,
+     *  otherwise each of them is set through SetAttribute
+    **/
+    template <typename T>
+    void SetAttributeKeys(
+        const UsdAttribute &attr, const std::vector<T> &values, float motionStart, float motionEnd) const
+    {
+        if (values.empty())
+            return;
+        if (values.size() == 1 || motionStart >= motionEnd) {
+            // single key, or invalid motion start / end points, let's just write a single value
+            SetAttribute(attr, values[0]);
+            return;
+        }
+        const float motionDelta = (motionEnd - motionStart) / ((int)values.size() - 1);
+        if (_time.IsDefault()) {
+            SdfTimeSampleMap timeSamples;
+            float time = motionStart;
+            for (size_t i = 0; i < values.size(); ++i, time += motionDelta)
+                timeSamples[(double)time] = VtValue(values[i]);
+            if (_SetTimeSamples(attr, timeSamples))
+                return;
+        }
+        float time = motionStart;
+        for (size_t i = 0; i < values.size(); ++i, time += motionDelta)
+            SetAttribute(attr, values[i], &time);
+    }
+
     template <typename T>
     void SetPrimVar(UsdGeomPrimvar &primvar, const T& value, float *subFrame = nullptr) const
     {
@@ -156,6 +290,45 @@ public:
     }
 
 private:
+    // Set the default value of an attribute directly on its spec in the edit target layer,
+    // skipping the value resolution done by UsdAttribute::Set. Returns false if the attribute
+    // spec doesn't exist or if the value type doesn't match, in which case the caller
+    // should go through the UsdAttribute API
+    bool _SetDefaultValue(const UsdAttribute &attr, const VtValue &value) const;
+    // Same as _SetDefaultValue for all the time samples of an attribute. Returns false if the
+    // attribute already has time samples, as they would be replaced
+    bool _SetTimeSamples(const UsdAttribute &attr, const SdfTimeSampleMap &timeSamples) const;
+
+    // Set an attribute value in streaming mode, based on the values written in the previous frames
+    void _SetStreamedAttribute(const UsdAttribute &attr, const VtValue &value, const float *subFrame) const;
+    // Forget about the frames and the values written in streaming mode
+    void _ResetStreaming()
+    {
+        _streamedAttributes.clear();
+        _streamedFrames = 0;
+    }
+
+    // Find the shapes that can share a prototype with other shapes
+    void _FindInstances(const std::vector<const AtNode *> &nodes);
+    // Find the shaders whose network is identical to the one of a previous shader
+    void _FindSharedShaders(const std::vector<const AtNode *> &nodes);
+    // Only keep the nodes that changed since the previous incremental write, and clear the prims
+    // of the changed and deleted nodes
+    void _UpdateIncrementalNodes(std::vector<const AtNode *> &nodes);
+    // Update the materials bound by the nodes written incrementally, and remove the material
+    // prims that aren't bound anymore
+    void _UpdateIncrementalMaterials(const std::vector<const AtNode *> &nodes);
+    // Paths of the nodes written previously, and of all their ancestors
+    void _GetWrittenNodePaths(std::unordered_set<SdfPath, SdfPath::Hash> &writtenPaths,
+        std::unordered_set<SdfPath, SdfPath::Hash> &nodePaths) const;
+    // Write a shape as an instance of its prototype, writing the prototype first if needed
+    void _WriteInstance(const AtNode *node, size_t prototypeIndex, UsdArnoldPrimWriter *primWriter);
+
+    // Write the nodes from multiple threads, each chunk of nodes authoring to its own layer
+    void _WriteParallel(const std::vector<const AtNode *> &nodes, size_t threadCount);
+    // Thread function writing the chunks of nodes for _WriteParallel
+    static unsigned int _WriterThread(void *data);
+
     const AtUniverse *_universe;        // Arnold universe to be converted
     UsdArnoldWriterRegistry *_registry; // custom registry used for this writer. If null, a global
                                         // registry will be used.
@@ -166,9 +339,55 @@ private:
     float _shutterStart;
     float _shutterEnd;
     std::unordered_set<AtString, AtStringHash> _exportedNodes; // list of arnold attributes that were exported
+    // Nodes exported by the writer running a parallel write before it started, shared by its thread writers
+    const std::unordered_set<AtString, AtStringHash> *_parentExportedNodes;
+    mutable std::unordered_map<const AtNode *, std::string> _nodeNames; // cached USD names of the nodes
     std::string _scope;                // scope in which the primitives must be written
     bool _allAttributes;               // write all attributes to usd prims, even if they're left to default
     UsdTimeCode _time;                 // current time required by client code
     std::vector<float> _authoredFrames;// list of frames that were previously authored in this usd stage
     std::vector<float> _nearestFrames; // based on the _authoredFrames list, we store the 1 or 2 nearest frames
+    unsigned int _threadCount;         // amount of threads used to write the universe
+    mutable std::unordered_set<SdfPath, SdfPath::Hash> _hierarchyPaths; // ancestor paths already processed by
+                                                                         // CreateHierarchy
+
+    // Value written for an attribute in streaming mode
+    struct StreamedAttribute {
+        VtValue value;     // value written while the attribute is constant, empty once it's time-varying
+        bool timeVarying;  // true once the attribute has time samples
+    };
+    bool _streaming;                   // are we appending consecutive frames in streaming mode
+    size_t _streamedFrames;            // number of frames written in streaming mode
+    float _previousFrame;              // last frame written in streaming mode
+    float _startFrame;                 // first frame written in streaming mode
+    float _endFrame;                   // last frame written in streaming mode
+    mutable std::unordered_map<SdfPath, StreamedAttribute, SdfPath::Hash> _streamedAttributes;
+
+    // Shape written once and shared by all the shapes having identical parameters
+    struct Prototype {
+        const AtNode *node; // shape written in the prototype
+        SdfPath path;       // path of the prototype, referenced by the instances
+        bool written;       // was the prototype already written
+    };
+    bool _instancing;                                     // do we want to detect instances
+    std::unordered_map<const AtNode *, size_t> _instances; // prototype index of each instanced shape
+    std::vector<Prototype> _prototypes;                    // list of prototypes found in the universe
+    const AtNode *_prototypeNode;                          // shape node of the prototype being written
+    SdfPath _prototypePath;                                // path of the prototype shape being written
+
+    bool _shaderDeduplication;                                        // do we want to share identical shaders
+    std::unordered_map<const AtNode *, const AtNode *> _sharedShaders; // shader written in place of each
+                                                                      // duplicate shader
+    bool _compactEncoding;                                            // write single precision transforms
+
+    // Node written by a previous incremental write
+    struct WrittenNode {
+        uint64_t hash;  // hash of the node parameters when it was written
+        bool valid;     // false if the node couldn't be hashed, it's then written every time
+        SdfPath path;   // path of the prim written for the node
+        std::vector<SdfPath> materials; // materials bound by the prim and its geom subsets
+    };
+    bool _incremental;                                                // only write the nodes that changed
+    std::unordered_map<AtString, WrittenNode, AtStringHash> _writtenNodes; // nodes written previously
+    std::unordered_set<SdfPath, SdfPath::Hash> _boundMaterials;       // materials bound after the previous write
 };